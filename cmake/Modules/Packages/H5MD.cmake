@@ -1,7 +1,8 @@
 enable_language(C)
 
-# we don't use the parallel i/o interface.
-set(HDF5_PREFER_PARALLEL FALSE)
+# the parallel i/o interface is only used by dump h5md with "parallel yes"
+# and requires an MPI build, prefer a parallel HDF5 library in that case.
+set(HDF5_PREFER_PARALLEL ${BUILD_MPI})
 
 find_package(HDF5 REQUIRED)
 
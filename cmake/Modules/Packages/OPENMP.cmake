@@ -1,7 +1,9 @@
   set(OPENMP_SOURCES_DIR ${LAMMPS_SOURCE_DIR}/OPENMP)
   set(OPENMP_SOURCES ${OPENMP_SOURCES_DIR}/thr_data.cpp
+                       ${OPENMP_SOURCES_DIR}/thr_color.cpp
                        ${OPENMP_SOURCES_DIR}/thr_omp.cpp
                        ${OPENMP_SOURCES_DIR}/fix_omp.cpp
+                       ${OPENMP_SOURCES_DIR}/verlet_task.cpp
                        ${OPENMP_SOURCES_DIR}/fix_nh_omp.cpp
                        ${OPENMP_SOURCES_DIR}/fix_nh_sphere_omp.cpp
                        ${OPENMP_SOURCES_DIR}/domain_omp.cpp)
@@ -11,6 +13,7 @@
   # detects styles which have OPENMP version
   RegisterStylesExt(${OPENMP_SOURCES_DIR} omp OMP_SOURCES)
   RegisterFixStyle(${OPENMP_SOURCES_DIR}/fix_omp.h)
+  RegisterIntegrateStyle(${OPENMP_SOURCES_DIR}/verlet_task.h)
 
   get_property(OPENMP_SOURCES GLOBAL PROPERTY OMP_SOURCES)
 
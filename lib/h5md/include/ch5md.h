@@ -54,15 +54,18 @@ typedef struct {
 } h5md_file;
 
 h5md_file h5md_create_file (const char *filename, const char *author, const char *author_email, const char *creator, const char *creator_version);
+h5md_file h5md_create_file_fapl (const char *filename, const char *author, const char *author_email, const char *creator, const char *creator_version, hid_t fapl);
 int h5md_close_file(h5md_file file);
 hid_t h5md_open_file (const char *filename);
 h5md_particles_group h5md_create_particles_group(h5md_file file, const char *name);
 hid_t h5md_open_particles_group(hid_t particles, const char *name);
 h5md_element h5md_create_time_data(hid_t loc, const char *name, int rank, int int_dims[], hid_t datatype, h5md_element *link);
+h5md_element h5md_create_time_data_chunked(hid_t loc, const char *name, int rank, int int_dims[], int chunk_size, int deflate, hid_t datatype, h5md_element *link);
 int h5md_close_element(h5md_element e);
 h5md_element h5md_create_fixed_data_simple(hid_t loc, const char *name, int rank, int int_dims[], hid_t datatype, void *data);
 h5md_element h5md_create_fixed_data_scalar(hid_t loc, const char *name, hid_t datatype, void *data);
 int h5md_append(h5md_element e, void *data, int step, double time);
+int h5md_append_rows(h5md_element e, void *data, int step, double time, int nruns, const hsize_t run_start[], const hsize_t run_count[], int write_time, hid_t xfer);
 int h5md_create_box(h5md_particles_group *group, int dim, char *boundary[], bool is_time, double value[], h5md_element *link);
 int h5md_write_string_attribute(hid_t loc, const char *obj_name,
     const char *att_name, const char *value);
@@ -16,6 +16,11 @@
 #define MAX_RANK 5
 
 h5md_file h5md_create_file (const char *filename, const char *author, const char *author_email, const char *creator, const char *creator_version)
+{
+  return h5md_create_file_fapl(filename, author, author_email, creator, creator_version, H5P_DEFAULT);
+}
+
+h5md_file h5md_create_file_fapl (const char *filename, const char *author, const char *author_email, const char *creator, const char *creator_version, hid_t fapl)
 {
   h5md_file file;
   hid_t g, g1;
@@ -25,7 +30,7 @@ h5md_file h5md_create_file (const char *filename, const char *author, const char
   file.version[0] = 1;
   file.version[1] = 0;
 
-  file.id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  file.id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
   g = H5Gcreate(file.id, "h5md", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
   dims[0] = 2;
@@ -148,6 +153,11 @@ hid_t h5md_open_particles_group(hid_t particles, const char *name)
 }
 
 h5md_element h5md_create_time_data(hid_t loc, const char *name, int rank, int int_dims[], hid_t datatype, h5md_element *link)
+{
+  return h5md_create_time_data_chunked(loc, name, rank, int_dims, 0, 0, datatype, link);
+}
+
+h5md_element h5md_create_time_data_chunked(hid_t loc, const char *name, int rank, int int_dims[], int chunk_size, int deflate, hid_t datatype, h5md_element *link)
 {
 
   h5md_element td;
@@ -165,7 +175,9 @@ h5md_element h5md_create_time_data(hid_t loc, const char *name, int rank, int in
     max_dims[i+1] = int_dims[i];
   }
   chunks[0] = 1 ;
-  if (MAX_CHUNK<int_dims[0]/4) {
+  if (chunk_size>0) {
+    chunks[1] = (chunk_size<int_dims[0]) ? chunk_size : int_dims[0];
+  } else if (MAX_CHUNK<int_dims[0]/4) {
     chunks[1] = MAX_CHUNK;
   } else {
     chunks[1] = int_dims[0];
@@ -194,6 +206,7 @@ h5md_element h5md_create_time_data(hid_t loc, const char *name, int rank, int in
   spc = H5Screate_simple( rank+1 , dims, max_dims) ;
   plist = H5Pcreate(H5P_DATASET_CREATE);
   H5Pset_chunk(plist, rank+1, chunks);
+  if (deflate>0) H5Pset_deflate(plist, deflate);
   td.value = H5Dcreate(td.group, "value", datatype, spc, H5P_DEFAULT, plist, H5P_DEFAULT);
   H5Pclose(plist);
   H5Sclose(spc);
@@ -366,6 +379,91 @@ int h5md_append(h5md_element e, void *data, int step, double time) {
   return 0;
 }
 
+/* Append a time step where the calling process writes nruns blocks of
+ * rows of the value, given by run_start and run_count along its first
+ * dimension, from data holding these rows one after the other.
+ * Step and time are written only if write_time is true.
+ * With parallel HDF5 all processes of the file must call this function,
+ * which also allows for collective transfers via the xfer property list.
+ */
+int h5md_append_rows(h5md_element e, void *data, int step, double time, int nruns, const hsize_t run_start[], const hsize_t run_count[], int write_time, hid_t xfer) {
+
+  hid_t mem_space, file_space;
+  int i, j, rank;
+  hsize_t dims[H5S_MAX_RANK];
+  hsize_t start[H5S_MAX_RANK], count[H5S_MAX_RANK];
+  hsize_t nrows;
+  H5S_seloper_t op;
+
+  // If not a time-dependent H5MD element, do nothing
+  if (!e.is_time) return 0;
+
+  if (NULL==e.link) {
+    h5md_extend_by_one(e.step, dims);
+    file_space = H5Dget_space(e.step);
+    mem_space = H5Screate(H5S_SCALAR);
+    start[0] = dims[0]-1;
+    count[0] = 1;
+    if (write_time) {
+      H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+    } else {
+      H5Sselect_none(file_space);
+      H5Sselect_none(mem_space);
+    }
+    H5Dwrite(e.step, H5T_NATIVE_INT, mem_space, file_space, xfer, (void *)&step);
+    H5Sclose(file_space);
+
+    h5md_extend_by_one(e.time, dims);
+    file_space = H5Dget_space(e.time);
+    if (write_time) {
+      H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+    } else {
+      H5Sselect_none(file_space);
+    }
+    H5Dwrite(e.time, H5T_NATIVE_DOUBLE, mem_space, file_space, xfer, (void *)&time);
+    H5Sclose(file_space);
+    H5Sclose(mem_space);
+  }
+
+  h5md_extend_by_one(e.value, dims);
+  file_space = H5Dget_space(e.value);
+  rank = H5Sget_simple_extent_ndims(file_space);
+
+  // union of one hyperslab per run in the file, contiguous rows in memory
+
+  nrows = 0;
+  H5Sselect_none(file_space);
+  op = H5S_SELECT_SET;
+  start[0] = dims[0]-1;
+  count[0] = 1;
+  for (i=2 ; i<rank ; i++) {
+    start[i] = 0;
+    count[i] = dims[i];
+  }
+  for (j=0 ; j<nruns ; j++) {
+    if (run_count[j]==0) continue;
+    start[1] = run_start[j];
+    count[1] = run_count[j];
+    H5Sselect_hyperslab(file_space, op, start, NULL, count, NULL);
+    op = H5S_SELECT_OR;
+    nrows += run_count[j];
+  }
+
+  count[0] = nrows;
+  for (i=1 ; i<rank-1 ; i++) count[i] = dims[i+1];
+  if (nrows>0) {
+    mem_space = H5Screate_simple(rank-1, count, NULL);
+  } else {
+    mem_space = H5Screate(H5S_SCALAR);
+    H5Sselect_none(mem_space);
+  }
+  H5Dwrite(e.value, e.datatype, mem_space, file_space, xfer, data);
+  H5Sclose(file_space);
+  H5Sclose(mem_space);
+
+  return 0;
+}
+
 int h5md_create_box(h5md_particles_group *group, int dim, char *boundary[], bool is_time, double value[], h5md_element *link)
 {
   hid_t spc, att, t;
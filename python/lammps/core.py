@@ -304,6 +304,8 @@ class lammps(object):
     self.lib.lammps_get_gpu_device_info.argtypes = [c_char_p, c_int]
 
     self.lib.lammps_get_mpi_comm.argtypes = [c_void_p]
+    self.lib.lammps_get_timer_info.argtypes = [c_void_p, c_char_p, c_int]
+    self.lib.lammps_get_timer_info.restype = c_int
 
     self.lib.lammps_decode_image_flags.argtypes = [self.c_imageint, POINTER(c_int*3)]
 
@@ -572,6 +574,27 @@ class lammps(object):
 
   # -------------------------------------------------------------------------
 
+  def get_timer_info(self):
+    """Return the timing breakdown of the last run as dictionary
+
+    This is a wrapper around the :cpp:func:`lammps_get_timer_info`
+    function of the C-library interface.  It returns ``None`` if no
+    timing data is available.
+
+    :return: timing breakdown of the last run
+    :rtype:  dict
+    """
+
+    import json
+    length = self.lib.lammps_get_timer_info(self.lmp, None, 0)
+    if length <= 0:
+      return None
+    sb = create_string_buffer(length+1)
+    self.lib.lammps_get_timer_info(self.lmp, sb, length+1)
+    return json.loads(sb.value.decode())
+
+  # -------------------------------------------------------------------------
+
   @property
   def _lammps_exception(self):
     sb = create_string_buffer(100)
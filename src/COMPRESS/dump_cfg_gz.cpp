@@ -27,6 +27,7 @@ using namespace LAMMPS_NS;
 DumpCFGGZ::DumpCFGGZ(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
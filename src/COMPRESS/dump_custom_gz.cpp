@@ -25,6 +25,7 @@ using namespace LAMMPS_NS;
 DumpCustomGZ::DumpCustomGZ(LAMMPS *lmp, int narg, char **arg) : DumpCustom(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump custom/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
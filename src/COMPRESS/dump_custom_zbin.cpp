@@ -0,0 +1,376 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#include "dump_custom_zbin.h"
+
+#include "domain.h"
+#include "error.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace Zbin;
+
+/* ---------------------------------------------------------------------- */
+
+DumpCustomZbin::DumpCustomZbin(LAMMPS *lmp, int narg, char **arg) :
+  DumpCustom(lmp, narg, arg), cctx(nullptr)
+{
+  if (compressed)
+    error->all(FLERR,"Dump custom/zbin compresses internally and cannot use a compressed file suffix");
+
+  // gather per-atom values as doubles, the file writer converts them
+
+  buffer_allow = 0;
+  buffer_flag = 0;
+
+  compression_level = 3;
+  precision.resize(nfield, 0.0);
+  fileheader_flag = 0;
+  nrows = 0;
+  index_offset = 0;
+  memset(&frame, 0, sizeof(FrameHeader));
+
+  if (filewriter) {
+    cctx = ZSTD_createCCtx();
+    if (!cctx) error->one(FLERR,"Could not create Zstd context");
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpCustomZbin::~DumpCustomZbin()
+{
+  if (cctx) ZSTD_freeCCtx(cctx);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomZbin::init_style()
+{
+  DumpCustom::init_style();
+
+  for (int i = 0; i < nfield; i++)
+    if (vtype[i] == Dump::STRING)
+      error->all(FLERR,"Dump custom/zbin does not support string columns");
+}
+
+/* ----------------------------------------------------------------------
+   open a new zbin file
+   file header is written with the first frame
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::openfile()
+{
+  // single file, already opened, so just return
+
+  if (singlefile_opened) return;
+  if (multifile == 0) singlefile_opened = 1;
+
+  // if one file per timestep, replace '*' with current timestep
+
+  char *filecurrent = filename;
+  if (multiproc) filecurrent = multiname;
+
+  if (multifile) {
+    filecurrent = utils::strdup(utils::star_subst(filecurrent, update->ntimestep, padflag));
+    if (maxfiles > 0) {
+      if (numfiles < maxfiles) {
+        nameslist[numfiles] = utils::strdup(filecurrent);
+        ++numfiles;
+      } else {
+        if (remove(nameslist[fileidx]) != 0) {
+          error->warning(FLERR, "Could not delete {}", nameslist[fileidx]);
+        }
+        delete[] nameslist[fileidx];
+        nameslist[fileidx] = utils::strdup(filecurrent);
+        fileidx = (fileidx + 1) % maxfiles;
+      }
+    }
+  }
+
+  // each proc with filewriter = 1 opens a file
+
+  if (filewriter) {
+    if (append_flag) error->one(FLERR, "Dump custom/zbin does not support append");
+
+    fp = fopen(filecurrent, "wb");
+    if (fp == nullptr)
+      error->one(FLERR, "Cannot open dump file {}: {}", filecurrent, utils::getsyserror());
+
+    fileheader_flag = 0;
+    frameindex.clear();
+  }
+
+  // delete string with timestep replaced
+
+  if (multifile) delete[] filecurrent;
+}
+
+/* ----------------------------------------------------------------------
+   write file header if needed and record header of the new frame
+   box is copied here, since the footer may be written by the async thread
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::write_header(bigint ndump)
+{
+  if (!fileheader_flag) {
+    std::vector<char> header;
+    file_header(header);
+    fwrite(header.data(), sizeof(char), header.size(), fp);
+    fileheader_flag = 1;
+  }
+
+  frame_header(ndump);
+
+  nrows = 0;
+  framebuf.resize(ndump*size_one + 1);
+}
+
+/* ----------------------------------------------------------------------
+   store file header and column info in header
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::file_header(std::vector<char> &header)
+{
+  header.resize(sizeof(FileHeader) + nfield*sizeof(ColumnInfo));
+
+  FileHeader fileheader;
+  memset(&fileheader, 0, sizeof(FileHeader));
+  memcpy(fileheader.magic, MAGIC, sizeof(fileheader.magic));
+  fileheader.endian = ENDIAN;
+  fileheader.version = VERSION;
+  fileheader.ncolumns = nfield;
+  strncpy(fileheader.units, update->unit_style, UNITLEN-1);
+  memcpy(header.data(), &fileheader, sizeof(FileHeader));
+
+  auto words = utils::split_words(columns);
+  for (int i = 0; i < nfield; i++) {
+    ColumnInfo info;
+    memset(&info, 0, sizeof(ColumnInfo));
+    if (words[i].size() >= NAMELEN)
+      error->one(FLERR,"Dump custom/zbin column name {} is too long", words[i]);
+    strncpy(info.name, words[i].c_str(), NAMELEN-1);
+    memcpy(&header[sizeof(FileHeader) + i*sizeof(ColumnInfo)], &info, sizeof(ColumnInfo));
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set header of a new frame with ndump atoms from current box and timestep
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::frame_header(bigint ndump)
+{
+  memset(&frame, 0, sizeof(FrameHeader));
+  memcpy(frame.magic, FRAME_MAGIC, sizeof(frame.magic));
+  frame.ntimestep = update->ntimestep;
+  frame.natoms = ndump;
+  frame.triclinic = domain->triclinic;
+  frame.timeflag = time_flag;
+  frame.time = compute_time();
+  frame.box[0][0] = boxxlo;
+  frame.box[0][1] = boxxhi;
+  frame.box[1][0] = boxylo;
+  frame.box[1][1] = boxyhi;
+  frame.box[2][0] = boxzlo;
+  frame.box[2][1] = boxzhi;
+  if (domain->triclinic) {
+    frame.box[0][2] = boxxy;
+    frame.box[1][2] = boxxz;
+    frame.box[2][2] = boxyz;
+  }
+  for (int i = 0; i < 3; i++) {
+    frame.boundary[i][0] = domain->boundary[i][0];
+    frame.boundary[i][1] = domain->boundary[i][1];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   collect rows received from each proc into the frame buffer
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::write_data(int n, double *mybuf)
+{
+  if ((nrows+n)*size_one >= (bigint) framebuf.size()) framebuf.resize((nrows+n)*size_one + 1);
+  memcpy(&framebuf[nrows*size_one], mybuf, sizeof(double)*n*size_one);
+  nrows += n;
+}
+
+/* ----------------------------------------------------------------------
+   compress all rows of the frame as a single chunk, then write the frame
+   in place of the frame index of the previous frame
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::write_footer()
+{
+  // invalidate the previous footer before its index is overwritten,
+  // so a file left by a crash while writing this frame has no index
+  // and is read sequentially up to its last complete frame
+
+  if (frameindex.size()) {
+    const char nomagic[sizeof(IndexFooter::magic)] = {0};
+    platform::fseek(fp, platform::ftell(fp) - sizeof(nomagic));
+    fwrite(nomagic, sizeof(char), sizeof(nomagic), fp);
+    platform::fseek(fp, index_offset);
+  }
+
+  bigint offset = platform::ftell(fp);
+
+  blocks.clear();
+  encode_chunk(nrows, framebuf.data(), blocks);
+
+  frame.nchunks = 1;
+  frame.nbytes = sizeof(FrameHeader) + blocks.size();
+  fwrite(&frame, sizeof(FrameHeader), 1, fp);
+  fwrite(blocks.data(), sizeof(char), blocks.size(), fp);
+
+  IndexEntry entry;
+  entry.ntimestep = frame.ntimestep;
+  entry.offset = offset;
+  frameindex.push_back(entry);
+
+  write_index();
+}
+
+/* ----------------------------------------------------------------------
+   encode, shuffle, and compress each column of N rows in mybuf
+   append chunk header and one block per column to out
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::encode_chunk(bigint n, double *mybuf, std::vector<char> &out)
+{
+  const size_t chunkstart = out.size();
+  out.resize(chunkstart + sizeof(ChunkHeader));
+
+  column.resize(n + 1);
+  shuffled.resize(8*n + 1);
+
+  for (int icol = 0; icol < nfield; icol++) {
+    BlockHeader block;
+    memset(&block, 0, sizeof(BlockHeader));
+
+    // integer and quantized columns store differences of consecutive values,
+    // so e.g. sorted atom IDs compress to almost nothing and coordinates
+    // of atoms that are close in the dump order need only a few bits
+
+    if (vtype[icol] == Dump::INT || vtype[icol] == Dump::BIGINT) {
+      block.encoding = INTEGER;
+      int64_t previous = 0;
+      for (bigint i = 0; i < n; i++) {
+        auto value = static_cast<int64_t>(mybuf[i*size_one+icol]);
+        column[i] = value - previous;
+        previous = value;
+      }
+    } else if (precision[icol] > 0.0) {
+      block.encoding = QUANTIZED;
+      block.precision = precision[icol];
+      const double scale = 1.0/precision[icol];
+      int64_t previous = 0;
+      for (bigint i = 0; i < n; i++) {
+        auto value = static_cast<int64_t>(std::llround(mybuf[i*size_one+icol]*scale));
+        column[i] = value - previous;
+        previous = value;
+      }
+    } else {
+      block.encoding = DOUBLE;
+      for (bigint i = 0; i < n; i++)
+        memcpy(&column[i], &mybuf[i*size_one+icol], sizeof(double));
+    }
+
+    shuffle(column.data(), shuffled.data(), n);
+
+    // append block header and compressed data
+
+    size_t start = out.size();
+    size_t bound = ZSTD_compressBound(8*n);
+    out.resize(start + sizeof(BlockHeader) + bound);
+    size_t nbytes = ZSTD_compressCCtx(cctx, &out[start + sizeof(BlockHeader)], bound,
+                                      shuffled.data(), 8*n, compression_level);
+    if (ZSTD_isError(nbytes))
+      error->one(FLERR, "Dump custom/zbin compression failed: {}", ZSTD_getErrorName(nbytes));
+
+    block.nbytes = nbytes;
+    memcpy(&out[start], &block, sizeof(BlockHeader));
+    out.resize(start + sizeof(BlockHeader) + nbytes);
+  }
+
+  ChunkHeader chunk;
+  chunk.natoms = n;
+  chunk.nbytes = out.size() - chunkstart;
+  memcpy(&out[chunkstart], &chunk, sizeof(ChunkHeader));
+}
+
+/* ----------------------------------------------------------------------
+   append frame index and footer after the last frame of current file
+   written after every frame, so the file is complete at any time
+------------------------------------------------------------------------- */
+
+void DumpCustomZbin::write_index()
+{
+  IndexFooter footer;
+  footer.nframes = frameindex.size();
+  footer.offset = index_offset = platform::ftell(fp);
+  memcpy(footer.magic, INDEX_MAGIC, sizeof(footer.magic));
+
+  if (frameindex.size()) fwrite(frameindex.data(), sizeof(IndexEntry), frameindex.size(), fp);
+  fwrite(&footer, sizeof(IndexFooter), 1, fp);
+  if (flush_flag) fflush(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpCustomZbin::modify_param(int narg, char **arg)
+{
+  int consumed = DumpCustom::modify_param(narg, arg);
+  if (consumed) return consumed;
+
+  if (strcmp(arg[0], "compression_level") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compression_level", error);
+    compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
+    if (compression_level < ZSTD_minCLevel() || compression_level > ZSTD_maxCLevel())
+      error->all(FLERR, "Compression level must in the range of [{}, {}]",
+                 ZSTD_minCLevel(), ZSTD_maxCLevel());
+    return 2;
+  }
+
+  // quantize column to multiples of given precision, 0.0 = lossless
+  // column is given by its keyword or index as for dump_modify colname
+
+  if (strcmp(arg[0], "quantize") == 0) {
+    if (narg < 3) utils::missing_cmd_args(FLERR, "dump_modify quantize", error);
+    int icol = -1;
+    if (utils::is_integer(arg[1])) {
+      icol = utils::inumeric(FLERR, arg[1], false, lmp);
+      if (icol < 0) icol = nfield + icol + 1;
+      icol--;
+    } else {
+      auto found = key2col.find(arg[1]);
+      if (found != key2col.end()) icol = found->second;
+    }
+    if ((icol < 0) || (icol >= nfield))
+      error->all(FLERR, "Unknown dump_modify quantize column: {}", arg[1]);
+    double value = utils::numeric(FLERR, arg[2], false, lmp);
+    if (value < 0.0) error->all(FLERR, "Dump_modify quantize precision must be >= 0.0");
+    precision[icol] = value;
+    return 3;
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(custom/zbin,DumpCustomZbin);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_CUSTOM_ZBIN_H
+#define LMP_DUMP_CUSTOM_ZBIN_H
+
+#include "dump_custom.h"
+#include "zbin_format.h"
+
+#include <vector>
+#include <zstd.h>
+
+namespace LAMMPS_NS {
+
+class DumpCustomZbin : public DumpCustom {
+ public:
+  DumpCustomZbin(class LAMMPS *, int, char **);
+  ~DumpCustomZbin() override;
+
+ protected:
+  int compression_level;            // zstd compression level
+  std::vector<double> precision;    // quantization step per column, 0.0 = lossless
+  ZSTD_CCtx *cctx;                  // zstd compression context
+
+  int fileheader_flag;                       // 1 if file header is written to current file
+  Zbin::FrameHeader frame;                   // header of current frame
+  bigint nrows;                              // # of rows stored in framebuf so far
+  std::vector<double> framebuf;              // per-atom values of current frame, row by row
+  std::vector<int64_t> column;               // one column, encoded as 8-byte values
+  std::vector<char> shuffled;                // byte-shuffled column
+  std::vector<char> blocks;                  // compressed chunks of current frame
+  std::vector<Zbin::IndexEntry> frameindex;  // frames in current file
+  bigint index_offset;                       // file offset of frame index in current file
+
+  void init_style() override;
+  void openfile() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  void write_footer() override;
+  int modify_param(int, char **) override;
+
+  void file_header(std::vector<char> &);
+  void frame_header(bigint);
+  void encode_chunk(bigint, double *, std::vector<char> &);
+  void write_index();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+#endif
@@ -25,6 +25,7 @@ using namespace LAMMPS_NS;
 DumpLocalGZ::DumpLocalGZ(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump local/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
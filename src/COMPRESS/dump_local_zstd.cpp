@@ -31,6 +31,7 @@ using namespace LAMMPS_NS;
 DumpLocalZstd::DumpLocalZstd(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump local/zstd only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -24,6 +24,7 @@ using namespace LAMMPS_NS;
 DumpXYZGZ::DumpXYZGZ(LAMMPS *lmp, int narg, char **arg) : DumpXYZ(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump xyz/gz only writes compressed files");
+  async_allow = 0;
 }
 
 /* ----------------------------------------------------------------------
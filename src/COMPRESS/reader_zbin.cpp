@@ -0,0 +1,275 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#include "reader_zbin.h"
+
+#include "error.h"
+
+#include <algorithm>
+#include <cstring>
+#include <zstd.h>
+
+using namespace LAMMPS_NS;
+using namespace Zbin;
+
+// only proc 0 calls methods of this class, except for constructor/destructor
+
+/* ---------------------------------------------------------------------- */
+
+ReaderZbin::ReaderZbin(LAMMPS *lmp) : ReaderNative(lmp)
+{
+  ncolumns = 0;
+  end_of_frames = 0;
+  frame_offset = 0;
+  iatom = 0;
+  memset(&frame, 0, sizeof(FrameHeader));
+}
+
+/* ----------------------------------------------------------------------
+   open zbin file, read file header and column labels
+   read frame index at end of file, if present
+------------------------------------------------------------------------- */
+
+void ReaderZbin::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  compressed = false;
+  binary = true;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  FileHeader header;
+  if (fread(&header, sizeof(FileHeader), 1, fp) != 1 ||
+      memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0)
+    error->one(FLERR, "File {} is not a zbin dump file", file);
+  if (header.endian != ENDIAN)
+    error->one(FLERR, "Zbin dump file {} was written with different byte order", file);
+  if (header.version > VERSION)
+    error->one(FLERR, "Zbin dump file {} has unsupported version {}", file, header.version);
+
+  header.units[UNITLEN-1] = '\0';
+  unit_style = header.units;
+  ncolumns = header.ncolumns;
+
+  labelline.clear();
+  for (int i = 0; i < ncolumns; i++) {
+    ColumnInfo info;
+    read_buf(&info, sizeof(ColumnInfo), 1);
+    info.name[NAMELEN-1] = '\0';
+    labelline += info.name;
+    labelline += ' ';
+  }
+  bigint data_start = platform::ftell(fp);
+
+  // frames end where the frame index starts
+  // without index (e.g. file of a crashed run) read frames until end of file
+
+  platform::fseek(fp, platform::END_OF_FILE);
+  bigint end_of_file = platform::ftell(fp);
+  end_of_frames = end_of_file;
+  frameindex.clear();
+
+  IndexFooter footer;
+  if (end_of_file - data_start >= (bigint) sizeof(IndexFooter)) {
+    platform::fseek(fp, end_of_file - sizeof(IndexFooter));
+    if ((fread(&footer, sizeof(IndexFooter), 1, fp) == 1) &&
+        (memcmp(footer.magic, INDEX_MAGIC, sizeof(footer.magic)) == 0)) {
+      if ((footer.nframes < 0) || (footer.offset < data_start) ||
+          (footer.offset + footer.nframes*(bigint) sizeof(IndexEntry) + (bigint) sizeof(IndexFooter)
+           != end_of_file))
+        error->one(FLERR, "Frame index of zbin dump file {} is invalid or corrupted", file);
+      end_of_frames = footer.offset;
+      frameindex.resize(footer.nframes);
+      platform::fseek(fp, footer.offset);
+      read_buf(frameindex.data(), sizeof(IndexEntry), footer.nframes);
+    }
+  }
+  platform::fseek(fp, data_start);
+}
+
+/* ----------------------------------------------------------------------
+   position file at next frame with timestep >= Nrequest via frame index
+   frames before the current file position are not considered,
+   so the result is the same as reading and skipping frames in order
+   without index, leave the file position unchanged
+------------------------------------------------------------------------- */
+
+void ReaderZbin::seek(bigint nrequest)
+{
+  if (frameindex.empty()) return;
+
+  bigint offset = platform::ftell(fp);
+  auto entry = std::lower_bound(frameindex.begin(), frameindex.end(), offset,
+                                [](const IndexEntry &e, bigint value) { return e.offset < value; });
+  while ((entry != frameindex.end()) && (entry->ntimestep < nrequest)) ++entry;
+
+  if (entry == frameindex.end()) platform::fseek(fp, end_of_frames);
+  else platform::fseek(fp, entry->offset);
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp from frame header
+   return 1 at end of frames, so caller can open next file
+------------------------------------------------------------------------- */
+
+int ReaderZbin::read_time(bigint &ntimestep)
+{
+  frame_offset = platform::ftell(fp);
+  if (frame_offset + (bigint) sizeof(FrameHeader) > end_of_frames) return 1;
+  if (fread(&frame, sizeof(FrameHeader), 1, fp) != 1) return 1;
+
+  // without index, an incomplete last frame of a crashed run ends the file
+
+  bool valid = (memcmp(frame.magic, FRAME_MAGIC, sizeof(frame.magic)) == 0) &&
+    (frame.nbytes >= (bigint) sizeof(FrameHeader)) && (frame_offset + frame.nbytes <= end_of_frames);
+  if (!valid) {
+    if (frameindex.size()) error->one(FLERR, "Dump file is invalid or corrupted");
+    error->warning(FLERR, "Ignoring incomplete frame at end of zbin dump file without index");
+    platform::fseek(fp, end_of_frames);
+    return 1;
+  }
+
+  ntimestep = frame.ntimestep;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip frame without decompressing it
+------------------------------------------------------------------------- */
+
+void ReaderZbin::skip()
+{
+  platform::fseek(fp, frame_offset + frame.nbytes);
+}
+
+/* ----------------------------------------------------------------------
+   return natoms and box of current frame
+   match fields to columns if requested, then decompress matched columns
+------------------------------------------------------------------------- */
+
+bigint ReaderZbin::read_header(double box[3][3], int &boxinfo, int &triclinic,
+                               int fieldinfo, int nfield,
+                               int *fieldtype, char **fieldlabel,
+                               int scaleflag, int wrapflag, int &fieldflag,
+                               int &xflag, int &yflag, int &zflag)
+{
+  boxinfo = 1;
+  triclinic = frame.triclinic;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      box[i][j] = frame.box[i][j];
+
+  if (fieldinfo) {
+    if (match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag,
+                     fieldflag, xflag, yflag, zflag) == 0) return 1;
+    if (fieldflag < 0) return frame.natoms;
+  }
+
+  read_columns(nfield);
+  return frame.natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read N atoms from decoded columns of current frame
+   stores appropriate values in fields array
+------------------------------------------------------------------------- */
+
+void ReaderZbin::read_atoms(int n, int nfield, double **fields)
+{
+  if (iatom + n > frame.natoms) error->one(FLERR, "Unexpected end of dump file");
+
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < nfield; k++)
+      fields[i][k] = values[fieldindex[k]][iatom];
+    iatom++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   decode the columns used by the Nfield fields, skip the others
+   leaves file positioned at start of next frame
+------------------------------------------------------------------------- */
+
+void ReaderZbin::read_columns(int nfield)
+{
+  std::vector<int> needed(ncolumns, 0);
+  if (fieldindex)
+    for (int k = 0; k < nfield; k++)
+      if (fieldindex[k] >= 0) needed[fieldindex[k]] = 1;
+
+  values.resize(ncolumns);
+  for (int icol = 0; icol < ncolumns; icol++)
+    if (needed[icol]) values[icol].resize(frame.natoms + 1);
+  iatom = 0;
+
+  // chunks of a frame hold consecutive rows
+
+  bigint offset = 0;
+  for (bigint ichunk = 0; ichunk < frame.nchunks; ichunk++) {
+    ChunkHeader chunk;
+    read_buf(&chunk, sizeof(ChunkHeader), 1);
+    if ((chunk.natoms < 0) || (offset + chunk.natoms > frame.natoms))
+      error->one(FLERR, "Dump file is invalid or corrupted");
+
+    const bigint natoms = chunk.natoms;
+    const size_t nbytes_raw = 8*natoms;
+    sbuf.resize(nbytes_raw + 1);
+    column.resize(natoms + 1);
+
+    for (int icol = 0; icol < ncolumns; icol++) {
+      BlockHeader block;
+      read_buf(&block, sizeof(BlockHeader), 1);
+      if (block.nbytes < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+
+      if (!needed[icol]) {
+        skip_buf(block.nbytes);
+        continue;
+      }
+
+      cbuf.resize(block.nbytes + 1);
+      read_buf(cbuf.data(), sizeof(char), block.nbytes);
+      size_t nbytes = ZSTD_decompress(sbuf.data(), nbytes_raw, cbuf.data(), block.nbytes);
+      if (ZSTD_isError(nbytes) || (nbytes != nbytes_raw))
+        error->one(FLERR, "Dump file is invalid or corrupted");
+
+      unshuffle(sbuf.data(), column.data(), natoms);
+
+      double *value = values[icol].data() + offset;
+      if (block.encoding == DOUBLE) {
+        memcpy(value, column.data(), nbytes_raw);
+      } else if (block.encoding == QUANTIZED) {
+        int64_t previous = 0;
+        for (bigint i = 0; i < natoms; i++) {
+          previous += column[i];
+          value[i] = previous * block.precision;
+        }
+      } else if (block.encoding == INTEGER) {
+        int64_t previous = 0;
+        for (bigint i = 0; i < natoms; i++) {
+          previous += column[i];
+          value[i] = previous;
+        }
+      } else error->one(FLERR, "Unknown zbin block encoding {}", block.encoding);
+    }
+    offset += natoms;
+  }
+
+  if (offset != frame.natoms) error->one(FLERR, "Dump file is invalid or corrupted");
+  platform::fseek(fp, frame_offset + frame.nbytes);
+}
+
+#endif
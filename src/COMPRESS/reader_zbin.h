@@ -0,0 +1,64 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(zbin,ReaderZbin);
+// clang-format on
+#else
+
+#ifndef LMP_READER_ZBIN_H
+#define LMP_READER_ZBIN_H
+
+#include "reader_native.h"
+#include "zbin_format.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderZbin : public ReaderNative {
+ public:
+  ReaderZbin(class LAMMPS *);
+
+  int read_time(bigint &) override;
+  void skip() override;
+  void seek(bigint) override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  void read_atoms(int, int, double **) override;
+
+  void open_file(const std::string &) override;
+
+ private:
+  std::string labelline;                      // column labels from file header
+  int ncolumns;                               // # of per-atom columns
+  bigint end_of_frames;                       // file offset of frame index or end of file
+  std::vector<Zbin::IndexEntry> frameindex;   // timestep and offset of frames, if indexed
+  Zbin::FrameHeader frame;                    // header of current frame
+  bigint frame_offset;                        // file offset of current frame
+  bigint iatom;                               // # of atoms of current frame already read
+  std::vector<std::vector<double>> values;    // decoded columns of current frame
+  std::vector<char> cbuf, sbuf;               // compressed and shuffled column data
+  std::vector<int64_t> column;                // unshuffled column data
+
+  void read_columns(int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+#endif
@@ -0,0 +1,127 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_ZBIN_FORMAT_H
+#define LMP_ZBIN_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// zbin trajectory format written by dump custom/zbin, read by read_dump format zbin
+//
+// file = file header, column info, frames, frame index, index footer
+// each frame = frame header, then one or more chunks of atoms
+// each chunk = chunk header, then one compressed block per column
+//   a serial writer stores all atoms of a frame in a single chunk,
+//   a parallel writer stores one chunk per MPI rank
+// a block is a column of N values, stored as 8-byte doubles or int64,
+//   byte-shuffled (all 1st bytes, then all 2nd bytes, ...) and zstd compressed
+// the frame index at the end of the file lists the timestep and file offset
+//   of each frame, so a reader can jump to any frame without decompressing
+// writers rewrite index and footer after each frame, in place of the previous
+//   ones, and clear the magic of the previous footer first
+// if the index is missing (e.g. a run crashed while writing a frame), frames
+//   can still be read sequentially, since each frame header stores its size
+
+namespace LAMMPS_NS {
+namespace Zbin {
+
+  static constexpr char MAGIC[8] = {'L', 'M', 'P', 'Z', 'B', 'I', 'N', '1'};
+  static constexpr char FRAME_MAGIC[8] = {'Z', 'B', 'F', 'R', 'A', 'M', 'E', '1'};
+  static constexpr char INDEX_MAGIC[8] = {'Z', 'B', 'I', 'N', 'D', 'E', 'X', '1'};
+  static constexpr int32_t ENDIAN = 0x0001;
+  static constexpr int32_t VERSION = 1;
+
+  // block encodings
+
+  enum {
+    DOUBLE = 1,       // lossless doubles
+    QUANTIZED = 2,    // int64 of value/precision, rounded to nearest integer,
+                      //   difference to previous value in column
+    INTEGER = 3       // int64 of value, difference to previous value in column
+  };
+
+  static constexpr int NAMELEN = 32;
+  static constexpr int UNITLEN = 16;
+
+  struct FileHeader {
+    char magic[8];           // MAGIC
+    int32_t endian;          // ENDIAN, to detect files written with other byte order
+    int32_t version;         // VERSION
+    int32_t ncolumns;        // # of per-atom columns
+    int32_t unused;
+    char units[UNITLEN];     // units style, null terminated
+  };
+
+  struct ColumnInfo {
+    char name[NAMELEN];      // column label, same as in text dump, null terminated
+  };
+
+  struct FrameHeader {
+    char magic[8];           // FRAME_MAGIC
+    int64_t ntimestep;       // timestep of frame
+    int64_t natoms;          // # of atoms (rows) in frame
+    int64_t nbytes;          // size of frame in file, including this header
+    int64_t nchunks;         // # of chunks in frame
+    int32_t triclinic;       // 1 if triclinic box
+    int32_t timeflag;        // 1 if time is set
+    double time;             // simulation time of frame
+    double box[3][3];        // xlo,xhi,xy / ylo,yhi,xz / zlo,zhi,yz as in text dump
+    int32_t boundary[3][2];  // boundary flags as in native binary dump
+  };
+
+  struct ChunkHeader {
+    int64_t natoms;          // # of atoms (rows) in chunk
+    int64_t nbytes;          // size of chunk in file, including this header
+  };
+
+  struct BlockHeader {
+    int32_t encoding;        // DOUBLE or QUANTIZED or INTEGER
+    int32_t unused;
+    double precision;        // quantization step for QUANTIZED, else 0.0
+    int64_t nbytes;          // # of compressed bytes following the header
+  };
+
+  struct IndexEntry {
+    int64_t ntimestep;       // timestep of frame
+    int64_t offset;          // file offset of frame header
+  };
+
+  struct IndexFooter {
+    int64_t nframes;         // # of entries in frame index
+    int64_t offset;          // file offset of first index entry
+    char magic[8];           // INDEX_MAGIC, last bytes of file
+  };
+
+  // byte shuffle of n 8-byte values and its inverse
+
+  inline void shuffle(const void *in, void *out, size_t n)
+  {
+    auto src = (const unsigned char *) in;
+    auto dst = (unsigned char *) out;
+    for (size_t i = 0; i < n; i++)
+      for (int b = 0; b < 8; b++) dst[b * n + i] = src[8 * i + b];
+  }
+
+  inline void unshuffle(const void *in, void *out, size_t n)
+  {
+    auto src = (const unsigned char *) in;
+    auto dst = (unsigned char *) out;
+    for (size_t i = 0; i < n; i++)
+      for (int b = 0; b < 8; b++) dst[8 * i + b] = src[b * n + i];
+  }
+
+}    // namespace Zbin
+}    // namespace LAMMPS_NS
+
+#endif
@@ -27,6 +27,7 @@ class BoundaryCorrection : protected Pointers {
   BoundaryCorrection(LAMMPS *);
   virtual void vector_corr(double *, int, int, bool){};
   virtual void matrix_corr(bigint *, double **){};
+  virtual void diagonal_corr(double *, int){};
   virtual void compute_corr(double, int, int, double &, double *){};
 
  protected:
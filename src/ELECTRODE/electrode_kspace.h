@@ -27,6 +27,7 @@ class ElectrodeKSpace {
   virtual void compute_vector_corr(double *, int, int, bool) = 0;
   virtual void compute_matrix(bigint *, double **, bool) = 0;
   virtual void compute_matrix_corr(bigint *, double **) = 0;
+  virtual void compute_diagonal_corr(double *, int) = 0;
 };
 }    // namespace LAMMPS_NS
 
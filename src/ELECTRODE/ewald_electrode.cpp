@@ -1134,6 +1134,15 @@ void EwaldElectrode::compute_matrix_corr(bigint *imat, double **matrix)
   boundcorr->matrix_corr(imat, matrix);
 }
 
+/* ----------------------------------------------------------------------
+   add diagonal of the boundary correction matrix for atoms in group
+ ------------------------------------------------------------------------- */
+
+void EwaldElectrode::compute_diagonal_corr(double *diag, int grpbit)
+{
+  boundcorr->diagonal_corr(diag, grpbit);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void EwaldElectrode::update_eikr(bool enforce_update)
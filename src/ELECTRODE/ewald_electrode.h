@@ -43,6 +43,7 @@ class EwaldElectrode : public Ewald, public ElectrodeKSpace {
   void compute_vector_corr(double *, int, int, bool) override;
   void compute_matrix(bigint *, double **, bool) override;
   void compute_matrix_corr(bigint *, double **) override;
+  void compute_diagonal_corr(double *, int) override;
 
  protected:
   class BoundaryCorrection *boundcorr;
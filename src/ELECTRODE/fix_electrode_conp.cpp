@@ -21,6 +21,7 @@
 #include "citeme.h"
 #include "comm.h"
 #include "domain.h"
+#include "electrode_kspace.h"
 #include "electrode_math.h"
 #include "electrode_matrix.h"
 #include "electrode_vector.h"
@@ -28,6 +29,7 @@
 #include "force.h"
 #include "group.h"
 #include "input.h"
+#include "kspace.h"
 #include "math_const.h"
 #include "memory.h"
 #include "modify.h"
@@ -87,6 +89,7 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
 
   bool default_algo = true;
   algo = Algo::MATRIX_INV;
+  precond = Precond::NONE;
   matrix_algo = true;
   cg_threshold = 0.;
   write_inv = write_mat = write_vec = read_inv = read_mat = false;
@@ -196,6 +199,16 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
       thermo_time = utils::numeric(FLERR, arg[++iarg], false, lmp);
       thermo_init = utils::inumeric(FLERR, arg[++iarg], false, lmp);
       // toggle parameters
+    } else if ((strcmp(arg[iarg], "precond") == 0)) {
+      if (iarg + 2 > narg) error->all(FLERR, "Need one argument after precond keyword");
+      char *precond_arg = arg[++iarg];
+      if ((strcmp(precond_arg, "none") == 0)) {
+        precond = Precond::NONE;
+      } else if ((strcmp(precond_arg, "jacobi") == 0)) {
+        precond = Precond::JACOBI;
+      } else {
+        error->all(FLERR, "Unknown precond keyword {}", precond_arg);
+      }
     } else if ((strcmp(arg[iarg], "etypes") == 0)) {
       etypes_neighlists = utils::logical(FLERR, arg[++iarg], false, lmp);
     } else if ((strncmp(arg[iarg], "symm", 4) == 0)) {
@@ -239,6 +252,8 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
     error->all(FLERR,
                "Selected algorithm does not use matrix. Cannot read/write matrix or vector.");
   }
+  if (precond != Precond::NONE && algo == Algo::MATRIX_INV)
+    error->all(FLERR, "Preconditioning requires a conjugate gradient algorithm");
   if (read_inv && read_mat) error->all(FLERR, "Cannot read matrix from two files");
   if (write_mat && read_inv)
     error->all(FLERR, "Cannot write elastance matrix if reading capacitance matrix from file");
@@ -816,15 +831,17 @@ void FixElectrodeConp::update_charges()
       q_local[i] = q[atom->map(taglist_local[i])];    // pre-condition with current charges
     }
     q_local = constraint_correction(q_local);
+    if (precond != Precond::NONE) compute_precond_diag();
     MPI_Barrier(world);
     double mult_start = MPI_Wtime();
     auto a = ele_ele_interaction(q_local);
     MPI_Barrier(world);
     mult_time += MPI_Wtime() - mult_start;
     auto r = add_nlocalele(b, a);
-    auto d = constraint_projection(r);
+    auto d = apply_precond(r);
     double dot_old = dot_nlocalele(r, d);
-    double delta = dot_old;
+    // convergence is always judged on the unpreconditioned residual
+    double delta = (precond == Precond::NONE) ? dot_old : dot_nlocalele(r, constraint_projection(r));
     for (int k = 0; k < ngroup && delta > cg_threshold; k++, n_cg_step++) {
       MPI_Barrier(world);
       double mult_start_loop = MPI_Wtime();
@@ -842,10 +859,13 @@ void FixElectrodeConp::update_charges()
       } else {
         r = add_nlocalele(r, scale_vector(alpha, y));
       }
-      auto p = constraint_projection(r);
+      auto p = apply_precond(r);
       double dot_new = dot_nlocalele(r, p);
       d = add_nlocalele(p, scale_vector(dot_new / dot_old, d));
-      delta = dot_nlocalele(r, d);
+      if (precond == Precond::NONE)
+        delta = dot_nlocalele(r, d);
+      else
+        delta = dot_nlocalele(r, constraint_projection(r));
       dot_old = dot_new;
     }
     recompute_potential(b, q_local);
@@ -973,6 +993,53 @@ std::vector<double> FixElectrodeConp::times_elastance(std::vector<double> x)
   return out;
 }
 
+/* ----------------------------------------------------------------------
+   diagonal of the elastance matrix for the local electrode atoms.
+   mat_cg has the exact diagonal. For the matrix-free cg the Ewald self
+   term of the reciprocal space cancels the self-interaction correction,
+   leaving the Gaussian self energy, which is the same for all atoms, and
+   the per-atom Thomas-Fermi and boundary correction terms, e.g. the
+   dipole correction 4 pi z_i^2 / V of kspace_modify slab
+------------------------------------------------------------------------- */
+
+void FixElectrodeConp::compute_precond_diag()
+{
+  precond_inv_diag = std::vector<double>(nlocalele, 1.);
+  if (algo == Algo::MATRIX_CG) {
+    for (int i = 0; i < nlocalele; i++) {
+      double const diag = elastance[list_iele[i]][list_iele[i]];
+      if (diag > 0.) precond_inv_diag[i] = 1. / diag;
+    }
+    return;
+  }
+
+  double const preta = MY_SQRT2 / MY_PIS;
+  int *type = atom->type;
+  memset(potential_i, 0, atom->nmax * sizeof(double));
+  auto electrode_kspace = dynamic_cast<ElectrodeKSpace *>(force->kspace);
+  if (electrode_kspace) electrode_kspace->compute_diagonal_corr(potential_i, groupbit);
+  for (int i = 0; i < nlocalele; i++) {
+    int const iall = atom->map(taglist_local[i]);
+    double diag = preta * eta + potential_i[iall];
+    if (tfflag) diag += tf_types[type[iall]];
+    if (diag > 0.) precond_inv_diag[i] = 1. / diag;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   apply the preconditioner to a residual, keeping it in the subspace
+   allowed by the charge constraints
+------------------------------------------------------------------------- */
+
+std::vector<double> FixElectrodeConp::apply_precond(std::vector<double> r)
+{
+  if (precond == Precond::NONE) return constraint_projection(std::move(r));
+  assert((int) precond_inv_diag.size() == nlocalele);
+  r = constraint_projection(std::move(r));
+  for (int i = 0; i < nlocalele; i++) r[i] *= precond_inv_diag[i];
+  return constraint_projection(std::move(r));
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixElectrodeConp::update_psi()
@@ -71,6 +71,7 @@ class FixElectrodeConp : public Fix {
 
  protected:
   enum class Algo { MATRIX_INV, MATRIX_CG, CG };
+  enum class Precond { NONE, JACOBI };
   enum class VarStyle { CONST, EQUAL };
   virtual void update_psi();
   virtual void pre_update(){};
@@ -93,6 +94,7 @@ class FixElectrodeConp : public Fix {
   std::vector<int> iele_to_group_local;
   bool symm;    // symmetrize elastance for charge neutrality
   Algo algo;
+  Precond precond;
   std::vector<std::vector<double>> macro_elastance;      // used by conq
   std::vector<std::vector<double>> macro_capacitance;    // used by thermo
   double thermo_temp, thermo_time;                       // used by electrode/thermo only
@@ -140,6 +142,9 @@ class FixElectrodeConp : public Fix {
   std::vector<double> add_nlocalele(std::vector<double>, std::vector<double>);
   double dot_nlocalele(std::vector<double>, std::vector<double>);
   std::vector<double> times_elastance(std::vector<double>);
+  std::vector<double> precond_inv_diag;    // inverse elastance diagonal of local electrode atoms
+  void compute_precond_diag();
+  std::vector<double> apply_precond(std::vector<double>);
   std::vector<double> gather_ngroup(std::vector<double>);
   std::vector<double> gather_elevec_local(ElectrodeVector *);
   void set_charges(std::vector<double>);
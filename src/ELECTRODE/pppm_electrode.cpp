@@ -1865,6 +1865,15 @@ void PPPMElectrode::compute_matrix_corr(bigint *imat, double **matrix)
   boundcorr->matrix_corr(imat, matrix);
 }
 
+/* ----------------------------------------------------------------------
+   add diagonal of the boundary correction matrix for atoms in group
+ ------------------------------------------------------------------------- */
+
+void PPPMElectrode::compute_diagonal_corr(double *diag, int grpbit)
+{
+  boundcorr->diagonal_corr(diag, grpbit);
+}
+
 /* ----------------------------------------------------------------------
    compute b-vector EW3DC correction of constant potential approach
  -------------------------------------------------------------------------
@@ -174,3 +174,14 @@ void Slab2d::matrix_corr(bigint *imat, double **matrix)
     }
   }
 }
+
+void Slab2d::diagonal_corr(double *diag, int grpbit)
+{
+  int const nlocal = atom->nlocal;
+  int *mask = atom->mask;
+  double const g_ewald = force->kspace->g_ewald;
+  double const area = domain->xprd * domain->yprd;
+  double const aii = 2.0 * MY_PIS / area / g_ewald;
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & grpbit) diag[i] -= aii;
+}
@@ -27,6 +27,7 @@ class Slab2d : public BoundaryCorrection {
   Slab2d(LAMMPS *);
   void vector_corr(double *, int, int, bool) override;
   void matrix_corr(bigint *, double **) override;
+  void diagonal_corr(double *, int) override;
   void compute_corr(double, int, int, double &, double *) override;
   void setup(double);
 };
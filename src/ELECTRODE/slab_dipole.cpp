@@ -146,3 +146,13 @@ void SlabDipole::matrix_corr(bigint *imat, double **matrix)
     }
   }
 }
+
+void SlabDipole::diagonal_corr(double *diag, int grpbit)
+{
+  int const nlocal = atom->nlocal;
+  double **x = atom->x;
+  int *mask = atom->mask;
+  double const prefac = MY_4PI / get_volume();
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & grpbit) diag[i] += prefac * x[i][2] * x[i][2];
+}
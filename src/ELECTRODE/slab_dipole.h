@@ -27,6 +27,7 @@ class SlabDipole : public BoundaryCorrection {
   SlabDipole(LAMMPS *);
   void vector_corr(double *, int, int, bool);
   void matrix_corr(bigint *, double **);
+  void diagonal_corr(double *, int);
   void compute_corr(double, int, int, double &, double *);
   void setup(double);
 };
@@ -160,3 +160,13 @@ void WireDipole::matrix_corr(bigint *imat, double **matrix)
     }
   }
 }
+
+void WireDipole::diagonal_corr(double *diag, int grpbit)
+{
+  int const nlocal = atom->nlocal;
+  double **x = atom->x;
+  int *mask = atom->mask;
+  double const prefac = MY_2PI / get_volume();
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & grpbit) diag[i] += prefac * (x[i][0] * x[i][0] + x[i][1] * x[i][1]);
+}
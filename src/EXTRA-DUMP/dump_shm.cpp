@@ -0,0 +1,290 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#if !defined(_WIN32)
+
+#include "dump_shm.h"
+
+#include "domain.h"
+#include "error.h"
+#include "group.h"
+#include "update.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+DumpShm::DumpShm(LAMMPS *lmp, int narg, char **arg) :
+  DumpCustom(lmp, narg, arg), nslots(4), unlink_flag(1), segment(nullptr), nbytes(0),
+  iframe(0), islot(0), nrows(0), nexpect(0)
+{
+  if (multifile || multiproc)
+    error->all(FLERR,"Dump shm segment name {} must not contain '*' or '%'", filename);
+
+  // file name is the name of the shared memory segment, which starts with '/'
+
+  shmname = filename;
+  if (shmname[0] != '/') shmname = "/" + shmname;
+  if ((shmname.size() < 2) || (shmname.find('/',1) != std::string::npos))
+    error->all(FLERR,"Dump shm segment name {} must not contain '/' after its first character",
+               filename);
+
+  // per-atom values are copied as doubles into the segment
+
+  binary = 0;
+  compressed = 0;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  async_allow = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpShm::~DumpShm()
+{
+  close_segment(Shm::CLOSED);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpShm::init_style()
+{
+  if (multiproc) error->all(FLERR,"Dump shm does not support dump_modify nfile or fileper");
+  if (!write_header_flag) error->all(FLERR,"Dump shm does not support dump_modify header no");
+
+  for (int i = 0; i < nfield; i++)
+    if (vtype[i] == Dump::STRING)
+      error->all(FLERR,"Dump shm does not support string columns");
+
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   create the segment, sized for all atoms in the dump group
+   the segment is replaced by a larger one when a frame does not fit
+------------------------------------------------------------------------- */
+
+void DumpShm::openfile()
+{
+  if (singlefile_opened) return;
+  singlefile_opened = 1;
+
+  bigint ncount = group->count(igroup);
+  if (filewriter) create_segment(MAX(ncount,1));
+}
+
+/* ----------------------------------------------------------------------
+   start writing a new frame with ndump atoms into the next slot
+   odd sequence number tells consumers that the slot is being overwritten
+------------------------------------------------------------------------- */
+
+void DumpShm::write_header(bigint ndump)
+{
+  auto header = (Shm::SegmentHeader *) segment;
+  if (ndump > header->capacity) {
+    close_segment(Shm::RESIZED);
+    create_segment(ndump + ndump/4);
+  }
+
+  islot = iframe % nslots;
+  Shm::SlotHeader *slot = Shm::slot(segment,islot);
+  slot->sequence.store(2*iframe+1,std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->ntimestep = update->ntimestep;
+  slot->natoms = ndump;
+  slot->triclinic = domain->triclinic;
+  slot->timeflag = time_flag;
+  slot->time = compute_time();
+  memset(slot->box,0,sizeof(slot->box));
+  slot->box[0][0] = boxxlo;
+  slot->box[0][1] = boxxhi;
+  slot->box[1][0] = boxylo;
+  slot->box[1][1] = boxyhi;
+  slot->box[2][0] = boxzlo;
+  slot->box[2][1] = boxzhi;
+  if (domain->triclinic) {
+    slot->box[0][2] = boxxy;
+    slot->box[1][2] = boxxz;
+    slot->box[2][2] = boxyz;
+  }
+  for (int i = 0; i < 3; i++) {
+    slot->boundary[i][0] = domain->boundary[i][0];
+    slot->boundary[i][1] = domain->boundary[i][1];
+  }
+
+  nrows = 0;
+  nexpect = ndump;
+  if (nexpect == 0) publish();
+}
+
+/* ----------------------------------------------------------------------
+   scatter rows received from each proc into the columns of the slot
+   frame is published once all rows have arrived
+------------------------------------------------------------------------- */
+
+void DumpShm::write_data(int n, double *mybuf)
+{
+  if (nrows + n > nexpect) error->one(FLERR,"Dump shm received more atoms than expected");
+
+  for (int k = 0; k < nfield; k++) {
+    double *column = Shm::column(segment,islot,k) + nrows;
+    for (int i = 0; i < n; i++) column[i] = mybuf[i*size_one+k];
+  }
+
+  nrows += n;
+  if (nrows == nexpect) publish();
+}
+
+/* ----------------------------------------------------------------------
+   mark current slot as complete and make the frame visible to consumers
+------------------------------------------------------------------------- */
+
+void DumpShm::publish()
+{
+  auto header = (Shm::SegmentHeader *) segment;
+  Shm::SlotHeader *slot = Shm::slot(segment,islot);
+
+  slot->wtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  slot->sequence.store(2*iframe+2,std::memory_order_release);
+  header->nframes.store(iframe+1,std::memory_order_release);
+  iframe++;
+}
+
+/* ----------------------------------------------------------------------
+   create and map a new segment for frames with up to capacity atoms
+   a left over segment with the same name is unlinked first,
+   consumers still attached to it keep their mapping
+------------------------------------------------------------------------- */
+
+void DumpShm::create_segment(bigint capacity)
+{
+  const int64_t header_bytes = Shm::align(sizeof(Shm::SegmentHeader) +
+                                          nfield*sizeof(Shm::ColumnInfo));
+  const int64_t data_offset = Shm::align(sizeof(Shm::SlotHeader));
+  const int64_t slot_bytes = Shm::align(data_offset + nfield*capacity*sizeof(double));
+  nbytes = header_bytes + nslots*slot_bytes;
+
+  shm_unlink(shmname.c_str());
+  int fd = shm_open(shmname.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0)
+    error->one(FLERR,"Cannot create shared memory segment {}: {}", shmname, utils::getsyserror());
+
+  // reserve memory up front, so a full /dev/shm is an error here and not a crash later
+
+  int err = ftruncate(fd, nbytes);
+#if defined(__linux__)
+  if (err == 0) err = posix_fallocate(fd, 0, nbytes);
+#endif
+  if (err != 0) {
+    close(fd);
+    shm_unlink(shmname.c_str());
+    error->one(FLERR,"Cannot allocate {} bytes for shared memory segment {}", nbytes, shmname);
+  }
+
+  segment = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (segment == MAP_FAILED) {
+    segment = nullptr;
+    shm_unlink(shmname.c_str());
+    error->one(FLERR,"Cannot map shared memory segment {}: {}", shmname, utils::getsyserror());
+  }
+
+  auto header = new (segment) Shm::SegmentHeader();
+  memcpy(header->magic, Shm::MAGIC, sizeof(header->magic));
+  header->version = Shm::VERSION;
+  header->ncolumns = nfield;
+  header->nslots = nslots;
+  header->pid = getpid();
+  header->capacity = capacity;
+  header->slot_offset = header_bytes;
+  header->slot_bytes = slot_bytes;
+  header->data_offset = data_offset;
+  strncpy(header->units, update->unit_style, Shm::UNITLEN-1);
+
+  auto info = (Shm::ColumnInfo *) ((char *) segment + sizeof(Shm::SegmentHeader));
+  auto words = utils::split_words(columns);
+  for (int i = 0; i < nfield; i++) {
+    if (words[i].size() >= Shm::NAMELEN)
+      error->one(FLERR,"Dump shm column name {} is too long", words[i]);
+    strncpy(info[i].name, words[i].c_str(), Shm::NAMELEN-1);
+  }
+
+  for (int i = 0; i < nslots; i++) new (Shm::slot(segment,i)) Shm::SlotHeader();
+
+  // frame numbering restarts with each segment
+
+  iframe = 0;
+  header->nframes.store(0,std::memory_order_relaxed);
+  header->state.store(Shm::ACTIVE,std::memory_order_release);
+}
+
+/* ----------------------------------------------------------------------
+   tell consumers the segment is no longer written, then unmap it
+------------------------------------------------------------------------- */
+
+void DumpShm::close_segment(int state)
+{
+  if (!segment) return;
+
+  auto header = (Shm::SegmentHeader *) segment;
+  header->state.store(state,std::memory_order_release);
+  munmap(segment, nbytes);
+  segment = nullptr;
+
+  if (unlink_flag && (state == Shm::CLOSED)) shm_unlink(shmname.c_str());
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpShm::modify_param(int narg, char **arg)
+{
+  int consumed = DumpCustom::modify_param(narg, arg);
+  if (consumed) return consumed;
+
+  // segment is recreated, if it exists already
+
+  if (strcmp(arg[0], "slots") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify slots", error);
+    int n = utils::inumeric(FLERR, arg[1], false, lmp);
+    if (n < 1) error->all(FLERR, "Dump_modify slots must be > 0");
+    if (segment && (n != nslots)) {
+      bigint capacity = ((Shm::SegmentHeader *) segment)->capacity;
+      close_segment(Shm::RESIZED);
+      nslots = n;
+      create_segment(capacity);
+    }
+    nslots = n;
+    return 2;
+  }
+
+  if (strcmp(arg[0], "unlink") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify unlink", error);
+    unlink_flag = utils::logical(FLERR, arg[1], false, lmp);
+    return 2;
+  }
+
+  return 0;
+}
+
+#endif
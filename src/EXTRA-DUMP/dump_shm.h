@@ -0,0 +1,63 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#if !defined(_WIN32)
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(shm,DumpShm);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_SHM_H
+#define LMP_DUMP_SHM_H
+
+#include "dump_custom.h"
+#include "shm_format.h"
+
+#include <string>
+
+namespace LAMMPS_NS {
+
+class DumpShm : public DumpCustom {
+ public:
+  DumpShm(class LAMMPS *, int, char **);
+  ~DumpShm() override;
+
+ protected:
+  std::string shmname;    // name of shared memory segment, starting with '/'
+  int nslots;             // # of frames kept in ring buffer
+  int unlink_flag;        // 1 if segment is removed when dump is deleted
+  void *segment;          // mapped segment, nullptr if none
+  size_t nbytes;          // size of mapped segment
+  int64_t iframe;         // index of frame currently written
+  int islot;              // slot of frame currently written
+  bigint nrows;           // # of rows written to current frame so far
+  bigint nexpect;         // # of rows in current frame
+
+  void init_style() override;
+  void openfile() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  int modify_param(int, char **) override;
+
+  void create_segment(bigint);
+  void close_segment(int);
+  void publish();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+#endif
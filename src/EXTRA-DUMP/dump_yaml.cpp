@@ -30,6 +30,7 @@ DumpYAML::DumpYAML(class LAMMPS *_lmp, int narg, char **args) :
 {
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -0,0 +1,106 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_SHM_FORMAT_H
+#define LMP_SHM_FORMAT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// layout of the POSIX shared memory segment written by dump shm
+// this header has no LAMMPS dependencies, so consumers can include it
+//
+// segment = segment header, column info, then Nslots slots
+// each slot = slot header, then one column of Capacity doubles per column
+//   all offsets and sizes are multiples of ALIGN bytes
+// the writer publishes frame i (i = 0,1,2,...) into slot i % Nslots:
+//   slot.sequence = 2*i+1, write slot header and data,
+//   slot.sequence = 2*i+2, segment.nframes = i+1
+// the writer never waits for consumers, a slow consumer loses frames
+// a consumer reads the newest frame i = nframes-1 as follows:
+//   s = slot.sequence, frame is complete if s == 2*i+2
+//   use data in place (zero copy) or copy it out
+//   data was valid if slot.sequence is still s afterwards
+// if state is not ACTIVE, the writer closed the segment or replaced it
+//   with a larger one under the same name, consumers should re-attach
+
+namespace LAMMPS_NS {
+namespace Shm {
+
+  static constexpr char MAGIC[8] = {'L', 'M', 'P', 'S', 'H', 'M', '0', '1'};
+  static constexpr int32_t VERSION = 1;
+  static constexpr int NAMELEN = 32;
+  static constexpr int UNITLEN = 16;
+  static constexpr int64_t ALIGN = 64;
+
+  // segment states
+
+  enum { ACTIVE = 1, CLOSED = 2, RESIZED = 3 };
+
+  struct SegmentHeader {
+    char magic[8];                    // MAGIC
+    int32_t version;                  // VERSION
+    int32_t ncolumns;                 // # of per-atom columns
+    int32_t nslots;                   // # of slots in ring buffer
+    int32_t pid;                      // process ID of writer
+    int64_t capacity;                 // max # of atoms per frame
+    int64_t slot_offset;              // offset of first slot from start of segment
+    int64_t slot_bytes;               // size of one slot, including its header
+    int64_t data_offset;              // offset of first column from start of slot
+    std::atomic<int64_t> nframes;     // # of frames published so far
+    std::atomic<int32_t> state;       // ACTIVE or CLOSED or RESIZED
+    int32_t unused;
+    char units[UNITLEN];              // units style, null terminated
+  };
+
+  struct ColumnInfo {
+    char name[NAMELEN];               // column label, same as in text dump, null terminated
+  };
+
+  struct SlotHeader {
+    std::atomic<int64_t> sequence;    // 2*frame+1 while written, 2*frame+2 when complete
+    int64_t ntimestep;                // timestep of frame
+    int64_t natoms;                   // # of atoms (rows) in frame
+    int64_t wtime;                    // wall clock time of publishing in ns since epoch
+    int32_t triclinic;                // 1 if triclinic box
+    int32_t timeflag;                 // 1 if time is set
+    double time;                      // simulation time of frame
+    double box[3][3];                 // xlo,xhi,xy / ylo,yhi,xz / zlo,zhi,yz as in text dump
+    int32_t boundary[3][2];           // boundary flags as in native binary dump
+  };
+
+  static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t),
+                "Shared memory dump requires lock-free 64-bit atomics");
+
+  inline int64_t align(int64_t n) { return (n + ALIGN - 1) / ALIGN * ALIGN; }
+
+  // pointer to column icol of slot islot
+
+  inline double *column(void *segment, int islot, int icol)
+  {
+    auto header = (SegmentHeader *) segment;
+    auto slot = (char *) segment + header->slot_offset + islot * header->slot_bytes;
+    return (double *) (slot + header->data_offset) + icol * header->capacity;
+  }
+
+  inline SlotHeader *slot(void *segment, int islot)
+  {
+    auto header = (SegmentHeader *) segment;
+    return (SlotHeader *) ((char *) segment + header->slot_offset + islot * header->slot_bytes);
+  }
+
+}    // namespace Shm
+}    // namespace LAMMPS_NS
+
+#endif
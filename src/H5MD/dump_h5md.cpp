@@ -23,13 +23,16 @@
 #include "error.h"
 #include "force.h"
 #include "group.h"
+#include "input.h"
 #include "memory.h"
 #include "output.h"
 #include "update.h"
+#include "variable.h"
 #include "version.h"
 
 #include "ch5md.h"
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <cstring>
@@ -76,6 +79,16 @@ DumpH5MD::DumpH5MD(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg)
   other_dump = nullptr;
   author_name = nullptr;
 
+  parallel_flag = 0;
+  ordered = 1;
+  chunk_size = 0;
+  deflate_level = 0;
+  xfer = H5P_DEFAULT;
+  maxlocal = 0;
+  dump_position = dump_velocity = dump_force = nullptr;
+  dump_image = dump_species = dump_charge = nullptr;
+  dump_id = nullptr;
+
   every_dump = utils::inumeric(FLERR,arg[3],false,lmp);
   every_position = every_image = -1;
   every_velocity = every_force = every_species = -1;
@@ -170,41 +183,103 @@ DumpH5MD::DumpH5MD(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg)
         error->all(FLERR, "Illegal dump h5md command: author argument repeated");
       }
       iarg+=2;
+    } else if (strcmp(arg[iarg], "parallel")==0) {
+      if (iarg+1>=narg) {
+        error->all(FLERR, "Invalid number of arguments in dump h5md");
+      }
+      parallel_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg+=2;
+    } else if (strcmp(arg[iarg], "chunk")==0) {
+      if (iarg+1>=narg) {
+        error->all(FLERR, "Invalid number of arguments in dump h5md");
+      }
+      chunk_size = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (chunk_size<1) error->all(FLERR, "Illegal dump h5md chunk size {}", chunk_size);
+      iarg+=2;
+    } else if (strcmp(arg[iarg], "deflate")==0) {
+      if (iarg+1>=narg) {
+        error->all(FLERR, "Invalid number of arguments in dump h5md");
+      }
+      deflate_level = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (deflate_level<0 || deflate_level>9)
+        error->all(FLERR, "Dump h5md deflate level must be between 0 and 9");
+      iarg+=2;
     } else {
       error->all(FLERR, "Invalid argument to dump h5md");
     }
   }
 
+  if (parallel_flag) {
+#if !defined(H5_HAVE_PARALLEL)
+    error->all(FLERR, "Dump h5md parallel yes requires an HDF5 library with parallel I/O support");
+#endif
+    if (other_dump) error->all(FLERR, "Dump h5md parallel yes cannot be used with file_from");
+    if (every_dump==0) error->all(FLERR, "Dump h5md parallel yes cannot be used with write_dump");
+  }
+  if (deflate_level>0) {
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)<=0)
+      error->all(FLERR, "HDF5 library does not support the deflate filter for dump h5md");
+#if defined(H5_HAVE_PARALLEL) && !H5_VERSION_GE(1,10,2)
+    if (parallel_flag)
+      error->all(FLERR, "Dump h5md deflate with parallel yes requires HDF5 version 1.10.2 or later");
+#endif
+  }
+
   // allocate global array for atom coords
 
   bigint n = group->count(igroup);
   if ((bigint) domain->dimension*n > MAXSMALLINT) error->all(FLERR,"Too many atoms for dump h5md");
   natoms = static_cast<int> (n);
 
-  if (every_position>=0)
-    memory->create(dump_position,domain->dimension*natoms,"dump:position");
-  if (every_image>=0)
-    memory->create(dump_image,domain->dimension*natoms,"dump:image");
-  if (every_velocity>=0)
-    memory->create(dump_velocity,domain->dimension*natoms,"dump:velocity");
-  if (every_force>=0)
-    memory->create(dump_force,domain->dimension*natoms,"dump:force");
-  if (every_species>=0)
-    memory->create(dump_species,natoms,"dump:species");
-  if (every_charge>=0)
-    memory->create(dump_charge,natoms,"dump:charge");
+  // in parallel mode, per-atom arrays only hold my atoms and grow as needed
+  // if atom IDs in the group are 1 to natoms, an atom is written to row ID-1,
+  // else each proc writes a block of rows and the IDs are stored in the file
+
+  if (parallel_flag) {
+    tagint maxtag = 0, maxtag_all;
+    for (int i = 0; i < atom->nlocal; i++)
+      if (atom->mask[i] & groupbit) maxtag = MYMAX(maxtag,atom->tag[i]);
+    MPI_Allreduce(&maxtag,&maxtag_all,1,MPI_LMP_TAGINT,MPI_MAX,world);
+    ordered = (maxtag_all == n) ? 1 : 0;
+    if (chunk_size==0) chunk_size = MYMAX((natoms+nprocs-1)/nprocs,1);
+    grow_local(1);
+  } else {
+    if (every_position>=0)
+      memory->create(dump_position,domain->dimension*natoms,"dump:position");
+    if (every_image>=0)
+      memory->create(dump_image,domain->dimension*natoms,"dump:image");
+    if (every_velocity>=0)
+      memory->create(dump_velocity,domain->dimension*natoms,"dump:velocity");
+    if (every_force>=0)
+      memory->create(dump_force,domain->dimension*natoms,"dump:force");
+    if (every_species>=0)
+      memory->create(dump_species,natoms,"dump:species");
+    if (every_charge>=0)
+      memory->create(dump_charge,natoms,"dump:charge");
+  }
 
   openfile();
   ntotal = 0;
+
+#if defined(H5_HAVE_PARALLEL)
+  if (parallel_flag) {
+    xfer = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(xfer, H5FD_MPIO_COLLECTIVE);
+  }
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
 
 DumpH5MD::~DumpH5MD()
 {
+  // in parallel mode all procs have the file open
+
+  bool owner = (me==0) || parallel_flag;
+
   if (every_position>=0) {
     memory->destroy(dump_position);
-    if (me==0) {
+    if (owner) {
       h5md_close_element(particles_data.position);
       if (do_box)
         h5md_close_element(particles_data.box_edges);
@@ -212,25 +287,34 @@ DumpH5MD::~DumpH5MD()
   }
   if (every_image>=0) {
     memory->destroy(dump_image);
-    if (me==0) h5md_close_element(particles_data.image);
+    if (owner) h5md_close_element(particles_data.image);
   }
   if (every_velocity>=0) {
     memory->destroy(dump_velocity);
-    if (me==0) h5md_close_element(particles_data.velocity);
+    if (owner) h5md_close_element(particles_data.velocity);
   }
   if (every_force>=0) {
     memory->destroy(dump_force);
-    if (me==0) h5md_close_element(particles_data.force);
+    if (owner) h5md_close_element(particles_data.force);
   }
   if (every_species>=0) {
     memory->destroy(dump_species);
-    if (me==0) h5md_close_element(particles_data.species);
+    if (owner) h5md_close_element(particles_data.species);
   }
   if (every_charge>=0) {
     memory->destroy(dump_charge);
-    if (me==0) h5md_close_element(particles_data.charge);
+    if (owner) h5md_close_element(particles_data.charge);
   }
+  memory->destroy(dump_id);
+
+  // file must be closed collectively before MPI is finalized
 
+  if (parallel_flag) {
+    if (!ordered) h5md_close_element(particles_data.id);
+    H5Gclose(particles_data.group);
+    h5md_close_file(datafile);
+    H5Pclose(xfer);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -258,13 +342,21 @@ void DumpH5MD::openfile()
     }
   }
 
-  if (me == 0) {
+  if (me == 0 || parallel_flag) {
     if (!other_dump) {
+      hid_t fapl = H5P_DEFAULT;
+#if defined(H5_HAVE_PARALLEL)
+      if (parallel_flag) {
+        fapl = H5Pcreate(H5P_FILE_ACCESS);
+        H5Pset_fapl_mpio(fapl, world, MPI_INFO_NULL);
+      }
+#endif
       if (author_name==nullptr) {
-        datafile = h5md_create_file(filename, "N/A", nullptr, "lammps", LAMMPS_VERSION);
+        datafile = h5md_create_file_fapl(filename, "N/A", nullptr, "lammps", LAMMPS_VERSION, fapl);
       } else {
-        datafile = h5md_create_file(filename, author_name, nullptr, "lammps", LAMMPS_VERSION);
+        datafile = h5md_create_file_fapl(filename, author_name, nullptr, "lammps", LAMMPS_VERSION, fapl);
       }
+      if (fapl != H5P_DEFAULT) H5Pclose(fapl);
       group_name_length = strlen(group->names[igroup])+1;
       group_name = new char[group_name_length];
       strcpy(group_name, group->names[igroup]);
@@ -277,21 +369,23 @@ void DumpH5MD::openfile()
       dims[0] = natoms;
       dims[1] = domain->dimension;
       if (every_position>0) {
-        particles_data.position = h5md_create_time_data(particles_data.group, "position", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.position = h5md_create_time_data_chunked(particles_data.group, "position", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
         h5md_create_box(&particles_data, dims[1], boundary, true, nullptr, &particles_data.position);
       }
       if (every_image>0)
-        particles_data.image = h5md_create_time_data(particles_data.group, "image", 2, dims, H5T_NATIVE_INT, &particles_data.position);
+        particles_data.image = h5md_create_time_data_chunked(particles_data.group, "image", 2, dims, chunk_size, deflate_level, H5T_NATIVE_INT, &particles_data.position);
       if (every_velocity>0)
-        particles_data.velocity = h5md_create_time_data(particles_data.group, "velocity", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.velocity = h5md_create_time_data_chunked(particles_data.group, "velocity", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
       if (every_force>0)
-        particles_data.force = h5md_create_time_data(particles_data.group, "force", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.force = h5md_create_time_data_chunked(particles_data.group, "force", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
       if (every_species>0)
-        particles_data.species = h5md_create_time_data(particles_data.group, "species", 1, dims, H5T_NATIVE_INT, nullptr);
+        particles_data.species = h5md_create_time_data_chunked(particles_data.group, "species", 1, dims, chunk_size, deflate_level, H5T_NATIVE_INT, nullptr);
       if (every_charge>0) {
-        particles_data.charge = h5md_create_time_data(particles_data.group, "charge", 1, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.charge = h5md_create_time_data_chunked(particles_data.group, "charge", 1, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
         h5md_write_string_attribute(particles_data.group, "charge", "type", "effective");
       }
+      if (parallel_flag && !ordered)
+        particles_data.id = h5md_create_time_data_chunked(particles_data.group, "id", 1, dims, chunk_size, deflate_level, (sizeof(tagint)==sizeof(int64_t)) ? H5T_NATIVE_INT64 : H5T_NATIVE_INT, nullptr);
     } else {
       datafile = other_dump->datafile;
       group_name_length = strlen(group->names[igroup]);
@@ -305,19 +399,19 @@ void DumpH5MD::openfile()
       dims[0] = natoms;
       dims[1] = domain->dimension;
       if (every_position>0) {
-        particles_data.position = h5md_create_time_data(particles_data.group, "position", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.position = h5md_create_time_data_chunked(particles_data.group, "position", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
         h5md_create_box(&particles_data, dims[1], boundary, true, nullptr, &particles_data.position);
       }
       if (every_image>0)
-        particles_data.image = h5md_create_time_data(particles_data.group, "image", 2, dims, H5T_NATIVE_INT, &particles_data.position);
+        particles_data.image = h5md_create_time_data_chunked(particles_data.group, "image", 2, dims, chunk_size, deflate_level, H5T_NATIVE_INT, &particles_data.position);
       if (every_velocity>0)
-        particles_data.velocity = h5md_create_time_data(particles_data.group, "velocity", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.velocity = h5md_create_time_data_chunked(particles_data.group, "velocity", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
       if (every_force>0)
-        particles_data.force = h5md_create_time_data(particles_data.group, "force", 2, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.force = h5md_create_time_data_chunked(particles_data.group, "force", 2, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
       if (every_species>0)
-        particles_data.species = h5md_create_time_data(particles_data.group, "species", 1, dims, H5T_NATIVE_INT, nullptr);
+        particles_data.species = h5md_create_time_data_chunked(particles_data.group, "species", 1, dims, chunk_size, deflate_level, H5T_NATIVE_INT, nullptr);
       if (every_charge>0) {
-        particles_data.charge = h5md_create_time_data(particles_data.group, "charge", 1, dims, H5T_NATIVE_DOUBLE, nullptr);
+        particles_data.charge = h5md_create_time_data_chunked(particles_data.group, "charge", 1, dims, chunk_size, deflate_level, H5T_NATIVE_DOUBLE, nullptr);
         h5md_write_string_attribute(particles_data.group, "charge", "type", "effective");
       }
 
@@ -398,14 +492,35 @@ void DumpH5MD::write_data(int n, double *mybuf)
 {
   // copy buf atom coords into global array
 
+  store(n,mybuf,ntotal);
+  ntotal += n;
+
+  // if last chunk of atoms in this snapshot, write global arrays to file
+
+  if (ntotal == natoms) {
+    if (every_dump>0) {
+      write_frame();
+      ntotal = 0;
+    } else {
+      write_fixed_frame();
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy n rows of mybuf into per-atom arrays, starting at row first
+------------------------------------------------------------------------- */
+
+void DumpH5MD::store(int n, double *mybuf, int first)
+{
   int m = 0;
   int dim = domain->dimension;
-  int k = dim*ntotal;
-  int k_image = dim*ntotal;
-  int k_velocity = dim*ntotal;
-  int k_force = dim*ntotal;
-  int k_species = ntotal;
-  int k_charge = ntotal;
+  int k = dim*first;
+  int k_image = dim*first;
+  int k_velocity = dim*first;
+  int k_force = dim*first;
+  int k_species = first;
+  int k_charge = first;
   for (int i = 0; i < n; i++) {
     if (every_position>=0) {
       for (int j=0; j<dim; j++) {
@@ -428,18 +543,6 @@ void DumpH5MD::write_data(int n, double *mybuf)
       dump_species[k_species++] = mybuf[m++];
     if (every_charge>=0)
       dump_charge[k_charge++] = mybuf[m++];
-    ntotal++;
-  }
-
-  // if last chunk of atoms in this snapshot, write global arrays to file
-
-  if (ntotal == natoms) {
-    if (every_dump>0) {
-      write_frame();
-      ntotal = 0;
-    } else {
-      write_fixed_frame();
-    }
   }
 }
 
@@ -469,26 +572,161 @@ void DumpH5MD::write_frame()
   edges[2] = boxzhi - boxzlo;
   if (every_position>0) {
     if (local_step % (every_position*every_dump) == 0) {
-      h5md_append(particles_data.position, dump_position, local_step, local_time);
-      h5md_append(particles_data.box_edges, edges, local_step, local_time);
+      append(particles_data.position, dump_position, local_step, local_time, true);
+      append(particles_data.box_edges, edges, local_step, local_time, false);
       if (every_image>0)
-        h5md_append(particles_data.image, dump_image, local_step, local_time);
+        append(particles_data.image, dump_image, local_step, local_time, true);
     }
   } else {
-    if (do_box) h5md_append(particles_data.box_edges, edges, local_step, local_time);
+    if (do_box) append(particles_data.box_edges, edges, local_step, local_time, false);
   }
   if (every_velocity>0 && local_step % (every_velocity*every_dump) == 0) {
-    h5md_append(particles_data.velocity, dump_velocity, local_step, local_time);
+    append(particles_data.velocity, dump_velocity, local_step, local_time, true);
   }
   if (every_force>0 && local_step % (every_force*every_dump) == 0) {
-    h5md_append(particles_data.force, dump_force, local_step, local_time);
+    append(particles_data.force, dump_force, local_step, local_time, true);
   }
   if (every_species>0 && local_step % (every_species*every_dump) == 0) {
-    h5md_append(particles_data.species, dump_species, local_step, local_time);
+    append(particles_data.species, dump_species, local_step, local_time, true);
   }
   if (every_charge>0 && local_step % (every_charge*every_dump) == 0) {
-    h5md_append(particles_data.charge, dump_charge, local_step, local_time);
+    append(particles_data.charge, dump_charge, local_step, local_time, true);
+  }
+  if (parallel_flag && !ordered)
+    append(particles_data.id, dump_id, local_step, local_time, true);
+}
+
+/* ----------------------------------------------------------------------
+   append one time step of an element
+   in parallel mode, each proc writes its own rows of per-atom data
+   and proc 0 writes box data, step and time
+------------------------------------------------------------------------- */
+
+void DumpH5MD::append(h5md_element e, void *data, int step, double time, bool peratom)
+{
+  if (!parallel_flag) {
+    h5md_append(e, data, step, time);
+  } else if (peratom) {
+    h5md_append_rows(e, data, step, time, run_start.size(), run_start.data(), run_count.data(),
+                     me==0, xfer);
+  } else {
+    hsize_t start = 0, count = domain->dimension;
+    h5md_append_rows(e, data, step, time, (me==0) ? 1 : 0, &start, &count, me==0, xfer);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same sequence as Dump::write(), but atoms are not gathered to proc 0
+   each proc orders its atoms by ID and writes them to the datasets
+------------------------------------------------------------------------- */
+
+void DumpH5MD::write()
+{
+  if (parallel_flag) write_parallel();
+  else Dump::write();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpH5MD::write_parallel()
+{
+  boxxlo = domain->boxlo[0];
+  boxxhi = domain->boxhi[0];
+  boxylo = domain->boxlo[1];
+  boxyhi = domain->boxhi[1];
+  boxzlo = domain->boxlo[2];
+  boxzhi = domain->boxhi[2];
+
+  nme = count();
+
+  if (delay_flag && update->ntimestep < delaystep) return;
+
+  if (skipflag) {
+    double value = input->variable->compute_equal(skipindex);
+    if (value != 0.0) return;
   }
+
+  // datasets have a fixed number of rows
+
+  bigint bnme = nme;
+  bigint btotal;
+  MPI_Allreduce(&bnme,&btotal,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (btotal != natoms)
+    error->all(FLERR,"Dump h5md number of atoms changed from {} to {}", natoms, btotal);
+
+  if (nme*size_one > maxbuf) {
+    if ((bigint) nme * size_one > MAXSMALLINT)
+      error->one(FLERR,"Too much per-proc info for dump");
+    maxbuf = nme * size_one;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"dump:buf");
+  }
+  if (nme > maxids) {
+    maxids = nme;
+    memory->destroy(ids);
+    memory->create(ids,maxids,"dump:ids");
+  }
+
+  pack(ids);
+
+  // copy my atoms into per-atom arrays in order of their IDs
+
+  std::vector<int> index(nme);
+  for (int i = 0; i < nme; i++) index[i] = i;
+  std::sort(index.begin(), index.end(), [this](int a, int b) { return ids[a] < ids[b]; });
+
+  grow_local(nme);
+  for (int i = 0; i < nme; i++) {
+    store(1, &buf[(bigint) index[i]*size_one], i);
+    if (!ordered) dump_id[i] = ids[index[i]];
+  }
+
+  // rows of my atoms: runs of consecutive IDs or one block after lower procs
+
+  run_start.clear();
+  run_count.clear();
+
+  if (ordered) {
+    int flag = 0;
+    for (int i = 0; i < nme; i++) {
+      tagint itag = ids[index[i]];
+      if (itag < 1 || itag > natoms) flag = 1;
+      else if (i && (itag == ids[index[i-1]] + 1)) run_count.back()++;
+      else {
+        run_start.push_back(itag-1);
+        run_count.push_back(1);
+      }
+    }
+    int flagall;
+    MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+    if (flagall) error->all(FLERR,"Dump h5md atom IDs must be 1 to {} with parallel yes", natoms);
+  } else {
+    bigint offset;
+    MPI_Scan(&bnme,&offset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    run_start.push_back(offset-nme);
+    run_count.push_back(nme);
+  }
+
+  write_frame();
+}
+
+/* ----------------------------------------------------------------------
+   grow per-atom arrays to hold n of my atoms in parallel mode
+------------------------------------------------------------------------- */
+
+void DumpH5MD::grow_local(int n)
+{
+  if (n <= maxlocal) return;
+  maxlocal = n;
+
+  int dim = domain->dimension;
+  if (every_position>=0) memory->grow(dump_position,dim*maxlocal,"dump:position");
+  if (every_image>=0) memory->grow(dump_image,dim*maxlocal,"dump:image");
+  if (every_velocity>=0) memory->grow(dump_velocity,dim*maxlocal,"dump:velocity");
+  if (every_force>=0) memory->grow(dump_force,dim*maxlocal,"dump:force");
+  if (every_species>=0) memory->grow(dump_species,maxlocal,"dump:species");
+  if (every_charge>=0) memory->grow(dump_charge,maxlocal,"dump:charge");
+  if (!ordered) memory->grow(dump_id,maxlocal,"dump:id");
 }
 
 void DumpH5MD::write_fixed_frame()
@@ -24,6 +24,8 @@ DumpStyle(h5md,DumpH5MD);
 #include "ch5md.h"
 #include "dump.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class DumpH5MD : public Dump {
@@ -42,6 +44,17 @@ class DumpH5MD : public Dump {
   bool do_box;
   bool create_group;
 
+  // parallel output, each proc writes its own atoms with collective MPI-IO
+  int parallel_flag;    // 1 if all procs write to the file with parallel HDF5
+  int ordered;          // 1 if atom IDs are 1 to natoms, row of an atom is its ID-1
+                        // 0 if each proc writes a block of rows at a prefix sum offset
+  int chunk_size;       // # of atoms per chunk of per-atom datasets, 0 = default
+  int deflate_level;    // gzip compression level of per-atom datasets, 0 = none
+  hid_t xfer;           // dataset transfer property list
+  int maxlocal;         // size of per-atom arrays in parallel mode
+  tagint *dump_id;
+  std::vector<hsize_t> run_start, run_count;    // rows of my atoms in datasets
+
   // data arrays and intervals
   int every_dump;
   double *dump_position;
@@ -60,12 +73,17 @@ class DumpH5MD : public Dump {
   void init_style() override;
   int modify_param(int, char **) override;
   void openfile() override;
+  void write() override;
   void write_header(bigint) override{};
   void pack(tagint *) override;
   void write_data(int, double *) override;
 
+  void store(int, double *, int);
   void write_frame();
   void write_fixed_frame();
+  void write_parallel();
+  void grow_local(int);
+  void append(h5md_element, void *, int, double, bool);
 };
 
 }    // namespace LAMMPS_NS
@@ -1065,6 +1065,11 @@ void PPPMElectrodeIntel::compute_matrix_corr(bigint *imat, double **matrix)
   boundcorr->matrix_corr(imat, matrix);
 }
 
+void PPPMElectrodeIntel::compute_diagonal_corr(double *diag, int grpbit)
+{
+  boundcorr->diagonal_corr(diag, grpbit);
+}
+
 void PPPMElectrodeIntel::compute_vector_corr(double *vec, int sensor_grpbit, int source_grpbit,
                                              bool invert_source)
 {
@@ -50,6 +50,7 @@ class PPPMElectrodeIntel : public PPPMIntel, public ElectrodeKSpace {
   void compute_vector_corr(double *, int, int, bool) override;
   void compute_matrix(bigint *, double **, bool) override;
   void compute_matrix_corr(bigint *, double **) override;
+  void compute_diagonal_corr(double *, int) override;
 
   void compute_group_group(int, int, int) override;
 
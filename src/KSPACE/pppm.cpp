@@ -37,9 +37,16 @@
 #include "neighbor.h"
 #include "pair.h"
 #include "remap_wrap.h"
+#include "suffix.h"
 
+#include <cfloat>
 #include <cmath>
 #include <cstring>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
@@ -50,6 +57,7 @@ using namespace MathSpecial;
 #define LARGE 10000.0
 #define SMALL 0.00001
 #define EPS_HOC 1.0e-7
+#define SLOWFACTOR 4.0
 
 enum{REVERSE_RHO};
 enum{FORWARD_IK,FORWARD_AD,FORWARD_IK_PERATOM,FORWARD_AD_PERATOM};
@@ -74,7 +82,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   sf_precoeff4(nullptr), sf_precoeff5(nullptr), sf_precoeff6(nullptr),
   acons(nullptr), fft1(nullptr), fft2(nullptr), remap(nullptr), gc(nullptr),
   gc_buf1(nullptr), gc_buf2(nullptr), density_A_brick(nullptr), density_B_brick(nullptr), density_A_fft(nullptr),
-  density_B_fft(nullptr), part2grid(nullptr), boxlo(nullptr)
+  density_B_fft(nullptr), part2grid(nullptr), zsort_thr(nullptr), zstart_thr(nullptr),
+  boxlo(nullptr)
 {
   peratom_allocate_flag = 0;
   group_allocate_flag = 0;
@@ -122,6 +131,11 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
 
   nmax = 0;
   part2grid = nullptr;
+  nmax_thr = nplanes_thr = 0;
+  autotune_active = 0;
+  autotune_maxgrid = 0;
+  autotune_skip = 0;
+  gc_single = 0;
 
   // define acons coefficients for estimation of kspace errors
   // see JCP 109, pg 7698 for derivation of coefficients
@@ -183,6 +197,8 @@ PPPM::~PPPM()
   if (peratom_allocate_flag) PPPM::deallocate_peratom();
   if (group_allocate_flag) PPPM::deallocate_groups();
   memory->destroy(part2grid);
+  memory->destroy(zsort_thr);
+  memory->destroy(zstart_thr);
   memory->destroy(acons);
 }
 
@@ -192,7 +208,7 @@ PPPM::~PPPM()
 
 void PPPM::init()
 {
-  if (me == 0) utils::logmesg(lmp,"PPPM initialization ...\n");
+  if ((me == 0) && !autotune_active) utils::logmesg(lmp,"PPPM initialization ...\n");
 
   // error check
 
@@ -222,6 +238,11 @@ void PPPM::init()
   if (order < 2 || order > MAXORDER)
     error->all(FLERR,"PPPM order cannot be < 2 or > {}",MAXORDER);
 
+#if defined(FFT_SINGLE)
+  if (halo_flag)
+    error->all(FLERR,"Kspace_modify halo single requires a double precision FFT build");
+#endif
+
   // compute two charge force
 
   two_charge();
@@ -300,7 +321,7 @@ void PPPM::init()
   int iteration = 0;
 
   while (order >= minorder) {
-    if (iteration && me == 0)
+    if (iteration && (me == 0) && !autotune_active)
       error->warning(FLERR,"Reducing PPPM order b/c stencil extends "
                      "beyond nearest neighbor processor");
 
@@ -358,7 +379,7 @@ void PPPM::init()
   MPI_Allreduce(&ngrid,&ngrid_max,1,MPI_INT,MPI_MAX,world);
   MPI_Allreduce(&nfft_both,&nfft_both_max,1,MPI_INT,MPI_MAX,world);
 
-  if (me == 0) {
+  if ((me == 0) && !autotune_active) {
     std::string mesg = fmt::format("  G vector (1/distance) = {:.8g}\n",g_ewald);
     mesg += fmt::format("  grid = {} {} {}\n",nx_pppm,ny_pppm,nz_pppm);
     mesg += fmt::format("  stencil order = {}\n",order);
@@ -367,6 +388,7 @@ void PPPM::init()
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    if (halo_flag) mesg += "  using single precision for ghost grid communication\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
@@ -379,6 +401,10 @@ void PPPM::init()
 
 void PPPM::setup()
 {
+  // one-time tuning of order and differentiation as requested by kspace_modify
+
+  if (autotune && !autotune_active) autotune_settings();
+
   if (triclinic) {
     setup_triclinic();
     return;
@@ -554,6 +580,196 @@ void PPPM::setup_triclinic()
   compute_gf_ik_triclinic();
 }
 
+/* ----------------------------------------------------------------------
+   pick the fastest combination of stencil order and differentiation
+   for each candidate, init() selects g_ewald and the smallest grid that
+     meets the requested accuracy with the current Coulomb cutoff, then
+     compute() is timed on the current configuration
+   the default order and differentiation are tried first, candidates that
+     need a larger grid are skipped before the grid is fully sized, and
+     candidates much slower than the fastest one are timed only once
+   the pair cost is the same for all candidates, since the cutoff is kept
+   forces are restored afterwards, because this is called during run setup
+------------------------------------------------------------------------- */
+
+void PPPM::autotune_settings()
+{
+  const int ntune = autotune;
+  autotune = 0;
+
+  if (gridflag) {
+    if (me == 0)
+      error->warning(FLERR,"Ignoring kspace_modify autotune since a PPPM mesh was set");
+    return;
+  }
+  if (suffix_flag != Suffix::NONE) {
+    if (me == 0)
+      error->warning(FLERR,"Kspace_modify autotune is not supported by kspace style {}",
+                     force->kspace_style);
+    return;
+  }
+
+  struct Candidate {
+    int order, diff, nx, ny, nz;
+    double accuracy, time;
+  };
+  std::vector<Candidate> candidates;
+
+  // default settings first, then all others from high to low order
+  // lower orders need larger grids, so once a grid is too large for one
+  //   differentiation, the remaining orders with it are skipped as well
+
+  std::vector<std::pair<int,int>> trials;
+  trials.emplace_back(order,differentiation_flag);
+  const int ndiff = (triclinic || dipoleflag || stagger_flag) ? 1 : 2;
+  for (int idiff = 0; idiff < ndiff; idiff++) {
+    const int diff = (differentiation_flag + idiff) % 2;
+    for (int iorder = MAXORDER; iorder >= MAX(minorder,3); iorder--)
+      if ((iorder != order) || (diff != differentiation_flag)) trials.emplace_back(iorder,diff);
+  }
+  int toolarge[2] = {0, 0};
+
+  int nall = atom->nlocal + atom->nghost;
+  std::vector<double> fsave(3*nall);
+  double **f = atom->f;
+  for (int i = 0; i < nall; i++)
+    for (int k = 0; k < 3; k++) fsave[3*i+k] = f[i][k];
+
+  autotune_active = 1;
+  autotune_maxgrid = 0;
+  int nskip = 0;
+  double tbest = -1.0;
+
+  for (const auto &trial : trials) {
+    if (toolarge[trial.second] && (trial.first < toolarge[trial.second])) {
+      nskip++;
+      continue;
+    }
+
+    order = trial.first;
+    autotune_diff(trial.second);
+    autotune_skip = 0;
+    init();
+
+    // order may have been reduced to keep the stencil on neighbor procs
+
+    bool duplicate = false;
+    for (const auto &c : candidates)
+      if ((c.order == order) && (c.diff == differentiation_flag)) duplicate = true;
+    if (duplicate) continue;
+    if (autotune_skip) {
+      toolarge[differentiation_flag] = order;
+      nskip++;
+      continue;
+    }
+
+    // first candidate sets the largest grid to consider
+
+    if (candidates.empty()) {
+      autotune_maxgrid = (bigint) nx_pppm * ny_pppm * nz_pppm;
+      autotune_grid[0] = nx_pppm;
+      autotune_grid[1] = ny_pppm;
+      autotune_grid[2] = nz_pppm;
+    }
+
+    // the first call is timed as well, to not repeat a call that is far too slow
+
+    setup();
+    MPI_Barrier(world);
+    double time = platform::walltime();
+    compute(0,0);
+    time = platform::walltime() - time;
+    MPI_Allreduce(MPI_IN_PLACE,&time,1,MPI_DOUBLE,MPI_MAX,world);
+
+    if ((tbest < 0.0) || (time < SLOWFACTOR*tbest)) {
+      MPI_Barrier(world);
+      time = platform::walltime();
+      for (int n = 0; n < ntune; n++) compute(0,0);
+      time = (platform::walltime() - time) / MAX(ntune,1);
+      MPI_Allreduce(MPI_IN_PLACE,&time,1,MPI_DOUBLE,MPI_MAX,world);
+    }
+    if ((tbest < 0.0) || (time < tbest)) tbest = time;
+
+    candidates.push_back({order,differentiation_flag,nx_pppm,ny_pppm,nz_pppm,
+                          final_accuracy(),time});
+  }
+
+  int best = 0;
+  for (int i = 1; i < (int) candidates.size(); i++)
+    if (candidates[i].time < candidates[best].time) best = i;
+
+  if (me == 0) {
+    std::string mesg = "PPPM autotune candidates:\n"
+      "  order diff       grid        accuracy    time/call\n";
+    for (int i = 0; i < (int) candidates.size(); i++) {
+      const auto &c = candidates[i];
+      mesg += fmt::format("  {:5} {:>4} {:>4}x{:>4}x{:>4} {:>12.6g} {:>12.6g}{}\n",
+                          c.order,c.diff ? "ad" : "ik",c.nx,c.ny,c.nz,
+                          c.accuracy,c.time,(i == best) ? " *" : "");
+    }
+    if (nskip)
+      mesg += fmt::format("  skipped {} candidates needing a larger grid than {}x{}x{}\n",
+                          nskip,autotune_grid[0],autotune_grid[1],autotune_grid[2]);
+    utils::logmesg(lmp,mesg);
+  }
+
+  // re-initialize with the fastest settings
+
+  order = candidates[best].order;
+  autotune_diff(candidates[best].diff);
+  autotune_active = 0;
+  autotune_maxgrid = 0;
+  init();
+
+  for (int i = 0; i < nall; i++)
+    for (int k = 0; k < 3; k++) f[i][k] = fsave[3*i+k];
+}
+
+/* ----------------------------------------------------------------------
+   switch differentiation while autotuning
+   init() frees only the arrays of the new setting, so free the others here
+------------------------------------------------------------------------- */
+
+void PPPM::autotune_diff(int diff)
+{
+  if (diff == differentiation_flag) return;
+
+  // u_brick is also a per-atom array with ik
+
+  memory->destroy3d_offset(u_brick,nzlo_out,nylo_out,nxlo_out);
+  if (differentiation_flag == 1) {
+    memory->destroy(sf_precoeff1);
+    memory->destroy(sf_precoeff2);
+    memory->destroy(sf_precoeff3);
+    memory->destroy(sf_precoeff4);
+    memory->destroy(sf_precoeff5);
+    memory->destroy(sf_precoeff6);
+  } else {
+    memory->destroy3d_offset(vdx_brick,nzlo_out,nylo_out,nxlo_out);
+    memory->destroy3d_offset(vdy_brick,nzlo_out,nylo_out,nxlo_out);
+    memory->destroy3d_offset(vdz_brick,nzlo_out,nylo_out,nxlo_out);
+  }
+  differentiation_flag = diff;
+}
+
+/* ----------------------------------------------------------------------
+   while autotuning, replace a grid larger than the one of the first
+     candidate by that grid and flag the candidate to be skipped
+   return 1 if the grid was replaced
+------------------------------------------------------------------------- */
+
+int PPPM::autotune_grid_exceeded()
+{
+  if (!autotune_active || !autotune_maxgrid) return 0;
+  if ((bigint) nx_pppm * ny_pppm * nz_pppm <= autotune_maxgrid) return 0;
+
+  nx_pppm = autotune_grid[0];
+  ny_pppm = autotune_grid[1];
+  nz_pppm = autotune_grid[2];
+  autotune_skip = 1;
+  return 1;
+}
+
 /* ----------------------------------------------------------------------
    reset local grid arrays and communication stencils
    called by fix balance b/c it changed sizes of processor sub-domains
@@ -644,8 +860,16 @@ void PPPM::compute(int eflag, int vflag)
   //   to fully sum contribution in their 3d bricks
   // remap from 3d decomposition to FFT decomposition
 
-  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(FFT_SCALAR),
-                   gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+  // with kspace_modify halo single, ghost grid values are sent as
+  //   float and summed into or copied to the FFT_SCALAR bricks
+
+  const int gc_nbyte = halo_flag ? sizeof(float) : sizeof(FFT_SCALAR);
+  const MPI_Datatype gc_datatype = halo_flag ? MPI_FLOAT : MPI_FFT_SCALAR;
+
+  gc_single = halo_flag;
+  gc->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,gc_nbyte,
+                   gc_buf1,gc_buf2,gc_datatype);
+  gc_single = 0;
   brick2fft();
 
   // compute potential gradient on my FFT grid and
@@ -658,12 +882,14 @@ void PPPM::compute(int eflag, int vflag)
   // all procs communicate E-field values
   // to fill ghost cells surrounding their 3d bricks
 
+  gc_single = halo_flag;
   if (differentiation_flag == 1)
-    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,sizeof(FFT_SCALAR),
-                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_AD,1,gc_nbyte,
+                     gc_buf1,gc_buf2,gc_datatype);
   else
-    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK,3,sizeof(FFT_SCALAR),
-                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    gc->forward_comm(Grid3d::KSPACE,this,FORWARD_IK,3,gc_nbyte,
+                     gc_buf1,gc_buf2,gc_datatype);
+  gc_single = 0;
 
   // extra per-atom energy/virial communication
 
@@ -873,8 +1099,10 @@ void PPPM::deallocate()
 
   memory->destroy3d_offset(density_brick,nzlo_out,nylo_out,nxlo_out);
 
+  // u_brick is also a per-atom array with ik
+
+  memory->destroy3d_offset(u_brick,nzlo_out,nylo_out,nxlo_out);
   if (differentiation_flag == 1) {
-    memory->destroy3d_offset(u_brick,nzlo_out,nylo_out,nxlo_out);
     memory->destroy(sf_precoeff1);
     memory->destroy(sf_precoeff2);
     memory->destroy(sf_precoeff3);
@@ -1028,6 +1256,11 @@ void PPPM::set_grid_global()
         if (ny_pppm <= 1) ny_pppm = 2;
         if (nz_pppm <= 1) nz_pppm = 2;
 
+        // stop early for an autotune candidate that needs a larger grid than the default,
+        //   since the error estimate costs as much as a loop over the grid
+
+        if (autotune_grid_exceeded()) break;
+
         // estimate Kspace force error
 
         double df_kspace = compute_df_kspace();
@@ -1086,6 +1319,8 @@ void PPPM::set_grid_global()
       ny_pppm = static_cast<int>(tmp[1]) + 1;
       nz_pppm = static_cast<int>(tmp[2]) + 1;
     }
+
+    autotune_grid_exceeded();
   }
 
   // boost grid size until it is factorable
@@ -1338,8 +1573,16 @@ double PPPM::final_accuracy()
   double q2_over_sqrt = q2 / sqrt(natoms*cutoff*xprd*yprd*zprd);
   double df_rspace = 2.0 * q2_over_sqrt * exp(-g_ewald*g_ewald*cutoff*cutoff);
   double df_table = estimate_table_accuracy(q2_over_sqrt,df_rspace);
+
+  // rounding of ghost grid values to float with kspace_modify halo single
+  // relative error of FLT_EPSILON/2 on a typical kspace force of
+  //   q2/natoms * g_ewald^2, i.e. that of a mean charge pair at 1/g_ewald
+
+  double df_halo = 0.0;
+  if (halo_flag) df_halo = 0.5 * FLT_EPSILON * q2 * g_ewald*g_ewald / natoms;
+
   double estimated_accuracy = sqrt(df_kspace*df_kspace + df_rspace*df_rspace +
-                                   df_table*df_table);
+                                   df_table*df_table + df_halo*df_halo);
 
   return estimated_accuracy;
 }
@@ -1856,6 +2099,13 @@ void PPPM::make_rho()
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
          ngrid*sizeof(FFT_SCALAR));
 
+#if defined(_OPENMP)
+  if (comm->nthreads > 1) {
+    make_rho_thr();
+    return;
+  }
+#endif
+
   // loop over my charges, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
@@ -1892,6 +2142,91 @@ void PPPM::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   threaded version of make_rho()
+   each thread owns a contiguous range of z planes of density_brick and
+     adds only to those, so no per-thread bricks or reduction are needed
+   atoms are bucket sorted by their z grid plane first, so that each thread
+     only visits the atoms whose stencil overlaps its planes
+------------------------------------------------------------------------- */
+
+void PPPM::make_rho_thr()
+{
+  const int nlocal = atom->nlocal;
+  if (nlocal == 0) return;
+
+  // (nz-nzlo_out) is in [-nlower,nplanes-1-nupper] for all local atoms
+
+  const int nplanes = nzhi_out - nzlo_out + 1;
+  if (atom->nmax > nmax_thr) {
+    memory->destroy(zsort_thr);
+    nmax_thr = atom->nmax;
+    memory->create(zsort_thr,nmax_thr,"pppm:zsort_thr");
+  }
+  if (nplanes > nplanes_thr) {
+    memory->destroy(zstart_thr);
+    nplanes_thr = nplanes;
+    memory->create(zstart_thr,nplanes_thr+1,"pppm:zstart_thr");
+  }
+
+  for (int iz = 0; iz <= nplanes; iz++) zstart_thr[iz] = 0;
+  for (int i = 0; i < nlocal; i++) zstart_thr[part2grid[i][2]-nzlo_out+1]++;
+  for (int iz = 0; iz < nplanes; iz++) zstart_thr[iz+1] += zstart_thr[iz];
+  for (int i = 0; i < nlocal; i++) zsort_thr[zstart_thr[part2grid[i][2]-nzlo_out]++] = i;
+  for (int iz = nplanes; iz > 0; iz--) zstart_thr[iz] = zstart_thr[iz-1];
+  zstart_thr[0] = 0;
+
+  const double * const q = atom->q;
+  double * const * const x = atom->x;
+
+#if defined(_OPENMP)
+#pragma omp parallel default(shared)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+    const int nthr = omp_get_num_threads();
+#else
+    const int tid = 0;
+    const int nthr = 1;
+#endif
+
+    // this thread owns planes [pfrom,pto) relative to nzlo_out
+
+    const int pfrom = (int) ((bigint) tid * nplanes / nthr);
+    const int pto = (int) ((bigint) (tid+1) * nplanes / nthr);
+    const int afrom = zstart_thr[MAX(pfrom-nupper,0)];
+    const int ato = zstart_thr[MIN(pto-nlower,nplanes)];
+
+    FFT_SCALAR r1d[3][8];
+
+    for (int ii = afrom; ii < ato; ii++) {
+      const int i = zsort_thr[ii];
+      const int nx = part2grid[i][0];
+      const int ny = part2grid[i][1];
+      const int nz = part2grid[i][2];
+      const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+      const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+      const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+
+      compute_rho1d_local(r1d,dx,dy,dz);
+
+      const FFT_SCALAR z0 = delvolinv * q[i];
+      const int nfrom = MAX(nlower,pfrom+nzlo_out-nz);
+      const int nto = MIN(nupper,pto-1+nzlo_out-nz);
+      for (int n = nfrom; n <= nto; n++) {
+        const FFT_SCALAR y0 = z0*r1d[2][n-nlower];
+        for (int m = nlower; m <= nupper; m++) {
+          const FFT_SCALAR x0 = y0*r1d[1][m-nlower];
+          FFT_SCALAR *d = &density_brick[nz+n][ny+m][nx];
+          for (int l = nlower; l <= nupper; l++)
+            d[l] += x0*r1d[0][l-nlower];
+        }
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    remap density from 3d brick decomposition to FFT decomposition
 ------------------------------------------------------------------------- */
@@ -2360,13 +2695,22 @@ void PPPM::fieldforce_ik()
   // (mx,my,mz) = global coords of moving stencil pt
   // ek = 3 components of E-field on particle
 
+  // atoms are independent, so the loop is threaded when running
+  //   with more than one thread per MPI rank
+  // charge assignment weights are kept in a thread-local r1d
+
   double *q = atom->q;
   double **x = atom->x;
   double **f = atom->f;
 
   int nlocal = atom->nlocal;
 
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(l,m,n,nx,ny,nz,mx,my,mz,dx,dy,dz,x0,y0,z0,ekx,eky,ekz) schedule(static) if (comm->nthreads > 1)
+#endif
   for (i = 0; i < nlocal; i++) {
+    FFT_SCALAR r1d[3][8];
+
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2374,18 +2718,18 @@ void PPPM::fieldforce_ik()
     dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
     dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
 
-    compute_rho1d(dx,dy,dz);
+    compute_rho1d_local(r1d,dx,dy,dz);
 
     ekx = eky = ekz = ZEROF;
     for (n = nlower; n <= nupper; n++) {
       mz = n+nz;
-      z0 = rho1d[2][n];
+      z0 = r1d[2][n-nlower];
       for (m = nlower; m <= nupper; m++) {
         my = m+ny;
-        y0 = z0*rho1d[1][m];
+        y0 = z0*r1d[1][m-nlower];
         for (l = nlower; l <= nupper; l++) {
           mx = l+nx;
-          x0 = y0*rho1d[0][l];
+          x0 = y0*r1d[0][l-nlower];
           ekx -= x0*vdx_brick[mz][my][mx];
           eky -= x0*vdy_brick[mz][my][mx];
           ekz -= x0*vdz_brick[mz][my][mx];
@@ -2560,6 +2904,11 @@ void PPPM::fieldforce_peratom()
 
 void PPPM::pack_forward_grid(int flag, void *vbuf, int nlist, int *list)
 {
+  if (gc_single) {
+    pack_forward_grid_single(flag,(float *) vbuf,nlist,list);
+    return;
+  }
+
   auto buf = (FFT_SCALAR *) vbuf;
 
   int n = 0;
@@ -2620,6 +2969,11 @@ void PPPM::pack_forward_grid(int flag, void *vbuf, int nlist, int *list)
 
 void PPPM::unpack_forward_grid(int flag, void *vbuf, int nlist, int *list)
 {
+  if (gc_single) {
+    unpack_forward_grid_single(flag,(float *) vbuf,nlist,list);
+    return;
+  }
+
   auto buf = (FFT_SCALAR *) vbuf;
 
   int n = 0;
@@ -2680,6 +3034,16 @@ void PPPM::unpack_forward_grid(int flag, void *vbuf, int nlist, int *list)
 
 void PPPM::pack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
 {
+  if (gc_single) {
+    auto buf = (float *) vbuf;
+    if (flag == REVERSE_RHO) {
+      FFT_SCALAR *src = &density_brick[nzlo_out][nylo_out][nxlo_out];
+      for (int i = 0; i < nlist; i++)
+        buf[i] = static_cast<float>(src[list[i]]);
+    }
+    return;
+  }
+
   auto buf = (FFT_SCALAR *) vbuf;
 
   if (flag == REVERSE_RHO) {
@@ -2695,6 +3059,16 @@ void PPPM::pack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
 
 void PPPM::unpack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
 {
+  if (gc_single) {
+    auto buf = (float *) vbuf;
+    if (flag == REVERSE_RHO) {
+      FFT_SCALAR *dest = &density_brick[nzlo_out][nylo_out][nxlo_out];
+      for (int i = 0; i < nlist; i++)
+        dest[list[i]] += buf[i];
+    }
+    return;
+  }
+
   auto buf = (FFT_SCALAR *) vbuf;
 
   if (flag == REVERSE_RHO) {
@@ -2704,6 +3078,55 @@ void PPPM::unpack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
   }
 }
 
+/* ----------------------------------------------------------------------
+   pack own E-field values into a single precision buf
+   only used for the field communication in compute()
+------------------------------------------------------------------------- */
+
+void PPPM::pack_forward_grid_single(int flag, float *buf, int nlist, int *list)
+{
+  int n = 0;
+
+  if (flag == FORWARD_IK) {
+    FFT_SCALAR *xsrc = &vdx_brick[nzlo_out][nylo_out][nxlo_out];
+    FFT_SCALAR *ysrc = &vdy_brick[nzlo_out][nylo_out][nxlo_out];
+    FFT_SCALAR *zsrc = &vdz_brick[nzlo_out][nylo_out][nxlo_out];
+    for (int i = 0; i < nlist; i++) {
+      buf[n++] = static_cast<float>(xsrc[list[i]]);
+      buf[n++] = static_cast<float>(ysrc[list[i]]);
+      buf[n++] = static_cast<float>(zsrc[list[i]]);
+    }
+  } else if (flag == FORWARD_AD) {
+    FFT_SCALAR *src = &u_brick[nzlo_out][nylo_out][nxlo_out];
+    for (int i = 0; i < nlist; i++)
+      buf[i] = static_cast<float>(src[list[i]]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack single precision E-field values from buf and set own ghost values
+------------------------------------------------------------------------- */
+
+void PPPM::unpack_forward_grid_single(int flag, float *buf, int nlist, int *list)
+{
+  int n = 0;
+
+  if (flag == FORWARD_IK) {
+    FFT_SCALAR *xdest = &vdx_brick[nzlo_out][nylo_out][nxlo_out];
+    FFT_SCALAR *ydest = &vdy_brick[nzlo_out][nylo_out][nxlo_out];
+    FFT_SCALAR *zdest = &vdz_brick[nzlo_out][nylo_out][nxlo_out];
+    for (int i = 0; i < nlist; i++) {
+      xdest[list[i]] = buf[n++];
+      ydest[list[i]] = buf[n++];
+      zdest[list[i]] = buf[n++];
+    }
+  } else if (flag == FORWARD_AD) {
+    FFT_SCALAR *dest = &u_brick[nzlo_out][nylo_out][nxlo_out];
+    for (int i = 0; i < nlist; i++)
+      dest[list[i]] = buf[i];
+  }
+}
+
 /* ----------------------------------------------------------------------
    map nprocs to NX by NY grid as PX by PY procs - return optimal px,py
 ------------------------------------------------------------------------- */
@@ -2767,6 +3190,67 @@ void PPPM::compute_rho1d(const FFT_SCALAR &dx, const FFT_SCALAR &dy,
   }
 }
 
+/* ----------------------------------------------------------------------
+   charge assignment weights for a fixed order, so the compiler can fully
+     unroll the polynomial evaluation and vectorize across the stencil
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+static inline void rho1d_order(FFT_SCALAR (*r1d)[8], FFT_SCALAR * const * const rho_coeff,
+                               const FFT_SCALAR dx, const FFT_SCALAR dy, const FFT_SCALAR dz)
+{
+  constexpr int klo = (1-ORDER)/2;
+  FFT_SCALAR r1[ORDER], r2[ORDER], r3[ORDER];
+
+  for (int k = 0; k < ORDER; k++) r1[k] = r2[k] = r3[k] = ZEROF;
+  for (int l = ORDER-1; l >= 0; l--) {
+    const FFT_SCALAR * const c = rho_coeff[l] + klo;
+    for (int k = 0; k < ORDER; k++) {
+      r1[k] = c[k] + r1[k]*dx;
+      r2[k] = c[k] + r2[k]*dy;
+      r3[k] = c[k] + r3[k]*dz;
+    }
+  }
+  for (int k = 0; k < ORDER; k++) {
+    r1d[0][k] = r1[k];
+    r1d[1][k] = r2[k];
+    r1d[2][k] = r3[k];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   thread-safe variant of compute_rho1d()
+   weights are returned in r1d, indexed from 0 instead of from nlower
+------------------------------------------------------------------------- */
+
+void PPPM::compute_rho1d_local(FFT_SCALAR (*r1d)[8], const FFT_SCALAR &dx,
+                               const FFT_SCALAR &dy, const FFT_SCALAR &dz) const
+{
+  switch (order) {
+  case 4: rho1d_order<4>(r1d,rho_coeff,dx,dy,dz); return;
+  case 5: rho1d_order<5>(r1d,rho_coeff,dx,dy,dz); return;
+  case 6: rho1d_order<6>(r1d,rho_coeff,dx,dy,dz); return;
+  case 7: rho1d_order<7>(r1d,rho_coeff,dx,dy,dz); return;
+  default: break;
+  }
+
+  int k,l;
+  FFT_SCALAR r1,r2,r3;
+
+  for (k = (1-order)/2; k <= order/2; k++) {
+    r1 = r2 = r3 = ZEROF;
+
+    for (l = order-1; l >= 0; l--) {
+      r1 = rho_coeff[l][k] + r1*dx;
+      r2 = rho_coeff[l][k] + r2*dy;
+      r3 = rho_coeff[l][k] + r3*dz;
+    }
+    r1d[0][k-nlower] = r1;
+    r1d[1][k-nlower] = r2;
+    r1d[2][k-nlower] = r3;
+  }
+}
+
 /* ----------------------------------------------------------------------
    charge assignment into drho1d
    dx,dy,dz = distance of particle from "lower left" grid point
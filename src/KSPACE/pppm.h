@@ -94,6 +94,21 @@ class PPPM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  int gc_single;    // 1 while ghost grid values are packed as float
+  void pack_forward_grid_single(int, float *, int, int *);
+  void unpack_forward_grid_single(int, float *, int, int *);
+
+  int autotune_active;       // 1 while benchmarking candidate settings
+  bigint autotune_maxgrid;   // grid points of default candidate, 0 if no limit
+  int autotune_grid[3];      // grid of default candidate
+  int autotune_skip;         // 1 if candidate grid exceeds autotune_maxgrid
+  void autotune_settings();
+  int autotune_grid_exceeded();
+  void autotune_diff(int);
+
+  int *zsort_thr, *zstart_thr;    // local atoms sorted by z grid plane for threaded make_rho()
+  int nmax_thr, nplanes_thr;
+
   double *boxlo;
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
@@ -136,6 +151,9 @@ class PPPM : public KSpace {
   virtual void fieldforce_peratom();
   void procs2grid2d(int, int, int, int *, int *);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
+  void compute_rho1d_local(FFT_SCALAR (*)[8], const FFT_SCALAR &, const FFT_SCALAR &,
+                           const FFT_SCALAR &) const;
+  void make_rho_thr();
   void compute_drho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_rho_coeff();
   virtual void slabcorr();
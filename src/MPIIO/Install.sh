@@ -36,9 +36,17 @@ touch ../write_restart.cpp
 # all package files with no dependencies
 
 for file in *.cpp *.h; do
-  test -f ${file} && action $file
+  case ${file} in
+    dump_custom_zbin_mpiio.*) ;;
+    *) test -f ${file} && action $file ;;
+  esac
 done
 
+# files with dependencies
+
+action dump_custom_zbin_mpiio.cpp dump_custom_zbin.cpp
+action dump_custom_zbin_mpiio.h dump_custom_zbin.h
+
 # edit 2 Makefile.package to include/exclude LMP_MPIIO setting
 
 if (test $1 = 1) then
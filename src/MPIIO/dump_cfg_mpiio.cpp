@@ -53,6 +53,7 @@ using namespace LAMMPS_NS;
 DumpCFGMPIIO::DumpCFGMPIIO(LAMMPS *lmp, int narg, char **arg) :
   DumpCFG(lmp, narg, arg)
 {
+  async_allow = 0;
   if (me == 0)
     error->warning(FLERR,"MPI-IO output is unmaintained and unreliable. Use with caution.");
 }
@@ -0,0 +1,282 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#include "dump_custom_zbin_mpiio.h"
+
+#include "atom.h"
+#include "compute.h"
+#include "domain.h"
+#include "error.h"
+#include "input.h"
+#include "memory.h"
+#include "modify.h"
+#include "update.h"
+#include "variable.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace Zbin;
+
+/* ----------------------------------------------------------------------
+   each proc compresses its own atoms as one chunk of the frame
+   chunks are written in parallel at offsets from a prefix sum of their sizes
+------------------------------------------------------------------------- */
+
+DumpCustomZbinMPIIO::DumpCustomZbinMPIIO(LAMMPS *lmp, int narg, char **arg) :
+  DumpCustomZbin(lmp, narg, arg), mpifh_open(0), mpifo(0), filecurrent(nullptr)
+{
+  if (multiproc) error->all(FLERR,"Dump custom/zbin/mpiio does not support dump_modify nfile or fileper");
+
+  async_allow = 0;
+
+  // all procs compress data, not just the file writer
+
+  if (!cctx) {
+    cctx = ZSTD_createCCtx();
+    if (!cctx) error->one(FLERR,"Could not create Zstd context");
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpCustomZbinMPIIO::~DumpCustomZbinMPIIO()
+{
+  if (mpifh_open) close_mpifile();
+}
+
+/* ----------------------------------------------------------------------
+   collectively open a new zbin file and write its file header from proc 0
+------------------------------------------------------------------------- */
+
+void DumpCustomZbinMPIIO::openfile()
+{
+  if (singlefile_opened) return;
+  if (multifile == 0) singlefile_opened = 1;
+  if (append_flag) error->all(FLERR, "Dump custom/zbin/mpiio does not support append");
+
+  // if one file per timestep, replace '*' with current timestep
+
+  filecurrent = filename;
+
+  if (multifile) {
+    filecurrent = utils::strdup(utils::star_subst(filecurrent, update->ntimestep, padflag));
+    if (maxfiles > 0) {
+      if (numfiles < maxfiles) {
+        nameslist[numfiles] = utils::strdup(filecurrent);
+        ++numfiles;
+      } else {
+        if (me == 0) remove(nameslist[fileidx]);
+        delete[] nameslist[fileidx];
+        nameslist[fileidx] = utils::strdup(filecurrent);
+        fileidx = (fileidx + 1) % maxfiles;
+      }
+    }
+  }
+
+  int err = MPI_File_open(world, filecurrent, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          MPI_INFO_NULL, &mpifh);
+  if (err != MPI_SUCCESS) error->one(FLERR, "Cannot open dump file {}", filecurrent);
+  MPI_File_set_size(mpifh, 0);
+  mpifh_open = 1;
+
+  std::vector<char> header;
+  file_header(header);
+  if (me == 0)
+    MPI_File_write_at(mpifh, 0, header.data(), header.size(), MPI_BYTE, MPI_STATUS_IGNORE);
+  mpifo = header.size();
+  frameindex.clear();
+
+  if (multifile) delete[] filecurrent;
+}
+
+/* ----------------------------------------------------------------------
+   same sequence as Dump::write(), but without gathering atoms to proc 0
+------------------------------------------------------------------------- */
+
+void DumpCustomZbinMPIIO::write()
+{
+  imageint *imagehold = nullptr;
+  double **xhold = nullptr, **vhold = nullptr;
+
+  if (domain->triclinic == 0) {
+    boxxlo = domain->boxlo[0];
+    boxxhi = domain->boxhi[0];
+    boxylo = domain->boxlo[1];
+    boxyhi = domain->boxhi[1];
+    boxzlo = domain->boxlo[2];
+    boxzhi = domain->boxhi[2];
+  } else {
+    boxxlo = domain->boxlo_bound[0];
+    boxxhi = domain->boxhi_bound[0];
+    boxylo = domain->boxlo_bound[1];
+    boxyhi = domain->boxhi_bound[1];
+    boxzlo = domain->boxlo_bound[2];
+    boxzhi = domain->boxhi_bound[2];
+    boxxy = domain->xy;
+    boxxz = domain->xz;
+    boxyz = domain->yz;
+  }
+
+  nme = count();
+
+  if (delay_flag && update->ntimestep < delaystep) return;
+
+  if (skipflag) {
+    double value = input->variable->compute_equal(skipindex);
+    if (value != 0.0) return;
+  }
+
+  if (multifile) openfile();
+
+  bigint bnme = nme;
+  MPI_Allreduce(&bnme,&ntotal,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  // buf only needs to hold my own atoms, sort() grows its own buffers
+
+  if (nme*size_one > maxbuf) {
+    if ((bigint) nme * size_one > MAXSMALLINT)
+      error->one(FLERR,"Too much per-proc info for dump");
+    maxbuf = nme * size_one;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"dump:buf");
+  }
+  if (sort_flag && sortcol == 0 && nme > maxids) {
+    maxids = nme;
+    memory->destroy(ids);
+    memory->create(ids,maxids,"dump:ids");
+  }
+
+  if (pbcflag) {
+    int nlocal = atom->nlocal;
+    if (nlocal > maxpbc) pbc_allocate();
+    if (nlocal) {
+      memcpy(&xpbc[0][0],&atom->x[0][0],3*nlocal*sizeof(double));
+      memcpy(&vpbc[0][0],&atom->v[0][0],3*nlocal*sizeof(double));
+      memcpy(imagepbc,atom->image,nlocal*sizeof(imageint));
+    }
+    xhold = atom->x;
+    vhold = atom->v;
+    imagehold = atom->image;
+    atom->x = xpbc;
+    atom->v = vpbc;
+    atom->image = imagepbc;
+
+    if (domain->triclinic) domain->x2lamda(nlocal);
+    domain->pbc();
+    if (domain->triclinic) domain->lamda2x(nlocal);
+  }
+
+  // sorting leaves each proc with a contiguous range of the sorted atoms,
+  // so chunks written in rank order keep the whole frame sorted
+
+  if (sort_flag && (ntotal > 1) && sortcol == 0) pack(ids);
+  else pack(nullptr);
+  if (sort_flag && (ntotal > 1)) sort();
+  if (balance_flag && (ntotal > 1)) balance();
+
+  frame_header(ntotal);
+  write_frame();
+
+  if (pbcflag) {
+    atom->x = xhold;
+    atom->v = vhold;
+    atom->image = imagehold;
+  }
+
+  if (refreshflag) modify->compute[irefresh]->refresh();
+
+  if (multifile) close_mpifile();
+}
+
+/* ----------------------------------------------------------------------
+   compress my atoms into one chunk and write it at my offset in the frame
+   proc 0 writes the frame header and rewrites the frame index after it
+------------------------------------------------------------------------- */
+
+void DumpCustomZbinMPIIO::write_frame()
+{
+  blocks.clear();
+  encode_chunk(nme, buf, blocks);
+
+  bigint nbytes = blocks.size();
+  if (nbytes > MAXSMALLINT) error->one(FLERR,"Too much per-proc info for dump");
+
+  // proc 0 clears the magic of the previous footer before the frame overwrites
+  // its index, as in DumpCustomZbin::write_footer()
+  // chunks of other procs may overwrite the same bytes as this and the index
+  // written by proc 0, so the writes are ordered by sync, barrier, and sync
+
+  if (frameindex.size()) {
+    if (me == 0) {
+      const char nomagic[sizeof(IndexFooter::magic)] = {0};
+      MPI_Offset offset = mpifo + frameindex.size()*sizeof(IndexEntry) + sizeof(IndexFooter);
+      MPI_File_write_at(mpifh, offset - sizeof(nomagic), nomagic, sizeof(nomagic), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+    }
+    MPI_File_sync(mpifh);
+    MPI_Barrier(world);
+    MPI_File_sync(mpifh);
+  }
+
+  bigint prefix;
+  MPI_Scan(&nbytes,&prefix,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  bigint framesize = prefix;
+  MPI_Bcast(&framesize,1,MPI_LMP_BIGINT,nprocs-1,world);
+
+  frame.nchunks = nprocs;
+  frame.nbytes = sizeof(FrameHeader) + framesize;
+
+  // all procs keep the frame index, so they agree on whether a footer exists
+
+  if (me == 0)
+    MPI_File_write_at(mpifh, mpifo, &frame, sizeof(FrameHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+  IndexEntry entry;
+  entry.ntimestep = frame.ntimestep;
+  entry.offset = mpifo;
+  frameindex.push_back(entry);
+
+  MPI_Offset offset = mpifo + sizeof(FrameHeader) + prefix - nbytes;
+  MPI_File_write_at_all(mpifh, offset, blocks.data(), (int) nbytes, MPI_BYTE, MPI_STATUS_IGNORE);
+  mpifo += frame.nbytes;
+
+  // frame index and footer follow the last frame after every frame
+
+  if (me == 0) {
+    IndexFooter footer;
+    footer.nframes = frameindex.size();
+    footer.offset = mpifo;
+    memcpy(footer.magic, INDEX_MAGIC, sizeof(footer.magic));
+
+    offset = mpifo;
+    MPI_File_write_at(mpifh, offset, frameindex.data(), frameindex.size()*sizeof(IndexEntry),
+                      MPI_BYTE, MPI_STATUS_IGNORE);
+    offset += frameindex.size()*sizeof(IndexEntry);
+    MPI_File_write_at(mpifh, offset, &footer, sizeof(IndexFooter), MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+  if (flush_flag) MPI_File_sync(mpifh);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpCustomZbinMPIIO::close_mpifile()
+{
+  frameindex.clear();
+  MPI_File_close(&mpifh);
+  mpifh_open = 0;
+}
+
+#endif
@@ -0,0 +1,51 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef LAMMPS_ZSTD
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(custom/zbin/mpiio,DumpCustomZbinMPIIO);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_CUSTOM_ZBIN_MPIIO_H
+#define LMP_DUMP_CUSTOM_ZBIN_MPIIO_H
+
+#include "dump_custom_zbin.h"
+
+namespace LAMMPS_NS {
+
+class DumpCustomZbinMPIIO : public DumpCustomZbin {
+ public:
+  DumpCustomZbinMPIIO(class LAMMPS *, int, char **);
+  ~DumpCustomZbinMPIIO() override;
+
+ protected:
+  MPI_File mpifh;
+  int mpifh_open;          // 1 if mpifh is open
+  MPI_Offset mpifo;        // file offset where next frame is written, same on all procs
+  char *filecurrent;       // name of file for this round (with * replaced)
+
+  void openfile() override;
+  void write() override;
+
+  void write_frame();
+  void close_mpifile();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
+#endif
@@ -42,6 +42,7 @@ using namespace LAMMPS_NS;
 
 DumpXYZMPIIO::DumpXYZMPIIO(LAMMPS *lmp, int narg, char **arg) :
   DumpXYZ(lmp, narg, arg) {
+  async_allow = 0;
   if (me == 0)
     error->warning(FLERR,"MPI-IO output is unmaintained and unreliable. Use with caution.");
 }
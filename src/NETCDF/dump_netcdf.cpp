@@ -81,6 +81,8 @@ static constexpr int THIS_IS_A_VARIABLE = -3;
 DumpNetCDF::DumpNetCDF(LAMMPS *lmp, int narg, char **arg) :
   DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+
   // arrays for data rearrangement
 
   sort_flag = 1;
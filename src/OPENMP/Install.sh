@@ -47,6 +47,10 @@ action thr_omp.h
 action thr_omp.cpp
 action thr_data.h
 action thr_data.cpp
+action thr_color.h
+action thr_color.cpp
+action verlet_task.h
+action verlet_task.cpp
 
 # step 2: handle cases and tasks not handled in step 1
 
@@ -26,6 +26,7 @@
 
 
 #include "suffix.h"
+#include "thr_color.h"
 using namespace LAMMPS_NS;
 
 #define SMALL 0.001
@@ -36,6 +37,7 @@ AngleHarmonicOMP::AngleHarmonicOMP(class LAMMPS *lmp)
   : AngleHarmonic(lmp), ThrOMP(lmp,THR_ANGLE)
 {
   suffix_flag |= Suffix::OMP;
+  color_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -47,6 +49,7 @@ void AngleHarmonicOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = neighbor->nanglelist;
+  const bool colored = color_setup_thr(inum, inum ? neighbor->anglelist[0] : nullptr, 4, 3, 0.0);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -59,27 +62,46 @@ void AngleHarmonicOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, cvatom, thr);
 
-    if (inum > 0) {
-      if (evflag) {
-        if (eflag) {
-          if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
-          else eval<1,1,0>(ifrom, ito, thr);
-        } else {
-          if (force->newton_bond) eval<1,0,1>(ifrom, ito, thr);
-          else eval<1,0,0>(ifrom, ito, thr);
-        }
-      } else {
-        if (force->newton_bond) eval<0,0,1>(ifrom, ito, thr);
-        else eval<0,0,0>(ifrom, ito, thr);
+    // with coloring, threads share blocks of one color at a time
+
+    if (colored) {
+      const auto anglelist = (int4_t *) color->items;
+      for (int c = 0; c < color->ncolor; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+        for (int b = color->cfirst[c]; b < color->cfirst[c+1]; ++b)
+          eval_thr(color->bfirst[b], color->bfirst[b+1], anglelist, eflag, thr);
       }
-    }
+    } else if (inum > 0) eval_thr(ifrom, ito, (int4_t *) neighbor->anglelist[0], eflag, thr);
+
     thr->timer(Timer::BOND);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
 
+/* ---------------------------------------------------------------------- */
+
+void AngleHarmonicOMP::eval_thr(int nfrom, int nto, const int4_t *anglelist, int eflag,
+                                ThrData * const thr)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_bond) eval<1,1,1>(nfrom, nto, anglelist, thr);
+      else eval<1,1,0>(nfrom, nto, anglelist, thr);
+    } else {
+      if (force->newton_bond) eval<1,0,1>(nfrom, nto, anglelist, thr);
+      else eval<1,0,0>(nfrom, nto, anglelist, thr);
+    }
+  } else {
+    if (force->newton_bond) eval<0,0,1>(nfrom, nto, anglelist, thr);
+    else eval<0,0,0>(nfrom, nto, anglelist, thr);
+  }
+}
+
 template <int EVFLAG, int EFLAG, int NEWTON_BOND>
-void AngleHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
+void AngleHarmonicOMP::eval(int nfrom, int nto, const int4_t * _noalias const anglelist,
+                            ThrData * const thr)
 {
   int i1,i2,i3,n,type;
   double delx1,dely1,delz1,delx2,dely2,delz2;
@@ -89,7 +111,6 @@ void AngleHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
 
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
-  const int4_t * _noalias const anglelist = (int4_t *) neighbor->anglelist[0];
   const int nlocal = atom->nlocal;
   eangle = 0.0;
 
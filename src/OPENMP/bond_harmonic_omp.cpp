@@ -27,6 +27,7 @@
 #include <cmath>
 
 #include "suffix.h"
+#include "thr_color.h"
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
@@ -35,6 +36,7 @@ BondHarmonicOMP::BondHarmonicOMP(class LAMMPS *lmp)
   : BondHarmonic(lmp), ThrOMP(lmp,THR_BOND)
 {
   suffix_flag |= Suffix::OMP;
+  color_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -46,6 +48,7 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = neighbor->nbondlist;
+  const bool colored = color_setup_thr(inum, inum ? neighbor->bondlist[0] : nullptr, 3, 2, 0.0);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -58,27 +61,46 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (inum > 0) {
-      if (evflag) {
-        if (eflag) {
-          if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
-          else eval<1,1,0>(ifrom, ito, thr);
-        } else {
-          if (force->newton_bond) eval<1,0,1>(ifrom, ito, thr);
-          else eval<1,0,0>(ifrom, ito, thr);
-        }
-      } else {
-        if (force->newton_bond) eval<0,0,1>(ifrom, ito, thr);
-        else eval<0,0,0>(ifrom, ito, thr);
+    // with coloring, threads share blocks of one color at a time
+
+    if (colored) {
+      const auto bondlist = (int3_t *) color->items;
+      for (int c = 0; c < color->ncolor; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+        for (int b = color->cfirst[c]; b < color->cfirst[c+1]; ++b)
+          eval_thr(color->bfirst[b], color->bfirst[b+1], bondlist, eflag, thr);
       }
-    }
+    } else if (inum > 0) eval_thr(ifrom, ito, (int3_t *) neighbor->bondlist[0], eflag, thr);
+
     thr->timer(Timer::BOND);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
 
+/* ---------------------------------------------------------------------- */
+
+void BondHarmonicOMP::eval_thr(int nfrom, int nto, const int3_t *bondlist, int eflag,
+                               ThrData * const thr)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_bond) eval<1,1,1>(nfrom, nto, bondlist, thr);
+      else eval<1,1,0>(nfrom, nto, bondlist, thr);
+    } else {
+      if (force->newton_bond) eval<1,0,1>(nfrom, nto, bondlist, thr);
+      else eval<1,0,0>(nfrom, nto, bondlist, thr);
+    }
+  } else {
+    if (force->newton_bond) eval<0,0,1>(nfrom, nto, bondlist, thr);
+    else eval<0,0,0>(nfrom, nto, bondlist, thr);
+  }
+}
+
 template <int EVFLAG, int EFLAG, int NEWTON_BOND>
-void BondHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
+void BondHarmonicOMP::eval(int nfrom, int nto, const int3_t * _noalias const bondlist,
+                           ThrData * const thr)
 {
   int i1,i2,n,type;
   double delx,dely,delz,ebond,fbond;
@@ -86,7 +108,6 @@ void BondHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
 
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
-  const int3_t * _noalias const bondlist = (int3_t *) neighbor->bondlist[0];
   const int nlocal = atom->nlocal;
   ebond = 0.0;
 
@@ -36,8 +36,9 @@ class BondHarmonicOMP : public BondHarmonic, public ThrOMP {
   void compute(int, int) override;
 
  private:
+  void eval_thr(int ifrom, int ito, const int3_t *bondlist, int eflag, ThrData *const thr);
   template <int EVFLAG, int EFLAG, int NEWTON_BOND>
-  void eval(int ifrom, int ito, ThrData *const thr);
+  void eval(int ifrom, int ito, const int3_t *bondlist, ThrData *const thr);
 };
 
 }    // namespace LAMMPS_NS
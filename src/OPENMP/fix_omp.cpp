@@ -21,6 +21,7 @@
 #include "thr_data.h"
 
 #include "atom.h"
+#include "atom_vec.h"
 #include "comm.h"
 #include "error.h"
 #include "force.h"
@@ -34,16 +35,22 @@
 #include "dihedral_hybrid.h"
 #include "improper_hybrid.h"
 #include "kspace.h"
+#include "memory.h"
 
 #include <cstring>
+#include <vector>
 
 #include "omp_compat.h"
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
 
+#if defined(__linux__) && defined(_OPENMP)
+#include <sched.h>
+#endif
 
 #include "suffix.h"
+#include "thr_omp.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -62,8 +69,8 @@ static int get_tid()
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
-     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
-     _pair_compute_flag(false), _kspace_compute_flag(false)
+     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true), _color(false),
+     _color_active(false), _numa(false), _pair_compute_flag(false), _kspace_compute_flag(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
 
@@ -100,9 +107,21 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
       _neighbor = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"color") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      _color = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"numa") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      _numa = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
+  if (_numa && !Memory::numa_support())
+    error->all(FLERR,"Package omp numa yes requires an OpenMP enabled Linux build");
+  memory->numa_flag = _numa ? 1 : 0;
+
   // print summary of settings
 
   if (comm->me == 0) {
@@ -112,6 +131,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     if (reset_thr)
       utils::logmesg(lmp, "set {} OpenMP thread(s) per MPI task\n", nthreads);
     utils::logmesg(lmp, "using {} neighbor list subroutines\n", nmode);
+    if (_color) utils::logmesg(lmp, "using spatial coloring for supported /omp force styles\n");
+    if (_numa) utils::logmesg(lmp, "using NUMA first-touch placement of large arrays\n");
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
                          "using 1 thread only.");
@@ -121,9 +142,11 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   // allocate list for per thread accumulator manager class instances
   // and then have each thread create an instance of this class to
   // encourage the OS to use storage that is "close" to each thread's CPU.
+  // with NUMA placement, threads are pinned first, so they stay there.
 
   thr = new ThrData *[nthreads];
   _nthr = nthreads;
+  if (_numa) pin_threads();
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(lmp)
 #endif
@@ -138,6 +161,7 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
 
 FixOMP::~FixOMP()
 {
+  memory->numa_flag = 0;
   for (int i=0; i < _nthr; ++i)
     delete thr[i];
 
@@ -176,6 +200,7 @@ void FixOMP::init()
 
     thr = new ThrData *[nthreads];
     _nthr = nthreads;
+    if (_numa) pin_threads();
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE
 #endif
@@ -276,6 +301,44 @@ void FixOMP::init()
 #undef CheckHybridForOMP
   neighbor->set_omp_neighbor(_neighbor ? 1 : 0);
 
+  // coloring replaces the per-thread force arrays and their reduction,
+  // so it can only be used if all /omp force styles support it
+
+  _color_active = false;
+  if (_color && (nthreads > 1)) {
+    std::string nocolor;
+    if (!color_support(force->pair)) nocolor = fmt::format("pair style {}", force->pair_style);
+    if (force->pair && utils::strmatch(force->pair_style,"^hybrid")) {
+      auto hybrid = dynamic_cast<PairHybrid *>(force->pair);
+      for (int i = 0; i < hybrid->nstyles; i++)
+        if (!color_support(hybrid->styles[i]))
+          nocolor = fmt::format("pair style {}", hybrid->keywords[i]);
+    }
+    if (!color_support(force->bond)) nocolor = fmt::format("bond style {}", force->bond_style);
+    if (!color_support(force->angle)) nocolor = fmt::format("angle style {}", force->angle_style);
+    if (!color_support(force->dihedral))
+      nocolor = fmt::format("dihedral style {}", force->dihedral_style);
+    if (!color_support(force->improper))
+      nocolor = fmt::format("improper style {}", force->improper_style);
+    if (!color_support(force->kspace))
+      nocolor = fmt::format("kspace style {}", force->kspace_style);
+    if (utils::strmatch(update->integrate_style,"^respa")) nocolor = "r-RESPA";
+
+    if (nocolor.empty()) _color_active = true;
+    else if (comm->me == 0)
+      error->warning(FLERR,"OpenMP spatial coloring not supported by {}, "
+                     "using per-thread force arrays", nocolor);
+  }
+
+  // with coloring all threads share the first segment of f and the other
+  // per-thread atom arrays, so reallocate them whenever the mode changes
+
+  const int shared = _color_active ? 1 : 0;
+  if (atom->shared_force != shared) {
+    atom->shared_force = shared;
+    if (atom->nmax > 0) atom->avec->grow(atom->nmax);
+  }
+
   // diagnostic output
   if (comm->me == 0) {
     if (last_omp_style) {
@@ -288,6 +351,72 @@ void FixOMP::init()
   }
 }
 
+/* ----------------------------------------------------------------------
+   pin each thread to one CPU of the CPU set the process was started with
+   thread i of N gets CPU i*Ncpu/N, so threads with neighboring static
+   loop partitions, and thus neighboring pages of first-touched arrays,
+   are placed on neighboring CPUs, usually on the same NUMA node
+   an explicit binding through the OpenMP runtime (OMP_PROC_BIND) is kept
+------------------------------------------------------------------------- */
+
+void FixOMP::pin_threads()
+{
+#if defined(__linux__) && defined(_OPENMP)
+  if (omp_get_proc_bind() != omp_proc_bind_false) {
+    if (comm->me == 0) utils::logmesg(lmp, "using OpenMP runtime thread binding\n");
+    return;
+  }
+
+  // remember the initial CPU set, since the main thread is pinned as well
+
+  static cpu_set_t procset;
+  static bool have_procset = false;
+  if (!have_procset) {
+    if (sched_getaffinity(0, sizeof(procset), &procset) != 0) {
+      error->warning(FLERR,"Could not get CPU affinity, OpenMP threads are not pinned");
+      return;
+    }
+    have_procset = true;
+  }
+
+  std::vector<int> cpus;
+  for (int i = 0; i < CPU_SETSIZE; i++)
+    if (CPU_ISSET(i, &procset)) cpus.push_back(i);
+  const int ncpus = cpus.size();
+  if ((ncpus < _nthr) && (comm->me == 0))
+    error->warning(FLERR,"More OpenMP threads ({}) than available CPUs ({})", _nthr, ncpus);
+
+  int nfail = 0;
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(cpus,nfail)
+  {
+    const int tid = get_tid();
+    const int nthreads = omp_get_num_threads();
+    cpu_set_t myset;
+    CPU_ZERO(&myset);
+    CPU_SET(cpus[(bigint) tid * cpus.size() / nthreads], &myset);
+    if (sched_setaffinity(0, sizeof(myset), &myset) != 0) {
+#pragma omp atomic
+      ++nfail;
+    }
+  }
+
+  if (nfail) error->warning(FLERR,"Could not pin {} OpenMP thread(s)", nfail);
+  else if (comm->me == 0)
+    utils::logmesg(lmp, "pinned {} OpenMP thread(s) to {} CPU(s)\n", _nthr, ncpus);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   return false if style is an /omp style without support for coloring
+------------------------------------------------------------------------- */
+
+template <class T> bool FixOMP::color_support(T *style)
+{
+  if (!style || !(style->suffix_flag & Suffix::OMP)) return true;
+  auto thrstyle = dynamic_cast<ThrOMP *>(style);
+  return thrstyle && thrstyle->get_color_flag();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixOMP::setup(int)
@@ -316,7 +445,7 @@ void FixOMP::pre_force(int)
   {
     const int tid = get_tid();
     thr[tid]->check_tid(tid);
-    thr[tid]->init_force(nall,f,torque,erforce,desph,drho);
+    thr[tid]->init_force(nall,f,torque,erforce,desph,drho,_color_active);
   } // end of omp parallel region
 
   _reduced = false;
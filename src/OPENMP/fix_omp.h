@@ -55,6 +55,8 @@ class FixOMP : public Fix {
                              // to call virial_fdot_compute()
   // signal that an /omp style did the force reduction. needed by respa/omp
   void did_reduce() { _reduced = true; }
+  template <class T> bool color_support(T *);
+  void pin_threads();
 
  public:
   ThrData *get_thr(int tid) { return thr[tid]; }
@@ -63,12 +65,16 @@ class FixOMP : public Fix {
   bool get_neighbor() const { return _neighbor; }
   bool get_mixed() const { return _mixed; }
   bool get_reduced() const { return _reduced; }
+  bool get_color() const { return _color_active; }
 
  private:
   int _nthr;                    // number of currently active ThrData objects
   bool _neighbor;               // en/disable threads for neighbor list construction
   bool _mixed;                  // whether to prefer mixed precision compute kernels
   bool _reduced;                // whether forces have been reduced for this step
+  bool _color;                  // whether spatial coloring was requested
+  bool _color_active;           // whether all /omp force styles compute by color
+  bool _numa;                   // whether to use NUMA first-touch and thread pinning
   bool _pair_compute_flag;      // whether pair_compute is called
   bool _kspace_compute_flag;    // whether kspace_compute is called
 };
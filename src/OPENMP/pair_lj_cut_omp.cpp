@@ -19,7 +19,9 @@
 #include "comm.h"
 #include "force.h"
 #include "neigh_list.h"
+#include "neighbor.h"
 #include "suffix.h"
+#include "thr_color.h"
 
 #include "omp_compat.h"
 using namespace LAMMPS_NS;
@@ -32,6 +34,7 @@ PairLJCutOMP::PairLJCutOMP(LAMMPS *lmp) :
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
   cut_respa = nullptr;
+  color_flag = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -43,6 +46,7 @@ void PairLJCutOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  const bool colored = color_setup_thr(inum, list->ilist, 1, 1, neighbor->cutneighmax);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -55,31 +59,50 @@ void PairLJCutOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
-      } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+    // with coloring, threads share blocks of one color at a time
+
+    if (colored) {
+      for (int c = 0; c < color->ncolor; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+        for (int b = color->cfirst[c]; b < color->cfirst[c+1]; ++b)
+          eval_thr(color->bfirst[b], color->bfirst[b+1], color->items, eflag, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
-    }
+    } else eval_thr(ifrom, ito, list->ilist, eflag, thr);
+
     thr->timer(Timer::PAIR);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
 
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutOMP::eval_thr(int iifrom, int iito, const int *ilist, int eflag,
+                            ThrData * const thr)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) eval<1,1,1>(iifrom, iito, ilist, thr);
+      else eval<1,1,0>(iifrom, iito, ilist, thr);
+    } else {
+      if (force->newton_pair) eval<1,0,1>(iifrom, iito, ilist, thr);
+      else eval<1,0,0>(iifrom, iito, ilist, thr);
+    }
+  } else {
+    if (force->newton_pair) eval<0,0,1>(iifrom, iito, ilist, thr);
+    else eval<0,0,0>(iifrom, iito, ilist, thr);
+  }
+}
+
 template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
-void PairLJCutOMP::eval(int iifrom, int iito, ThrData * const thr)
+void PairLJCutOMP::eval(int iifrom, int iito, const int * _noalias const ilist,
+                        ThrData * const thr)
 {
   const auto * _noalias const x = (dbl3_t *) atom->x[0];
   auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
   const int * _noalias const type = atom->type;
   const double * _noalias const special_lj = force->special_lj;
-  const int * _noalias const ilist = list->ilist;
   const int * _noalias const numneigh = list->numneigh;
   const int * const * const firstneigh = list->firstneigh;
 
@@ -38,8 +38,9 @@ class PairLJCutOMP : public PairLJCut, public ThrOMP {
   double memory_usage() override;
 
  private:
+  void eval_thr(int ifrom, int ito, const int *ilist, int eflag, ThrData *const thr);
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
-  void eval(int ifrom, int ito, ThrData *const thr);
+  void eval(int ifrom, int ito, const int *ilist, ThrData *const thr);
 };
 
 }    // namespace LAMMPS_NS
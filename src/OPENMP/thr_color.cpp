@@ -0,0 +1,169 @@
+/* -------------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "thr_color.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "memory.h"
+#include "neighbor.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+static constexpr double BIG = 1.0e20;
+
+/* ---------------------------------------------------------------------- */
+
+ThrColor::ThrColor(LAMMPS *lmp) :
+    Pointers(lmp), ncolor(0), cfirst(nullptr), bfirst(nullptr), items(nullptr), lastbuild(-1),
+    nitem(-1), maxitem(0), maxint(0), nblock(0), maxblock(0), iblock(nullptr), bcount(nullptr)
+{
+  memory->create(cfirst, NCOLOR + 1, "thr_color:cfirst");
+}
+
+/* ---------------------------------------------------------------------- */
+
+ThrColor::~ThrColor()
+{
+  memory->destroy(cfirst);
+  memory->destroy(bfirst);
+  memory->destroy(items);
+  memory->destroy(iblock);
+  memory->destroy(bcount);
+}
+
+/* ----------------------------------------------------------------------
+   build schedule for N items of stride ints each, starting with natom atom indices
+   cut = largest distance between atoms updated by one item,
+     if natom > 1 the largest distance within the current items is also used
+   schedule is kept until the next neighbor list build
+------------------------------------------------------------------------- */
+
+void ThrColor::setup(int n, const int *list, int stride, int natom, double cut)
+{
+  if ((lastbuild == neighbor->ncalls) && (nitem == n)) return;
+  lastbuild = neighbor->ncalls;
+  nitem = n;
+
+  if (n > maxitem) {
+    maxitem = n;
+    memory->destroy(iblock);
+    memory->create(iblock, maxitem, "thr_color:iblock");
+  }
+  if (n * stride > maxint) {
+    maxint = n * stride;
+    memory->destroy(items);
+    memory->create(items, maxint, "thr_color:items");
+  }
+
+  // bounding box of first atom of all items
+
+  double **x = atom->x;
+  const int dimension = domain->dimension;
+  double lo[3] = {BIG, BIG, BIG};
+  double hi[3] = {-BIG, -BIG, -BIG};
+  double maxdistsq = 0.0;
+
+  for (int k = 0; k < n; k++) {
+    const int *item = list + k * stride;
+    const double *xa = x[item[0]];
+    for (int d = 0; d < 3; d++) {
+      lo[d] = MIN(lo[d], xa[d]);
+      hi[d] = MAX(hi[d], xa[d]);
+    }
+    for (int m = 1; m < natom; m++) {
+      const double *xb = x[item[m]];
+      const double delx = xa[0] - xb[0];
+      const double dely = xa[1] - xb[1];
+      const double delz = xa[2] - xb[2];
+      maxdistsq = MAX(maxdistsq, delx * delx + dely * dely + delz * delz);
+    }
+  }
+  cut = MAX(cut, sqrt(maxdistsq));
+
+  // blocks per dimension, each at least cut wide
+  // limit # of blocks to # of items, so sparse systems do not use many empty blocks
+
+  int nb[3] = {1, 1, 1};
+  double binv[3] = {0.0, 0.0, 0.0};
+  for (int d = 0; d < dimension; d++)
+    if ((n > 0) && (cut > 0.0)) nb[d] = MAX(1, static_cast<int>((hi[d] - lo[d]) / cut));
+  while ((double) nb[0] * nb[1] * nb[2] > MAX(n, 1)) {
+    int dmax = 0;
+    if (nb[1] > nb[dmax]) dmax = 1;
+    if (nb[2] > nb[dmax]) dmax = 2;
+    nb[dmax] = MAX(1, nb[dmax] / 2);
+  }
+  for (int d = 0; d < dimension; d++)
+    if (hi[d] > lo[d]) binv[d] = nb[d] / (hi[d] - lo[d]);
+
+  nblock = nb[0] * nb[1] * nb[2];
+  if (nblock >= maxblock) {
+    maxblock = nblock + 1;
+    memory->destroy(bfirst);
+    memory->destroy(bcount);
+    memory->create(bfirst, maxblock, "thr_color:bfirst");
+    memory->create(bcount, maxblock, "thr_color:bcount");
+  }
+  memset(bcount, 0, nblock * sizeof(int));
+
+  for (int k = 0; k < n; k++) {
+    const double *xa = x[list[k * stride]];
+    int b[3];
+    for (int d = 0; d < 3; d++)
+      b[d] = MIN(static_cast<int>((xa[d] - lo[d]) * binv[d]), nb[d] - 1);
+    iblock[k] = (b[2] * nb[1] + b[1]) * nb[0] + b[0];
+    bcount[iblock[k]]++;
+  }
+
+  // order non-empty blocks by color, block indices of the same color differ
+  //   by a multiple of 3 in each dimension
+  // bcount becomes the position of the next item of each block
+
+  int nfilled = 0, pos = 0;
+  ncolor = 0;
+  cfirst[0] = 0;
+  for (int cz = 0; cz < 3; cz++)
+    for (int cy = 0; cy < 3; cy++)
+      for (int cx = 0; cx < 3; cx++) {
+        for (int bz = cz; bz < nb[2]; bz += 3)
+          for (int by = cy; by < nb[1]; by += 3)
+            for (int bx = cx; bx < nb[0]; bx += 3) {
+              const int ib = (bz * nb[1] + by) * nb[0] + bx;
+              if (bcount[ib] == 0) continue;
+              bfirst[nfilled++] = pos;
+              const int count = bcount[ib];
+              bcount[ib] = pos;
+              pos += count;
+            }
+        if (nfilled > cfirst[ncolor]) cfirst[++ncolor] = nfilled;
+      }
+  bfirst[nfilled] = pos;
+
+  // stable reordering of items, so items of a block keep their order
+
+  for (int k = 0; k < n; k++)
+    memcpy(items + bcount[iblock[k]]++ * stride, list + k * stride, stride * sizeof(int));
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ThrColor::memory_usage()
+{
+  double bytes = (double) (maxitem + maxint) * sizeof(int);
+  bytes += (double) maxblock * sizeof(int) * 2;
+  return bytes;
+}
@@ -0,0 +1,55 @@
+/* -*- c++ -*- -------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+
+#ifndef LMP_THR_COLOR_H
+#define LMP_THR_COLOR_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+// schedule for force computation without per-thread force arrays
+// items (neighbor list entries, bonds, angles) are binned by the position
+// of their first atom into blocks which are at least as wide as the largest
+// distance between the atoms an item writes to.  blocks are colored so that
+// blocks of the same color are at least two block widths apart, so threads
+// working on different blocks of the same color never update the same atom.
+class ThrColor : protected Pointers {
+ public:
+  ThrColor(class LAMMPS *);
+  ~ThrColor() override;
+
+  // rebuild schedule, if items changed since the last call
+  void setup(int, const int *, int, int, double);
+
+  int ncolor;    // # of colors with at least one block
+  int *cfirst;   // first block of each color, ncolor+1 values
+  int *bfirst;   // first item of each block, nblock+1 values
+  int *items;    // copy of items, reordered by block
+
+  double memory_usage();
+
+ private:
+  bigint lastbuild;    // neighbor list build the schedule is for
+  int nitem, maxitem, maxint;
+  int nblock, maxblock;
+  int *iblock;         // block of each item
+  int *bcount;         // # of items per block, then insertion point
+
+  static constexpr int NCOLOR = 27;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
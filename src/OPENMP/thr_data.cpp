@@ -69,8 +69,13 @@ double ThrData::get_time(enum Timer::ttype flag)
 /* ---------------------------------------------------------------------- */
 
 void ThrData::init_force(int nall, double **f, double **torque, double *erforce, double *de,
-                         double *drho)
+                         double *drho, bool shared)
 {
+  // with shared arrays all threads use the first segment, which thread 0 clears
+
+  const int offset = shared ? 0 : _tid * nall;
+  const bool clear = !shared || (_tid == 0);
+
   eng_vdwl = eng_coul = eng_bond = eng_angle = eng_dihed = eng_imprp = eng_kspce = 0.0;
   memset(virial_pair, 0, 6 * sizeof(double));
   memset(virial_bond, 0, 6 * sizeof(double));
@@ -83,32 +88,32 @@ void ThrData::init_force(int nall, double **f, double **torque, double *erforce,
   vatom_pair = vatom_bond = vatom_angle = vatom_dihed = vatom_imprp = vatom_kspce = nullptr;
 
   if (nall >= 0 && f) {
-    _f = f + _tid * nall;
-    memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
+    _f = f + offset;
+    if (clear) memset(&(_f[0][0]), 0, nall * 3 * sizeof(double));
   } else
     _f = nullptr;
 
   if (nall >= 0 && torque) {
-    _torque = torque + _tid * nall;
-    memset(&(_torque[0][0]), 0, nall * 3 * sizeof(double));
+    _torque = torque + offset;
+    if (clear) memset(&(_torque[0][0]), 0, nall * 3 * sizeof(double));
   } else
     _torque = nullptr;
 
   if (nall >= 0 && erforce) {
-    _erforce = erforce + _tid * nall;
-    memset(&(_erforce[0]), 0, nall * sizeof(double));
+    _erforce = erforce + offset;
+    if (clear) memset(&(_erforce[0]), 0, nall * sizeof(double));
   } else
     _erforce = nullptr;
 
   if (nall >= 0 && de) {
-    _de = de + _tid * nall;
-    memset(&(_de[0]), 0, nall * sizeof(double));
+    _de = de + offset;
+    if (clear) memset(&(_de[0]), 0, nall * sizeof(double));
   } else
     _de = nullptr;
 
   if (nall >= 0 && drho) {
-    _drho = drho + _tid * nall;
-    memset(&(_drho[0]), 0, nall * sizeof(double));
+    _drho = drho + offset;
+    if (clear) memset(&(_drho[0]), 0, nall * sizeof(double));
   } else
     _drho = nullptr;
 }
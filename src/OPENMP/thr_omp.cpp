@@ -31,6 +31,7 @@
 #include "modify.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "thr_color.h"
 
 #include <cstring>
 
@@ -39,13 +40,36 @@ using MathConst::THIRD;
 
 /* ---------------------------------------------------------------------- */
 
-ThrOMP::ThrOMP(LAMMPS *ptr, int style) : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0)
+ThrOMP::ThrOMP(LAMMPS *ptr, int style) :
+    lmp(ptr), fix(nullptr), thr_style(style), thr_error(0), color_flag(0), color(nullptr)
 {
   // register fix omp with this class
   fix = static_cast<FixOMP *>(lmp->modify->get_fix_by_id("package_omp"));
   if (!fix) lmp->error->all(FLERR, "The 'package omp' command is required for /omp styles");
 }
 
+/* ---------------------------------------------------------------------- */
+
+ThrOMP::~ThrOMP()
+{
+  delete color;
+}
+
+/* ----------------------------------------------------------------------
+   update coloring schedule for N items of stride ints with natom atoms each
+   must be called outside of a parallel region
+   return true if forces are to be computed by color without per-thread arrays
+------------------------------------------------------------------------- */
+
+bool ThrOMP::color_setup_thr(int n, const int *items, int stride, int natom, double cut)
+{
+  if (!fix->get_color()) return false;
+
+  if (!color) color = new ThrColor(lmp);
+  color->setup(n, items, stride, natom, cut);
+  return true;
+}
+
 // clang-format off
 /* ----------------------------------------------------------------------
    Hook up per thread per atom arrays into the tally infrastructure
@@ -171,9 +195,13 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
   const int evflag = eflag | vflag;
 
   const int tid = thr->get_tid();
-  double **f = lmp->atom->f;
   double **x = lmp->atom->x;
 
+  // reduce into the force array the per-thread arrays were set up from,
+  // run style verlet/task points atom->f elsewhere while kspace runs concurrently
+
+  double **f = fix->get_thr(0)->get_f();
+
   int need_force_reduce = 1;
 
   if (evflag)
@@ -186,16 +214,19 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
     if (lmp->force->pair->vflag_fdotr) {
 
       // this is a non-hybrid pair style. compute per thread fdotr
+      // with coloring all threads share one force array, so only one computes fdotr
       if (fix->last_pair_hybrid == nullptr) {
-        if (lmp->neighbor->includegroup == 0)
-          thr->virial_fdotr_compute(x, nlocal, nghost, -1);
-        else
-          thr->virial_fdotr_compute(x, nlocal, nghost, nfirst);
+        if (!fix->get_color() || (tid == 0)) {
+          if (lmp->neighbor->includegroup == 0)
+            thr->virial_fdotr_compute(x, nlocal, nghost, -1);
+          else
+            thr->virial_fdotr_compute(x, nlocal, nghost, nfirst);
+        }
       } else {
         if (style == fix->last_pair_hybrid) {
           // pair_style hybrid will compute fdotr for us
           // but we first need to reduce the forces
-          data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+          if (!fix->get_color()) data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
           fix->did_reduce();
           need_force_reduce = 0;
         }
@@ -435,14 +466,20 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
     break;
   }
 
+  // with coloring all threads update the same force arrays, nothing to reduce
+
   if (style == fix->last_omp_style) {
-    if (need_force_reduce) {
-      data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+    if (fix->get_color()) {
       fix->did_reduce();
-    }
+    } else {
+      if (need_force_reduce) {
+        data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+        fix->did_reduce();
+      }
 
-    if (lmp->atom->torque)
-      data_reduce_thr(&(lmp->atom->torque[0][0]), nall, nthreads, 3, tid);
+      if (lmp->atom->torque)
+        data_reduce_thr(&(lmp->atom->torque[0][0]), nall, nthreads, 3, tid);
+    }
   }
   thr->timer(Timer::COMM);
 }
@@ -1616,5 +1653,7 @@ double ThrOMP::memory_usage_thr()
 {
   double bytes=0.0;
 
+  if (color) bytes += color->memory_usage();
+
   return bytes;
 }
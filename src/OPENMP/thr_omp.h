@@ -44,12 +44,17 @@ class ThrOMP {
   const int thr_style;
   int thr_error;
 
+  int color_flag;             // 1 if style supports spatial coloring
+  class ThrColor *color;      // coloring schedule, if in use
+
  public:
   ThrOMP(LAMMPS *, int);
-  virtual ~ThrOMP() = default;
+  virtual ~ThrOMP();
 
   double memory_usage_thr();
 
+  int get_color_flag() const { return color_flag; }
+
   inline void sync_threads()
   {
 #if defined(_OPENMP)
@@ -84,6 +89,9 @@ class ThrOMP {
   // reduce per thread data as needed
   void reduce_thr(void *const style, const int eflag, const int vflag, ThrData *const thr);
 
+  // set up coloring schedule, if forces are computed without per-thread arrays
+  bool color_setup_thr(int, const int *, int, int, double);
+
   // thread safe variant error abort support.
   // signals an error condition in any thread by making
   // thr_error > 0, if condition "cond" is true.
@@ -0,0 +1,433 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "verlet_task.h"
+
+#include "angle.h"
+#include "atom.h"
+#include "bond.h"
+#include "comm.h"
+#include "dihedral.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "improper.h"
+#include "kspace.h"
+#include "memory.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "output.h"
+#include "pair.h"
+#include "thr_omp.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cstring>
+
+#include "omp_compat.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+enum { SEQUENTIAL = 0, CONCURRENT = 1 };
+
+static constexpr double SMOOTH = 0.1;    // weight of a new timing in the running average
+
+/* ---------------------------------------------------------------------- */
+
+VerletTask::VerletTask(LAMMPS *lmp, int narg, char **arg) :
+  Verlet(lmp, narg, arg), ftask(nullptr)
+{
+  probe_every = 50;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"probe") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "run_style verlet/task probe", error);
+      probe_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (probe_every < 0) error->all(FLERR,"Illegal run_style verlet/task probe value");
+      iarg += 2;
+    } else error->all(FLERR,"Unknown run_style verlet/task keyword: {}", arg[iarg]);
+  }
+
+  task_flag = 0;
+  concurrent = CONCURRENT;
+  nsince = 0;
+  max_levels = 1;
+  nmax_ftask = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+VerletTask::~VerletTask()
+{
+  memory->destroy(ftask);
+}
+
+/* ----------------------------------------------------------------------
+   check if kspace can run on the main thread while the pair and bonded
+     terms run on the OpenMP threads of the package omp command
+   these tasks share no data except the forces, which are kept apart:
+     /omp styles accumulate into their per-thread force arrays
+     kspace sees a separate force array as atom->f
+   only the main thread may communicate, so pair must not communicate
+------------------------------------------------------------------------- */
+
+void VerletTask::init()
+{
+  Verlet::init();
+
+  if (!modify->get_fix_by_id("package_omp"))
+    error->all(FLERR,"Run style verlet/task requires the package omp command");
+
+  std::string reason;
+  if (!kspace_compute_flag) reason = "no kspace style";
+  else if (kspace_every > 1) reason = "kspace_modify every";
+  else if (utils::strmatch(force->kspace_style,"/omp$") ||
+           utils::strmatch(force->kspace_style,"/intel$") ||
+           utils::strmatch(force->kspace_style,"/gpu$") ||
+           utils::strmatch(force->kspace_style,"/kk"))
+    reason = fmt::format("kspace style {}", force->kspace_style);
+  else if (!pair_compute_flag) reason = "no pair style";
+  else if (!dynamic_cast<ThrOMP *>(force->pair))
+    reason = fmt::format("pair style {}", force->pair_style);
+  else if (force->pair->comm_forward || force->pair->comm_reverse ||
+           force->pair->comm_reverse_off)
+    reason = fmt::format("communicating pair style {}", force->pair_style);
+  else if (force->bond && !dynamic_cast<ThrOMP *>(force->bond))
+    reason = fmt::format("bond style {}", force->bond_style);
+  else if (force->angle && !dynamic_cast<ThrOMP *>(force->angle))
+    reason = fmt::format("angle style {}", force->angle_style);
+  else if (force->dihedral && !dynamic_cast<ThrOMP *>(force->dihedral))
+    reason = fmt::format("dihedral style {}", force->dihedral_style);
+  else if (force->improper && !dynamic_cast<ThrOMP *>(force->improper))
+    reason = fmt::format("improper style {}", force->improper_style);
+#if !defined(_OPENMP)
+  reason = "a LAMMPS binary without OpenMP";
+#endif
+
+  task_flag = reason.empty() ? 1 : 0;
+  if (!task_flag && (comm->me == 0))
+    error->warning(FLERR,"Run style verlet/task computes forces sequentially with {}", reason);
+}
+
+/* ----------------------------------------------------------------------
+   setup before run, forces are computed sequentially
+------------------------------------------------------------------------- */
+
+void VerletTask::setup(int flag)
+{
+  Verlet::setup(flag);
+
+  // pair and bonded terms run in a parallel region nested in a task
+
+#if defined(_OPENMP)
+  max_levels = omp_get_max_active_levels();
+  if (task_flag) {
+    if (max_levels < 2) omp_set_max_active_levels(2);
+    if (!check_nesting()) {
+      if (comm->me == 0)
+        error->warning(FLERR,"Run style verlet/task cannot start {} nested OpenMP threads, "
+                       "computing forces sequentially", comm->nthreads);
+      task_flag = 0;
+    }
+  }
+#endif
+
+  concurrent = task_flag ? CONCURRENT : SEQUENTIAL;
+  nsince = 0;
+  tmode[SEQUENTIAL] = tmode[CONCURRENT] = -1.0;
+  tpair = tkspace = 0.0;
+  ntask = 0;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if a thread of a 2-thread team gets a full nested team
+   the /omp styles partition their loops by comm->nthreads
+------------------------------------------------------------------------- */
+
+int VerletTask::check_nesting()
+{
+  int nteam = 0;
+#if defined(_OPENMP)
+  const int nthreads = comm->nthreads;
+#pragma omp parallel num_threads(2) LMP_DEFAULT_NONE LMP_SHARED(nteam)
+  {
+    if (omp_get_thread_num() == 1) {
+#pragma omp parallel num_threads(nthreads) LMP_DEFAULT_NONE LMP_SHARED(nteam)
+      {
+        if (omp_get_thread_num() == 0) nteam = omp_get_num_threads();
+      }
+    }
+  }
+#endif
+  return (nteam == comm->nthreads) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   run for N steps
+------------------------------------------------------------------------- */
+
+void VerletTask::run(int n)
+{
+  bigint ntimestep;
+  int nflag,sortflag;
+
+  int n_post_integrate = modify->n_post_integrate;
+  int n_pre_exchange = modify->n_pre_exchange;
+  int n_pre_neighbor = modify->n_pre_neighbor;
+  int n_post_neighbor = modify->n_post_neighbor;
+  int n_pre_force = modify->n_pre_force;
+  int n_pre_reverse = modify->n_pre_reverse;
+  int n_post_force_any = modify->n_post_force_any;
+  int n_end_of_step = modify->n_end_of_step;
+
+  if (atom->sortfreq > 0) sortflag = 1;
+  else sortflag = 0;
+
+  if (kspace_every > 1) kspace_mts_start();
+
+  for (int i = 0; i < n; i++) {
+    if (timer->check_timeout(i)) {
+      update->nsteps = i;
+      break;
+    }
+
+    ntimestep = ++update->ntimestep;
+    ev_set(ntimestep);
+    timer->trace_begin(ntimestep);
+
+    // initial time integration
+
+    timer->stamp();
+    modify->initial_integrate(vflag);
+    if (n_post_integrate) modify->post_integrate();
+    timer->stamp(Timer::MODIFY);
+
+    // regular communication vs neighbor list rebuild
+
+    nflag = neighbor->decide();
+
+    if (nflag == 0) {
+      timer->stamp();
+      comm->forward_comm();
+      timer->stamp(Timer::COMM);
+    } else {
+      if (n_pre_exchange) {
+        timer->stamp();
+        modify->pre_exchange();
+        timer->stamp(Timer::MODIFY);
+      }
+      if (triclinic) domain->x2lamda(atom->nlocal);
+      domain->pbc();
+      if (domain->box_change) {
+        domain->reset_box();
+        comm->setup();
+        if (neighbor->style) neighbor->setup_bins();
+      }
+      timer->stamp();
+      comm->exchange();
+      if (sortflag && ntimestep >= atom->nextsort) atom->sort();
+      comm->borders();
+      if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
+      timer->stamp(Timer::COMM);
+      if (n_pre_neighbor) {
+        modify->pre_neighbor();
+        timer->stamp(Timer::MODIFY);
+      }
+      neighbor->build(1);
+      timer->stamp(Timer::NEIGH);
+      if (n_post_neighbor) {
+        modify->post_neighbor();
+        timer->stamp(Timer::MODIFY);
+      }
+    }
+
+    // force computations
+
+    force_clear();
+
+    timer->stamp();
+
+    if (n_pre_force) {
+      modify->pre_force(vflag);
+      timer->stamp(Timer::MODIFY);
+    }
+
+    // every probe_every steps, time the mode not currently in use
+    // keep using the mode with the lower smoothed wall time
+
+    int mode = concurrent;
+    if (task_flag && probe_every && (++nsince >= probe_every)) {
+      mode = 1 - concurrent;
+      nsince = 0;
+    }
+
+    double tstart = platform::walltime();
+    if (mode == CONCURRENT) force_concurrent();
+    else force_sequential(ntimestep);
+    double tforce = platform::walltime() - tstart;
+
+    if (task_flag) {
+      if (tmode[mode] < 0.0) tmode[mode] = tforce;
+      else if (mode == concurrent) tmode[mode] += SMOOTH * (tforce - tmode[mode]);
+      else tmode[mode] = 0.5 * (tmode[mode] + tforce);
+      if ((tmode[SEQUENTIAL] >= 0.0) && (tmode[CONCURRENT] >= 0.0))
+        concurrent = (tmode[CONCURRENT] < tmode[SEQUENTIAL]) ? CONCURRENT : SEQUENTIAL;
+    }
+
+    if (n_pre_reverse) {
+      modify->pre_reverse(eflag,vflag);
+      timer->stamp(Timer::MODIFY);
+    }
+
+    // reverse communication of forces
+
+    if (force->newton) {
+      comm->reverse_comm();
+      timer->stamp(Timer::COMM);
+    }
+
+    // force modifications, final time integration, diagnostics
+
+    if (n_post_force_any) modify->post_force(vflag);
+    modify->final_integrate();
+    if (n_end_of_step) modify->end_of_step();
+    timer->stamp(Timer::MODIFY);
+
+    // all output
+
+    if (ntimestep == output->next) {
+      timer->stamp();
+      output->write(ntimestep);
+      timer->stamp(Timer::OUTPUT);
+    }
+
+    timer->trace_end();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   force terms one after another, same as run style verlet
+------------------------------------------------------------------------- */
+
+void VerletTask::force_sequential(bigint ntimestep)
+{
+  if (pair_compute_flag) {
+    force->pair->compute(eflag,vflag);
+    timer->stamp(Timer::PAIR);
+  }
+
+  if (atom->molecular != Atom::ATOMIC) {
+    if (force->bond) force->bond->compute(eflag,vflag);
+    if (force->angle) force->angle->compute(eflag,vflag);
+    if (force->dihedral) force->dihedral->compute(eflag,vflag);
+    if (force->improper) force->improper->compute(eflag,vflag);
+    timer->stamp(Timer::BOND);
+  }
+
+  if (kspace_compute_flag) {
+    if (kspace_every > 1) kspace_compute_mts(ntimestep,0);
+    else force->kspace->compute(eflag,vflag);
+    timer->stamp(Timer::KSPACE);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   kspace on the main thread, concurrently with pair and bonded terms on
+     a nested team of comm->nthreads threads
+   threaded kspace styles and FFTs are limited to the main thread,
+     so that in total no more than comm->nthreads+1 threads are busy
+   kspace writes into ftask, which is added to atom->f afterwards
+   the concurrent part is accounted as Pair time in the timer breakdown
+------------------------------------------------------------------------- */
+
+void VerletTask::force_concurrent()
+{
+  const int nall = atom->nlocal + atom->nghost;
+
+  if (atom->nmax > nmax_ftask) {
+    nmax_ftask = atom->nmax;
+    memory->destroy(ftask);
+    memory->create(ftask,nmax_ftask,3,"verlet/task:ftask");
+  }
+  if (nall) memset(&ftask[0][0],0,3*sizeof(double)*nall);
+
+  double **f = atom->f;
+  atom->f = ftask;
+  double tp = 0.0, tk = 0.0;
+
+#if defined(_OPENMP)
+  const int nthreads = comm->nthreads;
+#pragma omp parallel num_threads(2) LMP_DEFAULT_NONE LMP_SHARED(tp,tk)
+  {
+    const double tstart = platform::walltime();
+    if (omp_get_thread_num() == 0) {
+      omp_set_num_threads(1);
+      force->kspace->compute(eflag,vflag);
+      tk = platform::walltime() - tstart;
+    } else {
+      omp_set_num_threads(nthreads);
+      force->pair->compute(eflag,vflag);
+      if (atom->molecular != Atom::ATOMIC) {
+        if (force->bond) force->bond->compute(eflag,vflag);
+        if (force->angle) force->angle->compute(eflag,vflag);
+        if (force->dihedral) force->dihedral->compute(eflag,vflag);
+        if (force->improper) force->improper->compute(eflag,vflag);
+      }
+      tp = platform::walltime() - tstart;
+    }
+  }
+#endif
+
+  atom->f = f;
+  timer->stamp(Timer::PAIR);
+
+  // kspace may also set forces on ghost atoms, e.g. TIP4P M sites
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) LMP_DEFAULT_NONE LMP_SHARED(f)
+#endif
+  for (int i = 0; i < nall; i++) {
+    f[i][0] += ftask[i][0];
+    f[i][1] += ftask[i][1];
+    f[i][2] += ftask[i][2];
+  }
+  timer->stamp(Timer::KSPACE);
+
+  tpair += tp;
+  tkspace += tk;
+  ++ntask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void VerletTask::cleanup()
+{
+#if defined(_OPENMP)
+  if (omp_get_max_active_levels() != max_levels) omp_set_max_active_levels(max_levels);
+#endif
+
+  Verlet::cleanup();
+
+  if (task_flag && (comm->me == 0)) {
+    utils::logmesg(lmp,"Kspace computed concurrently with pair and bonded terms "
+                   "on {} of {} steps\n", ntask, update->nsteps);
+    if (ntask)
+      utils::logmesg(lmp,"  average wall time per step: pair+bonded {:.6g} kspace {:.6g}\n",
+                     tpair/ntask, tkspace/ntask);
+  }
+}
@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef INTEGRATE_CLASS
+// clang-format off
+IntegrateStyle(verlet/task,VerletTask);
+// clang-format on
+#else
+
+#ifndef LMP_VERLET_TASK_H
+#define LMP_VERLET_TASK_H
+
+#include "verlet.h"
+
+namespace LAMMPS_NS {
+
+class VerletTask : public Verlet {
+ public:
+  VerletTask(class LAMMPS *, int, char **);
+  ~VerletTask() override;
+  void init() override;
+  void setup(int) override;
+  void run(int) override;
+  void cleanup() override;
+
+ protected:
+  int task_flag;          // 1 if kspace can run concurrently with pair and bonded terms
+  int probe_every;        // steps between timing the currently slower mode
+  int concurrent;         // 1 if the concurrent mode is currently faster
+  int nsince;             // steps since last probe
+  int max_levels;         // OpenMP max active levels before the run
+  double tmode[2];        // smoothed wall time of force terms, sequential/concurrent
+  double tpair, tkspace;  // summed wall time of both tasks in concurrent mode
+  bigint ntask;           // # of steps with concurrent force terms
+
+  int nmax_ftask;
+  double **ftask;         // kspace forces while computed concurrently
+
+  void force_sequential(bigint);
+  void force_concurrent();
+  int check_nesting();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -99,6 +99,7 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp)
   nbonds = nangles = ndihedrals = nimpropers = 0;
 
   firstgroupname = nullptr;
+  shared_force = 0;
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
@@ -1038,11 +1039,15 @@ void Atom::deallocate_topology()
 /* ----------------------------------------------------------------------
    unpack N lines from Atom section of data file
    call style-specific routine to parse line
+   if ownall = 1, the lines are only seen by this proc, so store all atoms
+     inside the global box regardless of sub-domain and report errors
+     with error->one()
+     caller must migrate the atoms to their owning procs afterwards
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel)
+                      int labelflag, int *ilabel, int ownall)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1054,7 +1059,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
   // use the first line to detect and validate the number of words/tokens per line
   next = strchr(buf,'\n');
-  if (!next) error->all(FLERR, "Missing data in {}", location);
+  if (!next) {
+    if (ownall) error->one(FLERR, "Missing data in {}", location);
+    error->all(FLERR, "Missing data in {}", location);
+  }
   *next = '\0';
   auto values = Tokenizer(buf).as_vector();
   int nwords = values.size();
@@ -1065,8 +1073,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     }
   }
 
-  if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
+  if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3)) {
+    if (ownall) error->one(FLERR,"Incorrect format in {}: {}", location, utils::trim(buf));
     error->all(FLERR,"Incorrect format in {}: {}", location, utils::trim(buf));
+  }
 
   *next = '\n';
   // set bounds for my proc
@@ -1084,7 +1094,12 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 
   double sublo[3],subhi[3];
-  if (triclinic == 0) {
+  if (ownall) {
+    for (int dim = 0; dim < 3; dim++) {
+      sublo[dim] = triclinic ? 0.0 : domain->boxlo[dim];
+      subhi[dim] = triclinic ? 1.0 : domain->boxhi[dim];
+    }
+  } else if (triclinic == 0) {
     sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
     sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
     sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
@@ -1094,7 +1109,16 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
   }
 
-  if (comm->layout != Comm::LAYOUT_TILED) {
+  // with ownall the bounds are those of the global box
+  // atoms outside of it in non-periodic dimensions are skipped as in serial
+
+  if (ownall) {
+    for (int dim = 0; dim < 3; dim++)
+      if (domain->periodicity[dim]) {
+        sublo[dim] -= epsilon[dim];
+        subhi[dim] += epsilon[dim];
+      }
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
     if (domain->xperiodic) {
       if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
       if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
@@ -1139,7 +1163,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
-    if (!next) error->all(FLERR, "Missing data in {}", location);
+    if (!next) {
+      if (ownall) error->one(FLERR, "Missing data in {}", location);
+      error->all(FLERR, "Missing data in {}", location);
+    }
     *next = '\0';
     auto values = Tokenizer(buf).as_vector();
     int nvalues = values.size();
@@ -1147,6 +1174,7 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
       // skip over empty or comment lines
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
+      if (ownall) error->one(FLERR, "Incorrect format in {}: {}", location, utils::trim(buf));
       error->all(FLERR, "Incorrect format in {}: {}", location, utils::trim(buf));
     } else {
       int imx = 0, imy = 0, imz = 0;
@@ -1154,8 +1182,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         imx = utils::inumeric(FLERR,values[iptr],false,lmp);
         imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
         imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
-        if ((domain->dimension == 2) && (imz != 0))
+        if ((domain->dimension == 2) && (imz != 0)) {
+          if (ownall) error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
           error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+        }
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
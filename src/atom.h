@@ -63,6 +63,9 @@ class Atom : protected Pointers {
   int nfirst;              // # of atoms in first group on this proc
   char *firstgroupname;    // group-ID to store first, null pointer if unset
 
+  int shared_force;        // 1 if threaded styles accumulate into a single copy
+                           // of f and other per-thread arrays, 0 = one per thread
+
   // --------------------------------------------------------------------
   // 1st customization section: customize by adding new per-atom variable
   // per-atom vectors and arrays
@@ -328,7 +331,7 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int ownall = 0);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int, int, int *);
   void data_angles(int, char *, int *, tagint, int, int, int *);
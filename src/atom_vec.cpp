@@ -23,6 +23,8 @@
 #include "memory.h"
 #include "modify.h"
 
+#include <algorithm>
+
 using namespace LAMMPS_NS;
 
 // peratom variables that are auto-included in corresponding child style field lists
@@ -43,6 +45,14 @@ const std::vector<std::string> AtomVec::default_create = {"id", "type", "mask",
 const std::vector<std::string> AtomVec::default_data_atom = {};
 const std::vector<std::string> AtomVec::default_data_vel = {};
 
+// restart fields which are not part of delta restart records
+
+const std::vector<std::string> AtomVec::topology_fields = {
+    "num_bond",       "bond_type",      "bond_atom",      "num_angle",      "angle_type",
+    "angle_atom1",    "angle_atom2",    "angle_atom3",    "num_dihedral",   "dihedral_type",
+    "dihedral_atom1", "dihedral_atom2", "dihedral_atom3", "dihedral_atom4", "num_improper",
+    "improper_type",  "improper_atom1", "improper_atom2", "improper_atom3", "improper_atom4"};
+
 /* ---------------------------------------------------------------------- */
 
 AtomVec::AtomVec(LAMMPS *lmp) : Pointers(lmp)
@@ -57,6 +67,7 @@ AtomVec::AtomVec(LAMMPS *lmp) : Pointers(lmp)
   maxexchange = 0;
   bonus_flag = 0;
   size_forward_bonus = size_border_bonus = 0;
+  restart_delta_flag = 0;
 
   kokkosable = 0;
 
@@ -214,13 +225,16 @@ void AtomVec::grow(int n)
   image = memory->grow(atom->image, nmax, "atom:image");
   x = memory->grow(atom->x, nmax, 3, "atom:x");
   v = memory->grow(atom->v, nmax, 3, "atom:v");
-  f = memory->grow(atom->f, nmax * comm->nthreads, 3, "atom:f");
+  // per-thread copies of f and of threaded fields, unless all threads share one
+
+  const int nthreads_f = atom->shared_force ? 1 : comm->nthreads;
+  f = memory->grow(atom->f, nmax * nthreads_f, 3, "atom:f");
 
   for (int i = 0; i < ngrow; i++) {
     pdata = mgrow.pdata[i];
     datatype = mgrow.datatype[i];
     cols = mgrow.cols[i];
-    const int nthreads = threads[i] ? comm->nthreads : 1;
+    const int nthreads = threads[i] ? nthreads_f : 1;
     if (datatype == Atom::DOUBLE) {
       if (cols == 0)
         memory->grow(*((double **) pdata), nmax * nthreads, "atom:dvec");
@@ -1582,6 +1596,221 @@ int AtomVec::unpack_restart(double *buf)
   return m;
 }
 
+/* ----------------------------------------------------------------------
+   size of delta restart records of all owned atoms
+   same as size_restart() but without topology fields
+------------------------------------------------------------------------- */
+
+int AtomVec::size_restart_delta()
+{
+  int i, nn, cols;
+
+  int nlocal = atom->nlocal;
+
+  // 11 = length storage + id,type,mask,image,x,v
+
+  int n = 11 * nlocal;
+
+  for (nn = 0; nn < nrestart_delta; nn++) {
+    cols = mrestart_delta.cols[nn];
+    if (cols == 0)
+      n += nlocal;
+    else
+      n += cols * nlocal;
+  }
+
+  if (atom->nextra_restart)
+    for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+      for (i = 0; i < nlocal; i++) n += modify->fix[atom->extra_restart[iextra]]->size_restart(i);
+
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   pack atom I's data for a delta restart file including extra quantities
+   same layout as pack_restart() but without topology fields
+   only called if restart_delta_flag is set
+------------------------------------------------------------------------- */
+
+int AtomVec::pack_restart_delta(int i, double *buf)
+{
+  int mm, nn, datatype, cols;
+  void *pdata;
+
+  int m = 1;
+  buf[m++] = x[i][0];
+  buf[m++] = x[i][1];
+  buf[m++] = x[i][2];
+  buf[m++] = ubuf(tag[i]).d;
+  buf[m++] = ubuf(type[i]).d;
+  buf[m++] = ubuf(mask[i]).d;
+  buf[m++] = ubuf(image[i]).d;
+  buf[m++] = v[i][0];
+  buf[m++] = v[i][1];
+  buf[m++] = v[i][2];
+
+  for (nn = 0; nn < nrestart_delta; nn++) {
+    pdata = mrestart_delta.pdata[nn];
+    datatype = mrestart_delta.datatype[nn];
+    cols = mrestart_delta.cols[nn];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        buf[m++] = vec[i];
+      } else {
+        double **array = *((double ***) pdata);
+        for (mm = 0; mm < cols; mm++) buf[m++] = array[i][mm];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        buf[m++] = ubuf(vec[i]).d;
+      } else {
+        int **array = *((int ***) pdata);
+        for (mm = 0; mm < cols; mm++) buf[m++] = ubuf(array[i][mm]).d;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        buf[m++] = ubuf(vec[i]).d;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (mm = 0; mm < cols; mm++) buf[m++] = ubuf(array[i][mm]).d;
+      }
+    }
+  }
+
+  // invoke fixes which store peratom restart info
+
+  for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+    m += modify->fix[atom->extra_restart[iextra]]->pack_restart(i, &buf[m]);
+
+  buf[0] = m;
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   overwrite data of existing owned atom I from a delta restart record
+   topology of atom I is left unchanged
+------------------------------------------------------------------------- */
+
+int AtomVec::unpack_restart_delta(int i, double *buf)
+{
+  int mm, nn, datatype, cols;
+  void *pdata;
+
+  int m = 1;
+  x[i][0] = buf[m++];
+  x[i][1] = buf[m++];
+  x[i][2] = buf[m++];
+  tag[i] = (tagint) ubuf(buf[m++]).i;
+  type[i] = (int) ubuf(buf[m++]).i;
+  mask[i] = (int) ubuf(buf[m++]).i;
+  image[i] = (imageint) ubuf(buf[m++]).i;
+  v[i][0] = buf[m++];
+  v[i][1] = buf[m++];
+  v[i][2] = buf[m++];
+
+  for (nn = 0; nn < nrestart_delta; nn++) {
+    pdata = mrestart_delta.pdata[nn];
+    datatype = mrestart_delta.datatype[nn];
+    cols = mrestart_delta.cols[nn];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[i] = buf[m++];
+      } else {
+        double **array = *((double ***) pdata);
+        for (mm = 0; mm < cols; mm++) array[i][mm] = buf[m++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[i] = (int) ubuf(buf[m++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (mm = 0; mm < cols; mm++) array[i][mm] = (int) ubuf(buf[m++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[i] = (bigint) ubuf(buf[m++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (mm = 0; mm < cols; mm++) array[i][mm] = (bigint) ubuf(buf[m++]).i;
+      }
+    }
+  }
+
+  // replace extra restart info which fixes can unpack when instantiated
+
+  double **extra = atom->extra;
+  if (atom->nextra_store) {
+    int size = static_cast<int>(buf[0]) - m;
+    for (int k = 0; k < size; k++) extra[i][k] = buf[m++];
+  }
+
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   checksum of the topology of owned atoms
+   sum of 31-bit per-atom hashes, so it is independent of atom order
+   and the sum over all procs cannot overflow
+------------------------------------------------------------------------- */
+
+bigint AtomVec::topology_checksum()
+{
+  int mm, nn, datatype, cols, collength, ncols;
+  void *pdata, *plength;
+
+  auto mix = [](uint64_t hash, int64_t value) {
+    return (hash ^ (uint64_t) value) * 0x100000001b3ULL;
+  };
+
+  bigint sum = 0;
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    uint64_t hash = mix(0xcbf29ce484222325ULL, tag[i]);
+
+    for (nn = 0; nn < ntopology; nn++) {
+      pdata = mtopology.pdata[nn];
+      datatype = mtopology.datatype[nn];
+      cols = mtopology.cols[nn];
+      ncols = cols;
+      if (cols < 0) {
+        collength = mtopology.collength[nn];
+        plength = mtopology.plength[nn];
+        if (collength)
+          ncols = (*((int ***) plength))[i][collength - 1];
+        else
+          ncols = (*((int **) plength))[i];
+      }
+      if (datatype == Atom::INT) {
+        if (cols == 0) {
+          int *vec = *((int **) pdata);
+          hash = mix(hash, vec[i]);
+        } else {
+          int **array = *((int ***) pdata);
+          for (mm = 0; mm < ncols; mm++) hash = mix(hash, array[i][mm]);
+        }
+      } else if (datatype == Atom::BIGINT) {
+        if (cols == 0) {
+          bigint *vec = *((bigint **) pdata);
+          hash = mix(hash, vec[i]);
+        } else {
+          bigint **array = *((bigint ***) pdata);
+          for (mm = 0; mm < ncols; mm++) hash = mix(hash, array[i][mm]);
+        }
+      }
+    }
+    sum += (bigint) (hash >> 33);
+  }
+
+  return sum;
+}
+
 /* ----------------------------------------------------------------------
    create one atom of itype at coord
    set other values to defaults
@@ -1927,6 +2156,162 @@ void AtomVec::pack_vel(double **buf)
   }
 }
 
+/* ----------------------------------------------------------------------
+   names and integer flags of the values packed by pack_data() and pack_vel()
+   one name per value, array fields get a 1-based column index appended
+   used for the columns of binary data files
+------------------------------------------------------------------------- */
+
+void AtomVec::data_columns(std::vector<std::string> &atomnames, std::vector<int> &atomint,
+                           std::vector<std::string> &velnames, std::vector<int> &velint)
+{
+  atomnames.clear();
+  atomint.clear();
+  for (int n = 0; n < ndata_atom; n++) {
+    int cols = mdata_atom.cols[n];
+    int isint = (mdata_atom.datatype[n] == Atom::DOUBLE) ? 0 : 1;
+    if (cols == 0) {
+      atomnames.push_back(fields_data_atom[n]);
+      atomint.push_back(isint);
+    } else {
+      for (int m = 0; m < cols; m++) {
+        atomnames.push_back(fmt::format("{}[{}]", fields_data_atom[n], m + 1));
+        atomint.push_back(isint);
+      }
+    }
+  }
+  for (const auto &name : {"ix", "iy", "iz"}) {
+    atomnames.emplace_back(name);
+    atomint.push_back(1);
+  }
+
+  velnames.clear();
+  velint.clear();
+  for (int n = 0; n < ndata_vel; n++) {
+    int cols = mdata_vel.cols[n];
+    int isint = (mdata_vel.datatype[n] == Atom::DOUBLE) ? 0 : 1;
+    if (cols == 0) {
+      velnames.push_back(fields_data_vel[n]);
+      velint.push_back(isint);
+    } else {
+      for (int m = 0; m < cols; m++) {
+        velnames.push_back(fmt::format("{}[{}]", fields_data_vel[n], m + 1));
+        velint.push_back(isint);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack one atom from binary data file values
+   values are in order and encoding of pack_data() w/out the image flags
+   atom type is stored directly, caller must check its range
+------------------------------------------------------------------------- */
+
+void AtomVec::data_atom_binary(double *coord, imageint imagetmp, const double *values)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  x[nlocal][0] = coord[0];
+  x[nlocal][1] = coord[1];
+  x[nlocal][2] = coord[2];
+  mask[nlocal] = 1;
+  image[nlocal] = imagetmp;
+  v[nlocal][0] = 0.0;
+  v[nlocal][1] = 0.0;
+  v[nlocal][2] = 0.0;
+
+  int ivalue = 0;
+  for (n = 0; n < ndata_atom; n++) {
+    pdata = mdata_atom.pdata[n];
+    datatype = mdata_atom.datatype[n];
+    cols = mdata_atom.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[nlocal] = values[ivalue++];
+      } else {
+        double **array = *((double ***) pdata);
+        if (array == atom->x) {    // x was already set by coord arg
+          ivalue += cols;
+          continue;
+        }
+        for (m = 0; m < cols; m++) array[nlocal][m] = values[ivalue++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[nlocal] = (int) ubuf(values[ivalue++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (int) ubuf(values[ivalue++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[nlocal] = (bigint) ubuf(values[ivalue++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (bigint) ubuf(values[ivalue++]).i;
+      }
+    }
+  }
+
+  if (tag[nlocal] <= 0)
+    error->one(FLERR, "Invalid atom ID {} in binary data file", tag[nlocal]);
+
+  data_atom_post(nlocal);
+
+  atom->nlocal++;
+}
+
+/* ----------------------------------------------------------------------
+   unpack velocity info of one atom from binary data file values
+   values are in order and encoding of pack_vel(), including the atom ID
+------------------------------------------------------------------------- */
+
+void AtomVec::data_vel_binary(int ilocal, const double *values)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  int ivalue = 0;
+  for (n = 1; n < ndata_vel; n++) {
+    pdata = mdata_vel.pdata[n];
+    datatype = mdata_vel.datatype[n];
+    cols = mdata_vel.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[ilocal] = values[++ivalue];
+      } else {
+        double **array = *((double ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = values[++ivalue];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[ilocal] = (int) ubuf(values[++ivalue]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = (int) ubuf(values[++ivalue]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[ilocal] = (bigint) ubuf(values[++ivalue]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++) array[ilocal][m] = (bigint) ubuf(values[++ivalue]).i;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    write velocity info to data file
    id and velocity vector are first 4 fields
@@ -2238,13 +2623,14 @@ double AtomVec::memory_usage()
   bytes += memory->usage(image, nmax);
   bytes += memory->usage(x, nmax, 3);
   bytes += memory->usage(v, nmax, 3);
-  bytes += memory->usage(f, nmax * comm->nthreads, 3);
+  const int nthreads_f = atom->shared_force ? 1 : comm->nthreads;
+  bytes += memory->usage(f, nmax * nthreads_f, 3);
 
   for (int i = 0; i < ngrow; i++) {
     pdata = mgrow.pdata[i];
     datatype = mgrow.datatype[i];
     cols = mgrow.cols[i];
-    const int nthreads = threads[i] ? comm->nthreads : 1;
+    const int nthreads = threads[i] ? nthreads_f : 1;
     if (datatype == Atom::DOUBLE) {
       if (cols == 0) {
         bytes += memory->usage(*((double **) pdata), nmax * nthreads);
@@ -2313,6 +2699,18 @@ void AtomVec::setup_fields()
   ndata_atom = process_fields(fields_data_atom, default_data_atom, &mdata_atom);
   ndata_vel = process_fields(fields_data_vel, default_data_vel, &mdata_vel);
 
+  // split restart fields into topology and the rest for delta restart files
+
+  std::vector<std::string> fields_restart_delta, fields_topology;
+  for (const auto &field : fields_restart) {
+    if (std::find(topology_fields.begin(), topology_fields.end(), field) != topology_fields.end())
+      fields_topology.push_back(field);
+    else
+      fields_restart_delta.push_back(field);
+  }
+  nrestart_delta = process_fields(fields_restart_delta, default_restart, &mrestart_delta);
+  ntopology = process_fields(fields_topology, default_restart, &mtopology);
+
   // populate field-based data struct for each method to use
 
   init_method(ngrow, &mgrow);
@@ -2327,6 +2725,16 @@ void AtomVec::setup_fields()
   init_method(ncreate, &mcreate);
   init_method(ndata_atom, &mdata_atom);
   init_method(ndata_vel, &mdata_vel);
+  init_method(nrestart_delta, &mrestart_delta);
+  init_method(ntopology, &mtopology);
+
+  // delta records require a fixed number of values per atom
+  // for all restart fields except topology
+
+  restart_delta_flag = 1;
+  if (bonus_flag) restart_delta_flag = 0;
+  for (n = 0; n < nrestart_delta; n++)
+    if (mrestart_delta.cols[n] < 0) restart_delta_flag = 0;
 
   // create threads data struct for grow and memory_usage to use
 
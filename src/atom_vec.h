@@ -48,6 +48,8 @@ class AtomVec : protected Pointers {
   int size_restart_bonus_one;    // # in restart bonus comm
   int size_data_bonus;           // number of values in Bonus line
 
+  int restart_delta_flag;    // 1 if style can write delta restart records
+
   class Molecule **onemols;    // list of molecules for style template
   int nset;                    // # of molecules in list
 
@@ -116,6 +118,11 @@ class AtomVec : protected Pointers {
   virtual void pack_restart_post(int) {}
   virtual void unpack_restart_init(int) {}
 
+  int size_restart_delta();
+  int pack_restart_delta(int, double *);
+  int unpack_restart_delta(int, double *);
+  bigint topology_checksum();
+
   virtual int size_restart_bonus() { return 0; }
   virtual int pack_restart_bonus(int, double *) { return 0; }
   virtual int unpack_restart_bonus(int, double *) { return 0; }
@@ -139,6 +146,11 @@ class AtomVec : protected Pointers {
   virtual void pack_vel(double **);
   virtual void write_vel(FILE *, int, double **);
 
+  void data_columns(std::vector<std::string> &, std::vector<int> &, std::vector<std::string> &,
+                    std::vector<int> &);
+  void data_atom_binary(double *, imageint, const double *);
+  void data_vel_binary(int, const double *);
+
   virtual int pack_bond(tagint **);
   virtual void write_bond(FILE *, int, tagint **, int);
   virtual int pack_angle(tagint **);
@@ -175,6 +187,7 @@ class AtomVec : protected Pointers {
   static const std::vector<std::string> default_reverse, default_border, default_border_vel;
   static const std::vector<std::string> default_exchange, default_restart, default_create;
   static const std::vector<std::string> default_data_atom, default_data_vel;
+  static const std::vector<std::string> topology_fields;
 
   struct Method {
     std::vector<void *> pdata;
@@ -191,10 +204,12 @@ class AtomVec : protected Pointers {
   Method mgrow, mcopy;
   Method mcomm, mcomm_vel, mreverse, mborder, mborder_vel, mexchange, mrestart;
   Method mcreate, mdata_atom, mdata_vel;
+  Method mrestart_delta, mtopology;
 
   int ngrow, ncopy;
   int ncomm, ncomm_vel, nreverse, nborder, nborder_vel, nexchange, nrestart;
   int ncreate, ndata_atom, ndata_vel;
+  int nrestart_delta, ntopology;
 
   // thread info for fields that are duplicated over threads
   // used by fields in grow() and memory_usage()
@@ -29,6 +29,7 @@
 #include "fix_store_atom.h"
 #include "force.h"
 #include "imbalance.h"
+#include "imbalance_cost.h"
 #include "imbalance_group.h"
 #include "imbalance_neigh.h"
 #include "imbalance_store.h"
@@ -48,7 +49,11 @@ using namespace LAMMPS_NS;
 
 double EPSNEIGH = 1.0e-3;
 
-enum{XYZ,SHIFT,BISECTION};
+// max fraction of distance to next parallel cut that a cut moves per iteration
+
+static constexpr double DIFFUSE_LIMIT = 0.5;
+
+enum{XYZ,SHIFT,BISECTION,DIFFUSE};
 enum{NONE,UNIFORM,USER};
 enum{X,Y,Z};
 
@@ -63,6 +68,11 @@ Balance::Balance(LAMMPS *lmp) : Command(lmp)
   shift_allocate = 0;
   proccost = allproccost = nullptr;
 
+  diffuse_allocate = 0;
+  dcost = dsum = dcut = dbestcut = nullptr;
+  dcutdim = dsendproc = nullptr;
+  dmaxatom = 0;
+
   rcb = nullptr;
 
   nimbalance = 0;
@@ -96,6 +106,13 @@ Balance::~Balance()
     delete[] hisum;
   }
 
+  memory->destroy(dcost);
+  memory->destroy(dsum);
+  memory->destroy(dcut);
+  memory->destroy(dbestcut);
+  memory->destroy(dcutdim);
+  memory->destroy(dsendproc);
+
   delete rcb;
 
   for (int i = 0; i < nimbalance; i++) delete imbalances[i];
@@ -211,6 +228,16 @@ void Balance::command(int narg, char **arg)
       style = BISECTION;
       iarg++;
 
+    } else if (strcmp(arg[iarg],"diffuse") == 0) {
+      if (style != -1) error->all(FLERR,"Illegal balance command");
+      if (iarg+3 > narg) error->all(FLERR,"Illegal balance command");
+      style = DIFFUSE;
+      nitermax = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nitermax <= 0) error->all(FLERR,"Illegal balance command");
+      stopthresh = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (stopthresh < 1.0) error->all(FLERR,"Illegal balance command");
+      iarg += 3;
+
     } else break;
   }
 
@@ -249,6 +276,8 @@ void Balance::command(int narg, char **arg)
 
   if (style == BISECTION && comm->style == Comm::BRICK)
     error->all(FLERR,"Balance rcb cannot be used with comm_style brick");
+  if (style == DIFFUSE && comm->style == Comm::BRICK)
+    error->all(FLERR,"Balance diffuse cannot be used with comm_style brick");
 
   // process remaining optional args
 
@@ -283,7 +312,7 @@ void Balance::command(int narg, char **arg)
   // no load-balance if imbalance doesn't exceed threshold
   // unless switching from tiled to non tiled layout, then force rebalance
 
-  if (comm->layout == Comm::LAYOUT_TILED && style != BISECTION) {
+  if (comm->layout == Comm::LAYOUT_TILED && style != BISECTION && style != DIFFUSE) {
   } else if (imbinit < thresh) return;
 
   // debug output of initial state
@@ -342,9 +371,19 @@ void Balance::command(int narg, char **arg)
 
   // style BISECTION = recursive coordinate bisectioning
 
+  int *sendproc = nullptr;
   if (style == BISECTION) {
     comm->layout = Comm::LAYOUT_TILED;
-    bisection();
+    sendproc = bisection();
+  }
+
+  // style DIFFUSE = move cuts of existing RCB tiling towards balance
+  // start from an RCB tiling if there is none yet
+
+  if (style == DIFFUSE) {
+    if (comm->layout == Comm::LAYOUT_TILED) sendproc = diffuse(niter);
+    else sendproc = bisection();
+    comm->layout = Comm::LAYOUT_TILED;
   }
 
   // reset proc sub-domains
@@ -359,7 +398,7 @@ void Balance::command(int narg, char **arg)
   if (domain->triclinic) domain->x2lamda(atom->nlocal);
   auto irregular = new Irregular(lmp);
   if (wtflag) fixstore->disable = 0;
-  if (style == BISECTION) irregular->migrate_atoms(sortflag,1,rcb->sendproc);
+  if (style == BISECTION || style == DIFFUSE) irregular->migrate_atoms(sortflag,1,sendproc);
   else irregular->migrate_atoms(sortflag);
   delete irregular;
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
@@ -402,7 +441,7 @@ void Balance::command(int narg, char **arg)
                         "  initial/final imbalance factor  = {:.8} {:.8}\n",
                         maxinit,maxfinal,imbinit,imbfinal);
 
-    if (style != BISECTION) {
+    if (style != BISECTION && style != DIFFUSE) {
       mesg += "  x cuts:";
       for (int i = 0; i <= comm->procgrid[0]; i++)
         mesg += fmt::format(" {:.8}",comm->xsplit[i]);
@@ -464,6 +503,10 @@ void Balance::options(int iarg, int narg, char **arg, int sortflag_default)
         imb = new ImbalanceVar(lmp);
         nopt = imb->options(narg-iarg,arg+iarg+2);
         imbalances[nimbalance++] = imb;
+      } else if (strcmp(arg[iarg+1],"cost") == 0) {
+        imb = new ImbalanceCost(lmp);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
+        imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"store") == 0) {
         imb = new ImbalanceStore(lmp);
         nopt = imb->options(narg-iarg,arg+iarg+2);
@@ -713,6 +756,247 @@ int *Balance::bisection()
   return rcb->sendproc;
 }
 
+/* ----------------------------------------------------------------------
+   setup diffusive load balance operations
+   called from fix balance
+------------------------------------------------------------------------- */
+
+void Balance::diffuse_setup(int nitermax_in, double thresh_in)
+{
+  nitermax = nitermax_in;
+  stopthresh = thresh_in;
+}
+
+/* ----------------------------------------------------------------------
+   load balance by moving the cuts of the current RCB tiling
+   each cut moves towards equal cost per proc on its two sides,
+     but at most part way to the next parallel cut on either side,
+     so the RCB tree stays valid and particles only move between
+     procs whose sub-domains touch the cut
+   iterate with cost per proc re-tallied for trial cuts, keep the best
+   requires comm->layout = TILED, i.e. a previous RCB balance
+   return niter = iteration count
+   return list of procs to send my atoms to
+------------------------------------------------------------------------- */
+
+int *Balance::diffuse(int &niter)
+{
+  if (!diffuse_allocate) {
+    diffuse_allocate = 1;
+    memory->create(dcost,nprocs,"balance:dcost");
+    memory->create(dsum,nprocs+1,"balance:dsum");
+    memory->create(dcut,nprocs,"balance:dcut");
+    memory->create(dbestcut,nprocs,"balance:dbestcut");
+    memory->create(dcutdim,nprocs,"balance:dcutdim");
+  }
+
+  int nlocal = atom->nlocal;
+  if (nlocal > dmaxatom) {
+    dmaxatom = atom->nmax;
+    memory->destroy(dsendproc);
+    memory->create(dsendproc,dmaxatom,"balance:dsendproc");
+  }
+
+  // gather cut stored by each proc, same as CommTiled::coord2proc_setup()
+
+  double mycut[2],*allcut;
+  mycut[0] = comm->rcbcutfrac;
+  mycut[1] = comm->rcbcutdim;
+  memory->create(allcut,2*nprocs,"balance:allcut");
+  MPI_Allgather(mycut,2,MPI_DOUBLE,allcut,2,MPI_DOUBLE,world);
+  for (int i = 0; i < nprocs; i++) {
+    dcut[i] = allcut[2*i];
+    dcutdim[i] = static_cast<int> (allcut[2*i+1]);
+  }
+  memory->destroy(allcut);
+
+  // if triclinic, cuts are in lamda coords
+
+  if (domain->triclinic) domain->x2lamda(nlocal);
+
+  double imbalance = diffuse_tally();
+  double bestimbalance = imbalance;
+  memcpy(dbestcut,dcut,nprocs*sizeof(double));
+
+  niter = 0;
+  while (niter < nitermax && imbalance > stopthresh) {
+    dsum[0] = 0.0;
+    for (int i = 0; i < nprocs; i++) dsum[i+1] = dsum[i] + dcost[i];
+
+    double boxlo[3] = {0.0, 0.0, 0.0};
+    double boxhi[3] = {1.0, 1.0, 1.0};
+    diffuse_move(0,nprocs-1,boxlo,boxhi);
+    niter++;
+
+    imbalance = diffuse_tally();
+    if (imbalance < bestimbalance) {
+      bestimbalance = imbalance;
+      memcpy(dbestcut,dcut,nprocs*sizeof(double));
+    }
+  }
+
+  // re-tally if last trial cuts were not the best ones
+
+  if (imbalance > bestimbalance) {
+    memcpy(dcut,dbestcut,nprocs*sizeof(double));
+    diffuse_tally();
+  }
+
+  if (domain->triclinic) domain->lamda2x(nlocal);
+
+  // store new cut and my sub-domain in CommTiled
+  // walk RCB tree from root to the leaf that is me
+
+  comm->rcbnew = 1;
+  comm->rcbcutfrac = dcut[me];
+
+  double (*mysplit)[2] = comm->mysplit;
+  for (int idim = 0; idim < 3; idim++) {
+    mysplit[idim][0] = 0.0;
+    mysplit[idim][1] = 1.0;
+  }
+
+  int proclower = 0;
+  int procupper = nprocs-1;
+  while (proclower != procupper) {
+    int procmid = proclower + (procupper - proclower) / 2 + 1;
+    if (me < procmid) {
+      mysplit[dcutdim[procmid]][1] = dcut[procmid];
+      procupper = procmid-1;
+    } else {
+      mysplit[dcutdim[procmid]][0] = dcut[procmid];
+      proclower = procmid;
+    }
+  }
+
+  return dsendproc;
+}
+
+/* ----------------------------------------------------------------------
+   assign each of my particles to its proc for current trial cuts
+   tally cost per proc, summed across procs
+   return imbalance factor of trial cuts
+------------------------------------------------------------------------- */
+
+double Balance::diffuse_tally()
+{
+  double *boxlo,*prd;
+  if (domain->triclinic == 0) {
+    boxlo = domain->boxlo;
+    prd = domain->prd;
+  } else {
+    boxlo = domain->boxlo_lamda;
+    prd = domain->prd_lamda;
+  }
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  if (wtflag) weight = fixstore->vstore;
+
+  for (int i = 0; i < nprocs; i++) dsum[i] = 0.0;
+
+  double frac[3];
+  for (int i = 0; i < nlocal; i++) {
+    frac[0] = (x[i][0] - boxlo[0]) / prd[0];
+    frac[1] = (x[i][1] - boxlo[1]) / prd[1];
+    frac[2] = (x[i][2] - boxlo[2]) / prd[2];
+    int proc = diffuse_drop(frac);
+    dsendproc[i] = proc;
+    if (wtflag) dsum[proc] += weight[i];
+    else dsum[proc] += 1.0;
+  }
+
+  MPI_Allreduce(dsum,dcost,nprocs,MPI_DOUBLE,MPI_SUM,world);
+
+  double maxcost = 0.0;
+  double totalcost = 0.0;
+  for (int i = 0; i < nprocs; i++) {
+    maxcost = MAX(maxcost,dcost[i]);
+    totalcost += dcost[i];
+  }
+
+  if (totalcost == 0.0) return 1.0;
+  return maxcost / (totalcost/nprocs);
+}
+
+/* ----------------------------------------------------------------------
+   return proc that owns fractional coords x for current trial cuts
+   same tree walk as CommTiled::point_drop_tiled_recurse()
+------------------------------------------------------------------------- */
+
+int Balance::diffuse_drop(double *x)
+{
+  int proclower = 0;
+  int procupper = nprocs-1;
+  while (proclower != procupper) {
+    int procmid = proclower + (procupper - proclower) / 2 + 1;
+    if (x[dcutdim[procmid]] < dcut[procmid]) procupper = procmid-1;
+    else proclower = procmid;
+  }
+  return proclower;
+}
+
+/* ----------------------------------------------------------------------
+   move cut between procs proclower to procupper, then cuts below it
+   lo,hi = fractional bounds of the partition, using already moved cuts
+   cost density on the side that gives up cost is assumed uniform
+------------------------------------------------------------------------- */
+
+void Balance::diffuse_move(int proclower, int procupper, double *lo, double *hi)
+{
+  if (proclower == procupper) return;
+
+  int procmid = proclower + (procupper - proclower) / 2 + 1;
+  int idim = dcutdim[procmid];
+  double cut = dcut[procmid];
+
+  // excess = cost the lower half has above its share
+
+  double costlo = dsum[procmid] - dsum[proclower];
+  double costhi = dsum[procupper+1] - dsum[procmid];
+  int nlo = procmid - proclower;
+  int nhi = procupper + 1 - procmid;
+  double excess = (costlo*nhi - costhi*nlo) / (nlo+nhi);
+
+  if (excess > 0.0) {
+    double gap = cut - diffuse_bound(proclower,procmid-1,idim,lo[idim],1);
+    double delta = excess * (cut-lo[idim]) / costlo;
+    cut -= MIN(delta,DIFFUSE_LIMIT*gap);
+  } else if (excess < 0.0) {
+    double gap = diffuse_bound(procmid,procupper,idim,hi[idim],0) - cut;
+    double delta = -excess * (hi[idim]-cut) / costhi;
+    cut += MIN(delta,DIFFUSE_LIMIT*gap);
+  }
+  dcut[procmid] = cut;
+
+  double newlo[3],newhi[3];
+  memcpy(newhi,hi,3*sizeof(double));
+  newhi[idim] = cut;
+  diffuse_move(proclower,procmid-1,lo,newhi);
+  memcpy(newlo,lo,3*sizeof(double));
+  newlo[idim] = cut;
+  diffuse_move(procmid,procupper,newlo,hi);
+}
+
+/* ----------------------------------------------------------------------
+   return closest cut in dimension idim within procs proclower to procupper
+   maxflag = 1 for largest cut, else smallest cut
+   bound = value to return if there is no such cut
+------------------------------------------------------------------------- */
+
+double Balance::diffuse_bound(int proclower, int procupper, int idim, double bound, int maxflag)
+{
+  if (proclower == procupper) return bound;
+
+  int procmid = proclower + (procupper - proclower) / 2 + 1;
+  if (dcutdim[procmid] == idim) {
+    if (maxflag) bound = MAX(bound,dcut[procmid]);
+    else bound = MIN(bound,dcut[procmid]);
+  }
+  bound = diffuse_bound(proclower,procmid-1,idim,bound,maxflag);
+  return diffuse_bound(procmid,procupper,idim,bound,maxflag);
+}
+
 /* ----------------------------------------------------------------------
    setup static load balance operations
    called from command and indirectly initially from fix balance
@@ -44,6 +44,8 @@ class Balance : public Command {
   void shift_setup(char *, int, double);
   int shift();
   int *bisection();
+  void diffuse_setup(int, double);
+  int *diffuse(int &);
   void dumpout(bigint);
 
   static constexpr int BSTR_SIZE = 3;
@@ -76,6 +78,15 @@ class Balance : public Command {
   double *proccost;       // particle cost per processor
   double *allproccost;    // proccost summed across procs
 
+  int diffuse_allocate;    // 1 if DIFFUSE vectors have been allocated
+  double *dcost;           // cost per proc of tiling with trial cuts
+  double *dsum;            // cumulative cost over procs
+  double *dcut;            // RCB cut stored by each proc, as fraction of box
+  double *dbestcut;        // cuts of trial tiling with lowest imbalance
+  int *dcutdim;            // dimension of cut stored by each proc
+  int *dsendproc;          // new proc of each owned particle
+  int dmaxatom;            // size of dsendproc
+
   int nimbalance;                  // number of user-specified weight styles
   class Imbalance **imbalances;    // list of Imb classes, one per weight style
   double *weight;                  // ptr to FixStore weight vector
@@ -87,6 +98,10 @@ class Balance : public Command {
   void shift_setup_static(char *);
   void tally(int, int, double *);
   int adjust(int, double *);
+  double diffuse_tally();
+  int diffuse_drop(double *);
+  void diffuse_move(int, int, double *, double *);
+  double diffuse_bound(int, int, int, double, int);
 #ifdef BALANCE_DEBUG
   void debug_shift_output(int, int, int, double *);
 #endif
@@ -32,6 +32,7 @@
 #include "output.h"
 #include "pair.h"
 #include "procmap.h"
+#include "timer.h"
 #include "universe.h"
 #include "update.h"
 
@@ -75,6 +76,7 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   maxexchange = maxexchange_atom = maxexchange_fix = 0;
   maxexchange_fix_dynamic = 0;
   bufextra = BUFEXTRA;
+  for (int i = 0; i < NUM_COMM_TIMER; i++) comm_timer[i] = -1;
 
   grid2proc = nullptr;
   xsplit = ysplit = zsplit = nullptr;
@@ -260,6 +262,13 @@ void Comm::init()
     if (mode != Comm::MULTI)
       error->all(FLERR,"Cannot use multi/reduce communication without mode multi");
   }
+
+  // sub-timers for communication operations, with timer full or trace
+
+  comm_timer[TIME_FORWARD] = timer->sub_timer(Timer::COMM, "forward");
+  comm_timer[TIME_REVERSE] = timer->sub_timer(Timer::COMM, "reverse");
+  comm_timer[TIME_EXCHANGE] = timer->sub_timer(Timer::COMM, "exchange");
+  comm_timer[TIME_BORDERS] = timer->sub_timer(Timer::COMM, "borders");
 }
 
 /* ----------------------------------------------------------------------
@@ -141,6 +141,11 @@ class Comm : protected Pointers {
   int maxexchange_fix_dynamic;    // 1 if a fix has a dynamic contribution
   int bufextra;                   // augment send buf size for an exchange atom
 
+  // sub-timers of the communication operations, -1 unless timer full or trace
+
+  enum { TIME_FORWARD, TIME_REVERSE, TIME_EXCHANGE, TIME_BORDERS, NUM_COMM_TIMER };
+  int comm_timer[NUM_COMM_TIMER];
+
   int gridflag;        // option for creating 3d grid
   int mapflag;         // option for mapping procs to 3d grid
   char xyz[4];         // xyz mapping of procs to 3d grid
@@ -29,6 +29,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "timer.h"
 
 #include <cmath>
 #include <cstring>
@@ -537,6 +538,8 @@ int CommBrick::updown(int dim, int dir, int loc, double prd, int periodicity, do
 
 void CommBrick::forward_comm(int /*dummy*/)
 {
+  timer->sub_start(comm_timer[TIME_FORWARD]);
+
   int n;
   MPI_Request request;
   AtomVec *avec = atom->avec;
@@ -588,6 +591,8 @@ void CommBrick::forward_comm(int /*dummy*/)
       }
     }
   }
+
+  timer->sub_stop(comm_timer[TIME_FORWARD]);
 }
 
 /* ----------------------------------------------------------------------
@@ -597,6 +602,8 @@ void CommBrick::forward_comm(int /*dummy*/)
 
 void CommBrick::reverse_comm()
 {
+  timer->sub_start(comm_timer[TIME_REVERSE]);
+
   int n;
   MPI_Request request;
   AtomVec *avec = atom->avec;
@@ -636,6 +643,8 @@ void CommBrick::reverse_comm()
       }
     }
   }
+
+  timer->sub_stop(comm_timer[TIME_REVERSE]);
 }
 
 /* ----------------------------------------------------------------------
@@ -651,6 +660,8 @@ void CommBrick::reverse_comm()
 
 void CommBrick::exchange()
 {
+  timer->sub_start(comm_timer[TIME_EXCHANGE]);
+
   int i,m,nsend,nrecv,nrecv1,nrecv2,nlocal;
   double lo,hi,value;
   double **x;
@@ -756,6 +767,8 @@ void CommBrick::exchange()
   }
 
   if (atom->firstgroupname) atom->first_reorder();
+
+  timer->sub_stop(comm_timer[TIME_EXCHANGE]);
 }
 
 /* ----------------------------------------------------------------------
@@ -770,6 +783,8 @@ void CommBrick::exchange()
 
 void CommBrick::borders()
 {
+  timer->sub_start(comm_timer[TIME_BORDERS]);
+
   int i,n,itype,icollection,iswap,dim,ineed,twoneed;
   int nsend,nrecv,sendflag,nfirst,nlast,ngroup,nprior;
   double lo,hi;
@@ -976,6 +991,8 @@ void CommBrick::borders()
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
+
+  timer->sub_stop(comm_timer[TIME_BORDERS]);
 }
 
 /* ----------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "timer.h"
 
 #include <cmath>
 #include <cstring>
@@ -714,6 +715,8 @@ void CommTiled::setup()
 
 void CommTiled::forward_comm(int /*dummy*/)
 {
+  timer->sub_start(comm_timer[TIME_FORWARD]);
+
   int i,irecv,n,nsend,nrecv;
   AtomVec *avec = atom->avec;
   double **x = atom->x;
@@ -801,6 +804,8 @@ void CommTiled::forward_comm(int /*dummy*/)
       }
     }
   }
+
+  timer->sub_stop(comm_timer[TIME_FORWARD]);
 }
 
 /* ----------------------------------------------------------------------
@@ -810,6 +815,8 @@ void CommTiled::forward_comm(int /*dummy*/)
 
 void CommTiled::reverse_comm()
 {
+  timer->sub_start(comm_timer[TIME_REVERSE]);
+
   int i,irecv,n,nsend,nrecv;
   AtomVec *avec = atom->avec;
   double **f = atom->f;
@@ -874,6 +881,8 @@ void CommTiled::reverse_comm()
       }
     }
   }
+
+  timer->sub_stop(comm_timer[TIME_REVERSE]);
 }
 
 /* ----------------------------------------------------------------------
@@ -889,6 +898,8 @@ void CommTiled::reverse_comm()
 
 void CommTiled::exchange()
 {
+  timer->sub_start(comm_timer[TIME_EXCHANGE]);
+
   int i,m,nexch,nsend,nrecv,nlocal,proc,offset;
   double lo,hi,value;
   double **x;
@@ -1013,6 +1024,8 @@ void CommTiled::exchange()
   }
 
   if (atom->firstgroupname) atom->first_reorder();
+
+  timer->sub_stop(comm_timer[TIME_EXCHANGE]);
 }
 
 /* ----------------------------------------------------------------------
@@ -1027,6 +1040,8 @@ void CommTiled::exchange()
 
 void CommTiled::borders()
 {
+  timer->sub_start(comm_timer[TIME_BORDERS]);
+
   int i,m,n,nlast,nsend,nrecv,ngroup,nprior,ncount,ncountall;
   double xlo,xhi,ylo,yhi,zlo,zhi;
   double *bbox;
@@ -1341,6 +1356,8 @@ void CommTiled::borders()
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
+
+  timer->sub_stop(comm_timer[TIME_BORDERS]);
 }
 
 /* ----------------------------------------------------------------------
@@ -28,8 +28,16 @@
 #include "update.h"
 #include "variable.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace LAMMPS_NS;
 
@@ -43,6 +51,31 @@ Dump *Dump::dumpptr;
 
 enum { ASCEND, DESCEND };
 
+/* ----------------------------------------------------------------------
+   state for dump_modify async
+   the filewriter copies the gathered snapshot into chunks and the
+     background thread formats and writes them while the run continues
+   at most one snapshot is pending, so the dump buffers and the queued
+     snapshot are the two halves of a double buffer
+------------------------------------------------------------------------- */
+
+namespace LAMMPS_NS {
+class DumpAsync {
+ public:
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable cv;
+  int busy;                                  // 1 while a snapshot is queued or being written
+  int quit;                                  // 1 when worker thread should exit
+  int nchunk;                                // # of chunks in queued snapshot
+  std::vector<std::vector<double>> chunk;    // data received from each proc of my cluster
+  std::vector<int> nchunkdata;               // # of lines or chars in each chunk
+  std::string errmsg;                        // error raised by worker thread
+
+  DumpAsync() : busy(0), quit(0), nchunk(0) {}
+};
+}    // namespace LAMMPS_NS
+
 /* ---------------------------------------------------------------------- */
 
 Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
@@ -51,7 +84,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
     nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
     idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
-    imagepbc(nullptr), irregular(nullptr)
+    imagepbc(nullptr), irregular(nullptr), async(nullptr)
 {
   MPI_Comm_rank(world, &me);
   MPI_Comm_size(world, &nprocs);
@@ -78,6 +111,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -143,6 +178,21 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // stop background writer thread
+  // owner of Dump must call async_wait() before deleting it,
+  //   since the worker calls virtual methods of derived classes
+
+  if (async) {
+    async_wait();
+    {
+      std::lock_guard<std::mutex> lock(async->mutex);
+      async->quit = 1;
+    }
+    async->cv.notify_all();
+    if (async->worker.joinable()) async->worker.join();
+    delete async;
+  }
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -202,6 +252,9 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  async_wait();
+  async_check();
+
   init_style();
 
   if (!sort_flag) {
@@ -370,6 +423,14 @@ void Dump::write()
     if (value != 0.0) return;
   }
 
+  // if writing in background, wait until previous snapshot is written
+  // must do this before file is opened or header is written
+
+  if (async_flag) {
+    async_wait();
+    async_check();
+  }
+
   // if file per timestep, open new file
   // do this after skip check, so no file is opened if skip occurs
 
@@ -491,9 +552,10 @@ void Dump::write()
           nlines /= size_one;
         } else nlines = nme;
 
-        write_data(nlines,buf);
+        if (async_flag) async_store(nlines,buf,nlines*size_one*sizeof(double));
+        else write_data(nlines,buf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -512,9 +574,10 @@ void Dump::write()
           MPI_Get_count(&status,MPI_CHAR,&nchars);
         } else nchars = nsme;
 
-        write_data(nchars,(double *) sbuf);
+        if (async_flag) async_store(nchars,sbuf,nchars);
+        else write_data(nchars,(double *) sbuf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -535,6 +598,16 @@ void Dump::write()
 
   if (refreshflag) modify->compute[irefresh]->refresh();
 
+  // if writing in background, hand snapshot to worker thread
+  // it writes the footer and closes the file for file per timestep
+  // Finish waits for it at the end of a run, see Output::finish_dumps()
+
+  if (async_flag) {
+    if (filewriter) async_submit();
+    else if (multifile) fp = nullptr;
+    return;
+  }
+
   if (filewriter && fp != nullptr) write_footer();
 
   if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
@@ -1045,6 +1118,188 @@ void Dump::balance()
   delete[] request;
 }
 
+/* ----------------------------------------------------------------------
+   threaded conversion of mybuf of doubles to one big string in sbuf
+   used by convert_string() of styles which implement convert_line()
+   each thread formats a contiguous range of lines into its own buffer,
+     then the buffers are copied into sbuf in order
+   maxline = max # of chars convert_line() writes, including trailing null
+   return # of chars in sbuf, or -1 if it would exceed MAXSMALLINT
+------------------------------------------------------------------------- */
+
+int Dump::convert_string_thr(int n, double *mybuf, int maxline)
+{
+#if defined(_OPENMP)
+  const int nthr_max = omp_get_max_threads();
+#else
+  const int nthr_max = 1;
+#endif
+  if ((int) sbuf_thr.size() < nthr_max) sbuf_thr.resize(nthr_max);
+  std::vector<bigint> nchars(nthr_max+1, 0);
+  bigint ntotal_chars = 0;
+
+#if defined(_OPENMP)
+#pragma omp parallel default(shared)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+    const int nthr = omp_get_num_threads();
+#else
+    const int tid = 0;
+    const int nthr = 1;
+#endif
+
+    const int ifrom = (int) ((bigint) tid * n / nthr);
+    const int ito = (int) ((bigint) (tid+1) * n / nthr);
+    auto &mysbuf = sbuf_thr[tid];
+
+    bigint offset = 0;
+    for (int i = ifrom; i < ito; i++) {
+      if (offset + maxline > (bigint) mysbuf.size())
+        mysbuf.resize(MAX(2*mysbuf.size(), (size_t) (offset + maxline)));
+      offset += convert_line(&mybuf[(bigint) i*size_one], &mysbuf[offset]);
+    }
+    nchars[tid+1] = offset;
+
+    // prefix sum of per-thread lengths gives offsets into sbuf
+
+#if defined(_OPENMP)
+#pragma omp barrier
+#pragma omp single
+#endif
+    {
+      for (int ithr = 0; ithr < nthr; ithr++) nchars[ithr+1] += nchars[ithr];
+      ntotal_chars = nchars[nthr];
+      if (ntotal_chars <= MAXSMALLINT && ntotal_chars > maxsbuf) {
+        maxsbuf = ntotal_chars;
+        memory->grow(sbuf,maxsbuf,"dump:sbuf");
+      }
+    }
+
+    if (ntotal_chars <= MAXSMALLINT && offset)
+      memcpy(&sbuf[nchars[tid]],mysbuf.data(),offset);
+  }
+
+  if (ntotal_chars > MAXSMALLINT) return -1;
+  return (int) ntotal_chars;
+}
+
+/* ----------------------------------------------------------------------
+   copy data received by filewriter into next chunk of async snapshot
+   n = # of lines or chars, as passed to write_data()
+------------------------------------------------------------------------- */
+
+void Dump::async_store(int n, void *data, int nbytes)
+{
+  if (!async) async = new DumpAsync;
+
+  int ichunk = async->nchunk++;
+  if ((int) async->chunk.size() < async->nchunk) {
+    async->chunk.resize(async->nchunk);
+    async->nchunkdata.resize(async->nchunk);
+  }
+
+  auto &chunk = async->chunk[ichunk];
+  chunk.resize(nbytes / sizeof(double) + 1);
+  if (nbytes) memcpy(chunk.data(), data, nbytes);
+  async->nchunkdata[ichunk] = n;
+}
+
+/* ----------------------------------------------------------------------
+   queue stored snapshot for worker thread, start thread on first use
+------------------------------------------------------------------------- */
+
+void Dump::async_submit()
+{
+  if (!async) async = new DumpAsync;
+  if (!async->worker.joinable()) async->worker = std::thread(&Dump::async_loop, this);
+
+  {
+    std::lock_guard<std::mutex> lock(async->mutex);
+    async->busy = 1;
+  }
+  async->cv.notify_all();
+}
+
+/* ----------------------------------------------------------------------
+   worker thread: write each queued snapshot until told to quit
+------------------------------------------------------------------------- */
+
+void Dump::async_loop()
+{
+  std::unique_lock<std::mutex> lock(async->mutex);
+  while (true) {
+    async->cv.wait(lock, [this] { return async->busy || async->quit; });
+    if (!async->busy) return;
+
+    lock.unlock();
+    async_write();
+    lock.lock();
+
+    async->nchunk = 0;
+    async->busy = 0;
+    async->cv.notify_all();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write queued snapshot, called by worker thread
+   does the part of write() that follows the gather, minus the error call
+------------------------------------------------------------------------- */
+
+void Dump::async_write()
+{
+  try {
+    for (int i = 0; i < async->nchunk; i++)
+      write_data(async->nchunkdata[i], async->chunk[i].data());
+    if (flush_flag && fp) fflush(fp);
+
+    if (fp != nullptr) write_footer();
+
+    if (fp && ferror(fp))
+      async->errmsg = fmt::format("Error writing dump {}: {}", id, utils::getsyserror());
+  } catch (std::exception &e) {
+    async->errmsg = fmt::format("Error writing dump {}: {}", id, e.what());
+  }
+
+  if (multifile) {
+    if (compressed) {
+      if (fp != nullptr) platform::pclose(fp);
+    } else {
+      if (fp != nullptr) fclose(fp);
+    }
+    fp = nullptr;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   block until worker thread has finished writing the pending snapshot
+   must be called before settings that affect output change,
+     and before the Dump is deleted
+------------------------------------------------------------------------- */
+
+void Dump::async_wait()
+{
+  if (!async) return;
+
+  std::unique_lock<std::mutex> lock(async->mutex);
+  async->cv.wait(lock, [this] { return !async->busy; });
+}
+
+/* ----------------------------------------------------------------------
+   report error from worker thread, must be called after async_wait()
+------------------------------------------------------------------------- */
+
+void Dump::async_check()
+{
+  if (!async || async->errmsg.empty()) return;
+
+  std::string mesg = async->errmsg;
+  async->errmsg.clear();
+  error->one(FLERR, mesg);
+}
+
 /* ----------------------------------------------------------------------
    process params common to all dumps here
    if unknown param, call modify_param specific to the dump
@@ -1054,6 +1309,10 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  // settings may be used by worker thread for pending snapshot
+
+  async_wait();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1061,6 +1320,13 @@ void Dump::modify_params(int narg, char **arg)
       append_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"balance") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify balance", error);
       if (nprocs > 1)
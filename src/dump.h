@@ -59,6 +59,9 @@ class Dump : protected Pointers {
   void modify_params(int, char **);
   virtual double memory_usage();
 
+  void async_wait();
+  void async_check();
+
  protected:
   int me, nprocs;    // proc info
 
@@ -79,6 +82,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if file is written by a background thread, 0 if not
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -141,6 +146,7 @@ class Dump : protected Pointers {
   double *buf;    // memory for atom quantities
   int maxsbuf;    // size of sbuf
   char *sbuf;     // memory for atom quantities in string format
+  std::vector<std::vector<char>> sbuf_thr;    // per-thread strings for convert_string_thr()
 
   int maxids;     // size of ids
   int maxsort;    // size of bufsort, idsort, index
@@ -155,6 +161,7 @@ class Dump : protected Pointers {
   int maxpbc;
 
   class Irregular *irregular;
+  class DumpAsync *async;    // snapshot queue and thread for async output
 
   virtual void init_style() = 0;
   virtual void openfile();
@@ -169,6 +176,11 @@ class Dump : protected Pointers {
   {
     return 0;
   }
+  virtual int convert_line(double *, char *)
+  {
+    return 0;
+  }
+  int convert_string_thr(int, double *, int);
   virtual void write_data(int, double *) = 0;
   virtual void write_footer() {}
 
@@ -186,6 +198,11 @@ class Dump : protected Pointers {
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+
+  void async_store(int, void *, int);
+  void async_submit();
+  void async_loop();
+  void async_write();
 };
 
 }    // namespace LAMMPS_NS
@@ -15,6 +15,7 @@
 #include "dump_atom.h"
 
 #include "atom.h"
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "memory.h"
@@ -38,6 +39,7 @@ DumpAtom::DumpAtom(LAMMPS *lmp, int narg, char **arg) :
   image_flag = 0;
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
   format_default = nullptr;
   key2col = { { "id", 0 }, { "type", 1 }, { "x", 2 }, { "y", 3 },
               { "z", 4 }, { "ix", 5 }, { "iy", 6 }, { "iz", 7 } };
@@ -166,6 +168,7 @@ void DumpAtom::pack(tagint *ids)
 
 int DumpAtom::convert_string(int n, double *mybuf)
 {
+  if (comm->nthreads > 1) return convert_string_thr(n,mybuf,ONELINE);
   return (this->*convert_choice)(n,mybuf);
 }
 
@@ -568,6 +571,27 @@ int DumpAtom::convert_noimage(int n, double *mybuf)
   return offset;
 }
 
+/* ----------------------------------------------------------------------
+   convert one line of mybuf to a formatted string, for convert_string_thr()
+------------------------------------------------------------------------- */
+
+int DumpAtom::convert_line(double *mybuf, char *line)
+{
+  if (image_flag)
+    return sprintf(line,format,
+                   static_cast<tagint> (mybuf[0]),
+                   static_cast<int> (mybuf[1]),
+                   mybuf[2],mybuf[3],mybuf[4],
+                   static_cast<int> (mybuf[5]),
+                   static_cast<int> (mybuf[6]),
+                   static_cast<int> (mybuf[7]));
+
+  return sprintf(line,format,
+                 static_cast<tagint> (mybuf[0]),
+                 static_cast<int> (mybuf[1]),
+                 mybuf[2],mybuf[3],mybuf[4]);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpAtom::write_binary(int n, double *mybuf)
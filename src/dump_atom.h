@@ -43,6 +43,7 @@ class DumpAtom : public Dump {
   void write_header(bigint) override;
   void pack(tagint *) override;
   int convert_string(int, double *) override;
+  int convert_line(double *, char *) override;
   void write_data(int, double *) override;
 
   void header_format_binary();
@@ -16,6 +16,7 @@
 
 #include "arg_info.h"
 #include "atom.h"
+#include "comm.h"
 #include "compute.h"
 #include "domain.h"
 #include "error.h"
@@ -87,6 +88,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   nthresh = 0;
   nthreshlast = 0;
@@ -1175,6 +1177,8 @@ void DumpCustom::pack(tagint *ids)
 
 int DumpCustom::convert_string(int n, double *mybuf)
 {
+  if (comm->nthreads > 1) return convert_string_thr(n,mybuf,nfield*ONEFIELD+2);
+
   int i,j;
 
   int offset = 0;
@@ -1204,6 +1208,27 @@ int DumpCustom::convert_string(int n, double *mybuf)
   return offset;
 }
 
+/* ----------------------------------------------------------------------
+   convert one line of mybuf to a formatted string, for convert_string_thr()
+------------------------------------------------------------------------- */
+
+int DumpCustom::convert_line(double *mybuf, char *line)
+{
+  int offset = 0;
+  for (int j = 0; j < nfield; j++) {
+    if (vtype[j] == Dump::INT)
+      offset += sprintf(&line[offset],vformat[j],static_cast<int> (mybuf[j]));
+    else if (vtype[j] == Dump::DOUBLE)
+      offset += sprintf(&line[offset],vformat[j],mybuf[j]);
+    else if (vtype[j] == Dump::STRING)
+      offset += sprintf(&line[offset],vformat[j],typenames[(int) mybuf[j]]);
+    else if (vtype[j] == Dump::BIGINT)
+      offset += sprintf(&line[offset],vformat[j],static_cast<bigint> (mybuf[j]));
+  }
+  offset += sprintf(&line[offset],"\n");
+  return offset;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustom::write_data(int n, double *mybuf)
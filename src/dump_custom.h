@@ -102,6 +102,7 @@ class DumpCustom : public Dump {
   int count() override;
   void pack(tagint *) override;
   int convert_string(int, double *) override;
+  int convert_line(double *, char *) override;
   void write_data(int, double *) override;
   double memory_usage() override;
 
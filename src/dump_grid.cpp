@@ -74,6 +74,7 @@ DumpGrid::DumpGrid(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   dimension = domain->dimension;
 
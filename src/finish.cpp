@@ -80,6 +80,10 @@ void Finish::end(int flag)
   bigint nblocal = atom->nlocal;
   MPI_Allreduce(&nblocal,&atom->natoms,1,MPI_LMP_BIGINT,MPI_SUM,world);
 
+  // dump files written in the background are complete when the run ends
+
+  output->finish_dumps();
+
   // choose flavors of statistical output
   // flag determines caller
   // flag = 0 = just loop summary
@@ -354,6 +358,10 @@ void Finish::end(int flag)
         utils::logmesg(lmp,"Other   |            | {:<10.4g} |            |  "
                        "     |{:6.2f}\n",time,time/time_loop*100.0);
     }
+
+    // hierarchical breakdown for timer export and library interface
+
+    timer->summarize(time_loop);
   }
 
 #ifdef LMP_OPENMP
@@ -27,6 +27,7 @@
 #include "neighbor.h"
 #include "pair.h"
 #include "rcb.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -34,7 +35,7 @@
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
-enum{SHIFT,BISECTION};
+enum{SHIFT,BISECTION,DIFFUSE};
 
 /* ---------------------------------------------------------------------- */
 
@@ -48,7 +49,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
   scalar_flag = 1;
   extscalar = 0;
   vector_flag = 1;
-  size_vector = 3;
+  size_vector = 4;
   extvector = 0;
   global_freq = 1;
 
@@ -62,6 +63,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   if (strcmp(arg[5],"shift") == 0) lbstyle = SHIFT;
   else if (strcmp(arg[5],"rcb") == 0) lbstyle = BISECTION;
+  else if (strcmp(arg[5],"diffuse") == 0) lbstyle = DIFFUSE;
   else error->all(FLERR,"Illegal fix balance command");
 
   int iarg = 5;
@@ -78,6 +80,14 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   } else if (lbstyle == BISECTION) {
     iarg++;
+
+  } else if (lbstyle == DIFFUSE) {
+    if (iarg+3 > narg) error->all(FLERR,"Illegal fix balance command");
+    nitermax = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+    if (nitermax <= 0) error->all(FLERR,"Illegal fix balance command");
+    stopthresh = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+    if (stopthresh < 1.0) error->all(FLERR,"Illegal fix balance command");
+    iarg += 3;
   }
 
   // error checks
@@ -97,13 +107,16 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   if (lbstyle == BISECTION && comm->style == Comm::BRICK)
     error->all(FLERR,"Fix balance rcb cannot be used with comm_style brick");
+  if (lbstyle == DIFFUSE && comm->style == Comm::BRICK)
+    error->all(FLERR,"Fix balance diffuse cannot be used with comm_style brick");
 
   // create instance of Balance class
-  // if SHIFT, initialize it with params
+  // if SHIFT or DIFFUSE, initialize it with params
   // process remaining optional args via Balance
 
   balance = new Balance(lmp);
   if (lbstyle == SHIFT) balance->shift_setup(bstr,nitermax,thresh);
+  if (lbstyle == DIFFUSE) balance->diffuse_setup(nitermax,stopthresh);
   balance->options(iarg,narg,arg,0);
   wtflag = balance->wtflag;
   sortflag = balance->sortflag;
@@ -125,7 +138,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   itercount = 0;
   pending = 0;
-  imbfinal = imbprev = maxloadperproc = 0.0;
+  imbfinal = imbprev = imbmeasured = maxloadperproc = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -158,6 +171,10 @@ void FixBalance::post_constructor()
 void FixBalance::init()
 {
   balance->init_imbalance(1);
+
+  // timers are reset at the start of each run
+
+  lasttime = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -226,6 +243,10 @@ void FixBalance::pre_exchange()
   domain->reset_box();
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
 
+  // measured imbalance of force computation since last balance check
+
+  measure_imbalance();
+
   // perform a rebalance if threshold exceeded
   // if weight variable is used, wrap weight setting in clear/add compute
 
@@ -267,6 +288,8 @@ void FixBalance::rebalance()
 
   // invoke balancer and reset comm->uniform flag
 
+  // DIFFUSE needs an RCB tiling to start from, so the first rebalance is RCB
+
   int *sendproc;
   if (lbstyle == SHIFT) {
     itercount = balance->shift();
@@ -274,6 +297,10 @@ void FixBalance::rebalance()
   } else if (lbstyle == BISECTION) {
     sendproc = balance->bisection();
     comm->layout = Comm::LAYOUT_TILED;
+  } else if (lbstyle == DIFFUSE) {
+    if (comm->layout == Comm::LAYOUT_TILED) sendproc = balance->diffuse(itercount);
+    else sendproc = balance->bisection();
+    comm->layout = Comm::LAYOUT_TILED;
   }
 
   // reset proc sub-domains
@@ -291,7 +318,7 @@ void FixBalance::rebalance()
   if (balance->outflag) balance->dumpout(update->ntimestep);
 
   // move atoms to new processors via irregular()
-  // for non-RCB only needed if migrate_check() says an atom moves too far
+  // for SHIFT only needed if migrate_check() says an atom moves too far
   // else allow caller's comm->exchange() to do it
   // set disable = 0, so weights migrate with atoms
   //   important to delay disable = 1 until after pre_neighbor imbfinal calc
@@ -302,7 +329,7 @@ void FixBalance::rebalance()
 
   if (domain->triclinic) domain->x2lamda(atom->nlocal);
   if (wtflag) balance->fixstore->disable = 0;
-  if (lbstyle == BISECTION) irregular->migrate_atoms(sortflag,1,sendproc);
+  if (lbstyle == BISECTION || lbstyle == DIFFUSE) irregular->migrate_atoms(sortflag,1,sendproc);
   else if (irregular->migrate_check()) irregular->migrate_atoms(sortflag);
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
 
@@ -319,6 +346,27 @@ void FixBalance::rebalance()
   pending = 1;
 }
 
+/* ----------------------------------------------------------------------
+   measure achieved imbalance as max/ave time per proc spent in
+     force computation and neighbor list builds since the last call
+   unchanged if timers are not available or no time was tallied
+------------------------------------------------------------------------- */
+
+void FixBalance::measure_imbalance()
+{
+  if (!timer->has_normal()) return;
+
+  double now = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH) +
+    timer->get_wall(Timer::BOND) + timer->get_wall(Timer::KSPACE);
+  double cost = now - lasttime;
+  lasttime = now;
+
+  double maxcost,totalcost;
+  MPI_Allreduce(&cost,&maxcost,1,MPI_DOUBLE,MPI_MAX,world);
+  MPI_Allreduce(&cost,&totalcost,1,MPI_DOUBLE,MPI_SUM,world);
+  if (totalcost > 0.0) imbmeasured = maxcost / (totalcost/comm->nprocs);
+}
+
 /* ----------------------------------------------------------------------
    return imbalance factor after last rebalance
 ------------------------------------------------------------------------- */
@@ -336,7 +384,8 @@ double FixBalance::compute_vector(int i)
 {
   if (i == 0) return maxloadperproc;
   if (i == 1) return (double) itercount;
-  return imbprev;
+  if (i == 2) return imbprev;
+  return imbmeasured;
 }
 
 /* ----------------------------------------------------------------------
@@ -49,6 +49,8 @@ class FixBalance : public Fix {
   double imbnow;            // current imbalance factor
   double imbprev;           // imbalance factor before last rebalancing
   double imbfinal;          // imbalance factor after last rebalancing
+  double imbmeasured;       // measured imbalance of force time since last check
+  double lasttime;          // accumulated force time at last check
   double maxloadperproc;    // max load on any processor
   int itercount;            // iteration count of last call to Balance
   int pending;
@@ -58,6 +60,7 @@ class FixBalance : public Fix {
   class Irregular *irregular;
 
   void rebalance();
+  void measure_imbalance();
 };
 
 }    // namespace LAMMPS_NS
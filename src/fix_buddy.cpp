@@ -0,0 +1,321 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_buddy.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "error.h"
+#include "memory.h"
+#include "modify.h"
+#include "update.h"
+#include "write_restart.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixBuddy::FixBuddy(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg), write_every(1), offset(-1), ncheckpoint(0), stamp(-1),
+  mine(nullptr), copy(nullptr), nmine(0), ncopy(0), maxmine(0), maxcopy(0), restart(nullptr)
+{
+  if (narg < 5) utils::missing_cmd_args(FLERR, "fix buddy", error);
+
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix buddy nevery value {}", nevery);
+
+  // per-proc files are read back as a multiproc restart
+
+  filename = arg[4];
+  if (filename.find('%') == std::string::npos)
+    error->all(FLERR,"Fix buddy file name {} must contain '%'", filename);
+
+  int copy_all = 0;
+  int iarg = 5;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"write") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix buddy write", error);
+      write_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (write_every <= 0) error->all(FLERR,"Illegal fix buddy write value {}", write_every);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"offset") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix buddy offset", error);
+      offset = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if ((offset < 0) || (offset >= nprocs))
+        error->all(FLERR,"Illegal fix buddy offset value {}", offset);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"copy") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "fix buddy copy", error);
+      if (strcmp(arg[iarg+1],"remote") == 0) copy_all = 0;
+      else if (strcmp(arg[iarg+1],"all") == 0) copy_all = 1;
+      else error->all(FLERR,"Unknown fix buddy copy value: {}", arg[iarg+1]);
+      iarg += 2;
+    } else error->all(FLERR,"Unknown fix buddy keyword: {}", arg[iarg]);
+  }
+
+  // node of each proc, so copies can be kept on another node
+
+  char name[MPI_MAX_PROCESSOR_NAME];
+  int len;
+  memset(name,0,MPI_MAX_PROCESSOR_NAME);
+  MPI_Get_processor_name(name,&len);
+  std::vector<char> allnames(nprocs*MPI_MAX_PROCESSOR_NAME);
+  MPI_Allgather(name,MPI_MAX_PROCESSOR_NAME,MPI_CHAR,allnames.data(),MPI_MAX_PROCESSOR_NAME,
+                MPI_CHAR,world);
+
+  std::vector<std::string> node(nprocs);
+  std::map<std::string,int> pernode;
+  int maxpernode = 0;
+  for (int i = 0; i < nprocs; i++) {
+    node[i] = std::string(&allnames[i*MPI_MAX_PROCESSOR_NAME]);
+    maxpernode = MAX(maxpernode,++pernode[node[i]]);
+  }
+
+  // default offset skips the procs of one node, assuming procs are placed by node
+  // with a single node the copy is kept on the next proc
+
+  if (offset < 0) {
+    offset = maxpernode;
+    if (offset >= nprocs) offset = (nprocs > 1) ? 1 : 0;
+  }
+
+  partner = (me + offset) % nprocs;
+  source = (me - offset + nprocs) % nprocs;
+  partner0 = offset % nprocs;
+  copy_remote = (copy_all || (node[source] != node[me])) ? 1 : 0;
+  base_remote = (copy_all || (node[partner0] != node[0])) ? 1 : 0;
+
+  if (me == 0) {
+    int nsame = 0;
+    for (int i = 0; i < nprocs; i++)
+      if (node[i] == node[(i + offset) % nprocs]) nsame++;
+    if (offset == 0)
+      error->warning(FLERR,"Fix buddy keeps no copies on other procs");
+    else if (nsame)
+      error->warning(FLERR,"Fix buddy keeps copies of {} procs on the same node", nsame);
+  }
+
+  restart = new WriteRestart(lmp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixBuddy::~FixBuddy()
+{
+  if (writer.joinable()) writer.join();
+  delete restart;
+  memory->destroy(mine);
+  memory->destroy(copy);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixBuddy::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  mask |= POST_RUN;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixBuddy::init()
+{
+  if (lmp->kokkos) error->all(FLERR,"Fix buddy is not yet supported with KOKKOS");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixBuddy::end_of_step()
+{
+  checkpoint();
+}
+
+/* ----------------------------------------------------------------------
+   files of the last checkpoint are complete after a run
+------------------------------------------------------------------------- */
+
+void FixBuddy::post_run()
+{
+  finish_write();
+}
+
+/* ----------------------------------------------------------------------
+   pack my atoms as for a restart file and keep a copy on partner
+   proc 0 keeps the base file in memory, with a copy on partner0
+   files are written by a background thread every write_every checkpoints
+------------------------------------------------------------------------- */
+
+void FixBuddy::checkpoint()
+{
+  finish_write();
+
+  AtomVec *avec = atom->avec;
+  nmine = avec->size_restart();
+  if (nmine > maxmine) {
+    maxmine = nmine;
+    memory->destroy(mine);
+    memory->create(mine,maxmine,"buddy:mine");
+  }
+
+  int n = 0;
+  for (int i = 0; i < atom->nlocal; i++) n += avec->pack_restart(i,&mine[n]);
+  if (modify->restart_pbc_any) restart->remap_pbc(mine);
+
+  // base file is written into memory by proc 0
+
+  FILE *fp = nullptr;
+#if defined(_WIN32)
+  if (me == 0) fp = tmpfile();
+#else
+  char *ptr = nullptr;
+  size_t len = 0;
+  if (me == 0) fp = open_memstream(&ptr,&len);
+#endif
+  if ((me == 0) && !fp)
+    error->one(FLERR,"Cannot create fix buddy base file buffer: {}", utils::getsyserror());
+
+  restart->write_base(fp,nprocs);
+
+  if (me == 0) {
+#if defined(_WIN32)
+    fflush(fp);
+    base.resize(ftell(fp));
+    rewind(fp);
+    if (fread(&base[0],1,base.size(),fp) != base.size())
+      error->one(FLERR,"I/O error while creating fix buddy base file");
+    fclose(fp);
+#else
+    fclose(fp);
+    base.assign(ptr,len);
+    free(ptr);
+#endif
+  }
+
+  // exchange sizes, then packed atoms with my partner and source
+
+  if (offset) {
+    MPI_Sendrecv(&nmine,1,MPI_INT,partner,0,&ncopy,1,MPI_INT,source,0,world,MPI_STATUS_IGNORE);
+    if (ncopy > maxcopy) {
+      maxcopy = ncopy;
+      memory->destroy(copy);
+      memory->create(copy,maxcopy,"buddy:copy");
+    }
+    MPI_Sendrecv(mine,nmine,MPI_DOUBLE,partner,0,copy,ncopy,MPI_DOUBLE,source,0,world,
+                 MPI_STATUS_IGNORE);
+
+    int nbase = base.size();
+    if (me == 0) {
+      MPI_Send(&nbase,1,MPI_INT,partner0,0,world);
+      MPI_Send(&base[0],nbase,MPI_CHAR,partner0,0,world);
+    } else if (me == partner0) {
+      MPI_Recv(&nbase,1,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+      base.resize(nbase);
+      MPI_Recv(&base[0],nbase,MPI_CHAR,0,0,world,MPI_STATUS_IGNORE);
+    }
+  }
+
+  stamp = update->ntimestep;
+  ncheckpoint++;
+  if (ncheckpoint % write_every == 0) writer = std::thread(&FixBuddy::write_files,this);
+}
+
+/* ----------------------------------------------------------------------
+   write files of last checkpoint, runs in the writer thread
+   every proc writes its own file and the one of source if on another node
+   so the files of all procs survive the loss of a single node
+------------------------------------------------------------------------- */
+
+void FixBuddy::write_files()
+{
+  std::string name = utils::star_subst(filename,stamp,0);
+  std::size_t found = name.find('%');
+  std::string prefix = name.substr(0,found);
+  std::string suffix = name.substr(found+1);
+
+  write_file(fmt::format("{}{}{}",prefix,me,suffix),nmine,mine,nullptr);
+  if (offset && copy_remote)
+    write_file(fmt::format("{}{}{}",prefix,source,suffix),ncopy,copy,nullptr);
+  if ((me == 0) || (offset && base_remote && (me == partner0)))
+    write_file(prefix + "base" + suffix,0,nullptr,&base);
+}
+
+/* ----------------------------------------------------------------------
+   write one file under a temporary name, then rename it
+   so an interrupted write does not destroy the file of an earlier checkpoint
+   errors are reported by the main thread in finish_write()
+------------------------------------------------------------------------- */
+
+void FixBuddy::write_file(const std::string &file, int n, double *buf, const std::string *bytes)
+{
+  if (!write_error.empty()) return;
+
+  std::string tmpname = file + ".tmp";
+  FILE *fp = fopen(tmpname.c_str(),"wb");
+  if (fp == nullptr) {
+    write_error = fmt::format("Cannot open fix buddy file {}: {}",tmpname,utils::getsyserror());
+    return;
+  }
+
+  if (bytes) fwrite(bytes->data(),sizeof(char),bytes->size(),fp);
+  else restart->write_perproc(fp,n,buf);
+
+  int io_error = ferror(fp);
+  if (fclose(fp)) io_error = 1;
+  if (io_error) {
+    write_error = fmt::format("I/O error while writing fix buddy file {}",tmpname);
+    return;
+  }
+
+#if defined(_WIN32)
+  platform::unlink(file);
+#endif
+  if (rename(tmpname.c_str(),file.c_str()))
+    write_error = fmt::format("Cannot rename fix buddy file {} to {}: {}",tmpname,file,
+                              utils::getsyserror());
+}
+
+/* ----------------------------------------------------------------------
+   wait for writer thread of previous checkpoint
+------------------------------------------------------------------------- */
+
+void FixBuddy::finish_write()
+{
+  if (writer.joinable()) writer.join();
+  if (!write_error.empty()) {
+    std::string mesg = write_error;
+    write_error.clear();
+    error->one(FLERR,mesg);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixBuddy::memory_usage()
+{
+  double bytes = (double)maxmine * sizeof(double);
+  bytes += (double)maxcopy * sizeof(double);
+  bytes += (double)base.capacity();
+  return bytes;
+}
@@ -0,0 +1,68 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(buddy,FixBuddy);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_BUDDY_H
+#define LMP_FIX_BUDDY_H
+
+#include "fix.h"
+
+#include <thread>
+
+namespace LAMMPS_NS {
+
+class FixBuddy : public Fix {
+ public:
+  FixBuddy(class LAMMPS *, int, char **);
+  ~FixBuddy() override;
+  int setmask() override;
+  void init() override;
+  void end_of_step() override;
+  void post_run() override;
+  double memory_usage() override;
+
+ private:
+  int me, nprocs;
+  std::string filename;    // per-proc file name with '%' and optional '*'
+  int write_every;         // write files every this many checkpoints
+  int offset;              // partner = me + offset, 0 = no copy on another proc
+  int partner, source;     // proc holding my copy, proc whose copy I hold
+  int partner0;            // proc holding the copy of the base file
+  int copy_remote;         // 1 if source is on another node than me or copy all
+  int base_remote;         // 1 if partner0 is on another node than proc 0 or copy all
+  bigint ncheckpoint;      // # of checkpoints taken
+  bigint stamp;            // timestep of last checkpoint
+
+  double *mine, *copy;     // packed atoms of me and of source
+  int nmine, ncopy, maxmine, maxcopy;
+  std::string base;        // base file of last checkpoint on proc 0 and partner0
+
+  class WriteRestart *restart;
+  std::thread writer;        // background thread writing files of last checkpoint
+  std::string write_error;   // error message from writer thread
+
+  void checkpoint();
+  void write_files();
+  void finish_write();
+  void write_file(const std::string &, int, double *, const std::string *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -0,0 +1,168 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "imbalance_cost.h"
+
+#include "accelerator_kokkos.h"
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "pair.h"
+
+using namespace LAMMPS_NS;
+
+#define BIG 1.0e20
+#define MINCOST 0.1
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCost::ImbalanceCost(LAMMPS *lmp) : Imbalance(lmp), costfactor(nullptr)
+{
+  factor = 1.0;
+  npair = 0;
+  did_warn = 0;
+}
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCost::~ImbalanceCost()
+{
+  memory->destroy(costfactor);
+}
+
+/* -------------------------------------------------------------------- */
+
+int ImbalanceCost::options(int narg, char **arg)
+{
+  if (narg < 2) error->all(FLERR, "Illegal balance weight command");
+  factor = utils::numeric(FLERR, arg[0], false, lmp);
+  if (factor <= 0.0) error->all(FLERR, "Illegal balance weight command");
+  npair = utils::inumeric(FLERR, arg[1], false, lmp);
+  if ((npair < 0) || (narg < 2 + 3 * npair)) error->all(FLERR, "Illegal balance weight command");
+
+  const int ntypes = atom->ntypes;
+  memory->create(costfactor, ntypes + 1, ntypes + 1, "imbalance:costfactor");
+  for (int i = 0; i <= ntypes; i++)
+    for (int j = 0; j <= ntypes; j++) costfactor[i][j] = 1.0;
+
+  // later entries override earlier ones, cost of I,J is the same as of J,I
+
+  int ilo, ihi, jlo, jhi;
+  for (int n = 0; n < npair; n++) {
+    utils::bounds(FLERR, arg[2 + 3 * n], 1, ntypes, ilo, ihi, error);
+    utils::bounds(FLERR, arg[3 + 3 * n], 1, ntypes, jlo, jhi, error);
+    double value = utils::numeric(FLERR, arg[4 + 3 * n], false, lmp);
+    if (value < 0.0) error->all(FLERR, "Illegal balance weight command");
+    for (int i = ilo; i <= ihi; i++)
+      for (int j = jlo; j <= jhi; j++) costfactor[i][j] = costfactor[j][i] = value;
+  }
+
+  init(0);
+  return 2 + 3 * npair;
+}
+
+/* -------------------------------------------------------------------- */
+
+void ImbalanceCost::init(int /*flag*/)
+{
+  if (!force->pair) error->all(FLERR, "Balance weight cost requires a pair style");
+
+  // let the pair style measure sub-style timings for the next estimate
+
+  force->pair->cost_flag = 1;
+}
+
+/* -------------------------------------------------------------------- */
+
+void ImbalanceCost::compute(double *weight)
+{
+  // cannot access neighbor lists with KOKKOS using GPUs
+
+  if (lmp->kokkos && lmp->kokkos->kokkos_exists) {
+    if (lmp->kokkos->ngpus > 0) {
+      if (comm->me == 0 && !did_warn)
+        error->warning(FLERR, "Balance weight cost skipped with KOKKOS using GPUs");
+      did_warn = 1;
+      return;
+    }
+  }
+
+  const int nlocal = atom->nlocal;
+  double *cost;
+  memory->create(cost, nlocal + 1, "imbalance:cost");
+  for (int i = 0; i < nlocal; i++) cost[i] = 0.0;
+
+  int flag = force->pair->atom_cost(costfactor, cost);
+  int flagall;
+  MPI_Allreduce(&flag, &flagall, 1, MPI_INT, MPI_MIN, world);
+  if (!flagall) {
+    if (comm->me == 0 && !did_warn)
+      error->warning(FLERR, "Balance weight cost skipped b/c no current neighbor list");
+    did_warn = 1;
+    memory->destroy(cost);
+    return;
+  }
+
+  // normalize by global average cost per atom
+  // atoms without interactions still have a cost for integration and communication
+
+  double mysum[2], allsum[2];
+  mysum[0] = mysum[1] = 0.0;
+  for (int i = 0; i < nlocal; i++) mysum[0] += cost[i];
+  mysum[1] = nlocal;
+  MPI_Allreduce(mysum, allsum, 2, MPI_DOUBLE, MPI_SUM, world);
+  if (allsum[0] <= 0.0) {
+    memory->destroy(cost);
+    return;
+  }
+
+  const double avg = allsum[0] / allsum[1];
+  for (int i = 0; i < nlocal; i++) cost[i] = MAX(cost[i] / avg, MINCOST);
+
+  // apply factor if specified != 1.0
+  // wtlo,wthi = lo/hi values of all atoms
+  // lo value does not change
+  // newhi = new hi value to give hi/lo ratio factor times larger/smaller
+  // expand/contract all values from lo->hi to lo->newhi
+
+  if (factor != 1.0) {
+    double mylo = BIG, myhi = 0.0;
+    for (int i = 0; i < nlocal; i++) {
+      mylo = MIN(mylo, cost[i]);
+      myhi = MAX(myhi, cost[i]);
+    }
+    double wtlo, wthi;
+    MPI_Allreduce(&mylo, &wtlo, 1, MPI_DOUBLE, MPI_MIN, world);
+    MPI_Allreduce(&myhi, &wthi, 1, MPI_DOUBLE, MPI_MAX, world);
+    if (wtlo < wthi) {
+      double newhi = wthi * factor;
+      for (int i = 0; i < nlocal; i++)
+        cost[i] = wtlo + ((cost[i] - wtlo) / (wthi - wtlo)) * (newhi - wtlo);
+    }
+  }
+
+  for (int i = 0; i < nlocal; i++) weight[i] *= cost[i];
+
+  memory->destroy(cost);
+}
+
+/* -------------------------------------------------------------------- */
+
+std::string ImbalanceCost::info()
+{
+  std::string mesg = fmt::format("  pair cost weight factor: {}\n", factor);
+  if (npair) mesg += fmt::format("  explicit type pair cost factors: {}\n", npair);
+  return mesg;
+}
@@ -34,6 +34,7 @@
 #include "group.h"
 #include "improper.h"
 #include "input.h"
+#include "memory.h"
 #include "modify.h"
 #include "neighbor.h"
 #include "output.h"
@@ -97,6 +98,7 @@ enum {COMPUTES=1<<0,
       DUMP_STYLES=1<<24,
       COMMAND_STYLES=1<<25,
       ACCELERATOR=1<<26,
+      MEMORY_TRACE=1<<27,
       ALL=~0};
 
 static const int STYLES = ATOM_STYLES | INTEGRATE_STYLES | MINIMIZE_STYLES
@@ -194,6 +196,10 @@ void Info::command(int narg, char **arg)
     } else if (strncmp(arg[idx],"memory",3) == 0) {
       flags |= MEMORY;
       ++idx;
+      if ((idx < narg) && (strcmp(arg[idx],"trace") == 0)) {
+        flags |= MEMORY_TRACE;
+        ++idx;
+      }
     } else if (strncmp(arg[idx],"variables",3) == 0) {
       flags |= VARIABLES;
       ++idx;
@@ -349,6 +355,8 @@ void Info::command(int narg, char **arg)
 #endif
     fmt::print(out,"Maximum resident set size: {:.4} Mbyte\n",meminfo[2]);
 #endif
+    fputs(memory->pool_info().c_str(),out);
+    if (flags & MEMORY_TRACE) fputs(memory->trace_info().c_str(),out);
   }
 
   if (flags & COMM) {
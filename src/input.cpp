@@ -794,6 +794,7 @@ int Input::execute_command()
   else if (mycmd == "labelmap") labelmap();
   else if (mycmd == "lattice") lattice();
   else if (mycmd == "mass") mass();
+  else if (mycmd == "memory") memory_command();
   else if (mycmd == "min_modify") min_modify();
   else if (mycmd == "min_style") min_style();
   else if (mycmd == "molecule") molecule();
@@ -1613,6 +1614,13 @@ void Input::mass()
 
 /* ---------------------------------------------------------------------- */
 
+void Input::memory_command()
+{
+  memory->modify_params(narg,arg);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Input::min_modify()
 {
   update->minimize->modify_params(narg,arg);
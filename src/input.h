@@ -116,6 +116,7 @@ class Input : protected Pointers {
   void labelmap();
   void lattice();
   void mass();
+  void memory_command();
   void min_modify();
   void min_style();
   void molecule();
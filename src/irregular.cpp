@@ -63,6 +63,15 @@ Irregular::Irregular(LAMMPS *lmp) : Pointers(lmp)
   maxbuf = 0;
   buf = nullptr;
 
+  // plan vectors, these persist for multiple irregular operations
+
+  maxsend_proc = maxrecv_proc = maxindex = maxself = 0;
+  proc_send = length_send = num_send = nullptr;
+  proc_recv = length_recv = num_recv = nullptr;
+  index_send = offset_send = index_self = nullptr;
+  request = nullptr;
+  status = nullptr;
+
   // universal work vectors
 
   memory->create(work1,nprocs,"irregular:work1");
@@ -90,6 +99,18 @@ Irregular::~Irregular()
   memory->destroy(work2);
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  memory->destroy(proc_send);
+  memory->destroy(length_send);
+  memory->destroy(num_send);
+  memory->destroy(proc_recv);
+  memory->destroy(length_recv);
+  memory->destroy(num_recv);
+  memory->destroy(index_send);
+  memory->destroy(offset_send);
+  memory->destroy(index_self);
+  delete[] request;
+  delete[] status;
 }
 
 /* ----------------------------------------------------------------------
@@ -204,7 +225,6 @@ void Irregular::migrate_atoms(int sortflag, int preassign, int *procassign)
   int nrecv = create_atom(nsendatom,msizes,mproclist,sortflag);
   if (nrecv > maxrecv) grow_recv(nrecv);
   exchange_atom(buf_send,msizes,buf_recv);
-  destroy_atom();
 
   // add received atoms to my list
 
@@ -337,10 +357,7 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
 
   // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  length_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+  grow_plan_recv(nrecv_proc);
 
   // nsend_proc = # of messages I send
 
@@ -353,11 +370,7 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
 
   // allocate send arrays
 
-  proc_send = new int[nsend_proc];
-  length_send = new int[nsend_proc];
-  num_send = new int[nsend_proc];
-  index_send = new int[n];
-  offset_send = new int[n];
+  grow_plan_send(nsend_proc,n,0);
 
   // list still stores size of message for procs I send to
   // proc_send = procs I send to
@@ -552,23 +565,6 @@ void Irregular::exchange_atom(double *sendbuf, int *sizes, double *recvbuf)
   if (nrecv_proc) MPI_Waitall(nrecv_proc,request,status);
 }
 
-/* ----------------------------------------------------------------------
-   destroy vectors in communication plan for atoms
-------------------------------------------------------------------------- */
-
-void Irregular::destroy_atom()
-{
-  delete [] proc_send;
-  delete [] length_send;
-  delete [] num_send;
-  delete [] index_send;
-  delete [] offset_send;
-  delete [] proc_recv;
-  delete [] length_recv;
-  delete [] request;
-  delete [] status;
-}
-
 /* ----------------------------------------------------------------------
    create communication plan based on list of datums of uniform size
    n = # of datums to send
@@ -610,10 +606,7 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
 
   // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  num_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+  grow_plan_recv(nrecv_proc);
 
   // work1 = # of datums I send to each proc, including self
   // nsend_proc = # of procs I send messages to, not including self
@@ -628,11 +621,7 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
 
   // allocate send and self arrays
 
-  proc_send = new int[nsend_proc];
-  num_send = new int[nsend_proc];
-  index_send = new int[n-work1[me]];
-  index_self = new int[work1[me]];
-  maxindex = n;
+  grow_plan_send(nsend_proc,n-work1[me],work1[me]);
 
   // proc_send = procs I send to
   // num_send = # of datums I send to each proc
@@ -782,10 +771,7 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
 
   // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  num_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+  grow_plan_recv(nrecv_proc);
 
   // work1 = # of datums I send to each proc, including self
   // nsend_proc = # of procs I send messages to, not including self
@@ -799,11 +785,7 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
 
   // allocate send and self arrays
 
-  proc_send = new int[nsend_proc];
-  num_send = new int[nsend_proc];
-  index_send = new int[n-work1[me]];
-  index_self = new int[work1[me]];
-  maxindex = n;
+  grow_plan_send(nsend_proc,n-work1[me],work1[me]);
 
   // proc_send = procs I send to
   // num_send = # of datums I send to each proc
@@ -976,19 +958,68 @@ void Irregular::exchange_data(char *sendbuf, int nbytes, char *recvbuf)
 }
 
 /* ----------------------------------------------------------------------
-   destroy vectors in communication plan for datums
+   end use of communication plan for datums
+   plan vectors are kept for the next plan, so nothing is freed here
+------------------------------------------------------------------------- */
+
+void Irregular::destroy_data() {}
+
+/* ----------------------------------------------------------------------
+   grow vectors of communication plan for nrecv procs to recv from
+   these persist, so that a plan in steady state does no allocation
+------------------------------------------------------------------------- */
+
+void Irregular::grow_plan_recv(int nrecv)
+{
+  if (nrecv <= maxrecv_proc) return;
+  maxrecv_proc = nrecv;
+
+  memory->destroy(proc_recv);
+  memory->destroy(length_recv);
+  memory->destroy(num_recv);
+  memory->create(proc_recv,maxrecv_proc,"irregular:proc_recv");
+  memory->create(length_recv,maxrecv_proc,"irregular:length_recv");
+  memory->create(num_recv,maxrecv_proc,"irregular:num_recv");
+
+  // MPI_Request may be a pointer, which memory->create() does not allow
+
+  delete[] request;
+  delete[] status;
+  request = new MPI_Request[maxrecv_proc];
+  status = new MPI_Status[maxrecv_proc];
+}
+
+/* ----------------------------------------------------------------------
+   grow vectors of communication plan for nsend procs to send to,
+     nindex atoms/datums to send and nself datums to copy to self
+   index vectors get extra room, since their length varies with each plan
 ------------------------------------------------------------------------- */
 
-void Irregular::destroy_data()
+void Irregular::grow_plan_send(int nsend, int nindex, int nself)
 {
-  delete [] proc_send;
-  delete [] num_send;
-  delete [] index_send;
-  delete [] proc_recv;
-  delete [] num_recv;
-  delete [] index_self;
-  delete [] request;
-  delete [] status;
+  if (nsend > maxsend_proc) {
+    maxsend_proc = nsend;
+    memory->destroy(proc_send);
+    memory->destroy(length_send);
+    memory->destroy(num_send);
+    memory->create(proc_send,maxsend_proc,"irregular:proc_send");
+    memory->create(length_send,maxsend_proc,"irregular:length_send");
+    memory->create(num_send,maxsend_proc,"irregular:num_send");
+  }
+
+  if (nindex > maxindex) {
+    maxindex = static_cast<int> (BUFFACTOR * nindex);
+    memory->destroy(index_send);
+    memory->destroy(offset_send);
+    memory->create(index_send,maxindex,"irregular:index_send");
+    memory->create(offset_send,maxindex,"irregular:offset_send");
+  }
+
+  if (nself > maxself) {
+    maxself = static_cast<int> (BUFFACTOR * nself);
+    memory->destroy(index_self);
+    memory->create(index_self,maxself,"irregular:index_self");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -48,7 +48,6 @@ class Irregular : protected Pointers {
   double *dbuf;                   // double buf for largest single atom send
   int maxbuf;                     // size of char buf in bytes
   char *buf;                      // char buf for largest single data send
-  int maxindex;                   // combined size of index_send + index_self
 
   int *mproclist, *msizes;    // persistent vectors in migrate_atoms
   int maxlocal;               // allocated size of mproclist and msizes
@@ -68,6 +67,11 @@ class Irregular : protected Pointers {
   MPI_Request *request;    // MPI requests for posted recvs
   MPI_Status *status;      // MPI statuses for WaitAll
 
+  int maxsend_proc;    // allocated size of per-proc send vectors
+  int maxrecv_proc;    // allocated size of per-proc recv vectors, request, status
+  int maxindex;        // allocated size of index_send and offset_send
+  int maxself;         // allocated size of index_self
+
   // extra plan params plan for irregular communication of atoms
   // no params refer to atoms copied to self
 
@@ -86,13 +90,14 @@ class Irregular : protected Pointers {
 
   int create_atom(int, int *, int *, int);
   void exchange_atom(double *, int *, double *);
-  void destroy_atom();
 
   int binary(double, int, double *);
 
   void init_exchange();        // reset bufxtra
   void grow_send(int, int);    // reallocate send buffer
   void grow_recv(int);         // free/allocate recv buffer
+  void grow_plan_recv(int);
+  void grow_plan_send(int, int, int);
 };
 
 }    // namespace LAMMPS_NS
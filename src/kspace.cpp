@@ -43,6 +43,8 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   ewaldflag = pppmflag = msmflag = dispersionflag = tip4pflag =
     dipoleflag = spinflag = 0;
   compute_flag = 1;
+  mts_every = 1;
+  mts_extrapolate = 0;
   group_group_enable = 0;
   stagger_flag = 0;
 
@@ -52,6 +54,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   minorder = 2;
   overlap_allowed = 1;
   fftbench = 0;
+  autotune = 0;
 
   // default to using MPI collectives for FFT/remap only on IBM BlueGene
 
@@ -61,6 +64,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   collective_flag = 0;
 #endif
 
+  halo_flag = 0;
   kewaldflag = 0;
 
   order_6 = 5;
@@ -541,6 +545,24 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       compute_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"every") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      mts_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (mts_every <= 0) error->all(FLERR,"Kspace_modify every value must be > 0");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"mts") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"impulse") == 0) mts_extrapolate = 0;
+      else if (strcmp(arg[iarg+1],"extrapolate") == 0) mts_extrapolate = 1;
+      else error->all(FLERR,"Illegal kspace_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"autotune") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"no") == 0) autotune = 0;
+      else if (strcmp(arg[iarg+1],"yes") == 0) autotune = 5;
+      else autotune = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (autotune < 0) error->all(FLERR,"Illegal kspace_modify autotune value");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"fftbench") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       fftbench = utils::logical(FLERR,arg[iarg+1],false,lmp);
@@ -549,6 +571,16 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"halo") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"double") == 0) halo_flag = 0;
+      else if (strcmp(arg[iarg+1],"single") == 0) halo_flag = 1;
+      else error->all(FLERR,"Illegal kspace_modify command");
+      // only PPPM::compute() sends ghost grid values in single precision
+      if (halo_flag && strcmp(force->kspace_style,"pppm") && strcmp(force->kspace_style,"pppm/omp"))
+        error->all(FLERR,"Kspace_modify halo single is not supported by kspace style {}",
+                   force->kspace_style);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"ad") == 0) differentiation_flag = 1;
@@ -94,8 +94,12 @@ class KSpace : protected Pointers {
   int copymode;
 
   int compute_flag;       // 0 if skip compute()
+  int mts_every;          // invoke compute() every this many steps with run_style verlet
+  int mts_extrapolate;    // 1 if extrapolate forces between invocations, 0 if impulse
   int fftbench;           // 0 if skip FFT timing
+  int autotune;           // # of timed compute() per candidate for PPPM tuning, 0 if none
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int halo_flag;          // 1 if exchange PPPM ghost grid values in single precision
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -1049,6 +1049,54 @@ int lammps_get_mpi_comm(void *handle)
 
 /* ---------------------------------------------------------------------- */
 
+/** Get timing breakdown of the last run as JSON text
+ *
+\verbatim embed:rst
+
+.. versionadded:: TBD
+
+This function copies the timing breakdown of the most recent run or
+minimization into the *buffer* as a JSON formatted, 0-terminated string.
+The data contains the min/avg/max time across MPI ranks for each timer
+section and, with :doc:`timer full <timer>`, for each fix and callback,
+pair style :doc:`hybrid <pair_hybrid>` sub-style and communication
+operation.  It is the same data that is written with the *export*
+keyword of the :doc:`timer command <timer>` and is only available if the
+run was performed with the timer set to *normal* or *full* and the
+run summary was not turned off with :doc:`run post no <run>`.  The text
+is truncated if the buffer is too small, but the function always returns
+the full length, so that a larger buffer may be allocated for another
+call.  With a NULL *buffer* or a *buf_size* of 0 only the length is
+returned.
+
+\endverbatim
+ *
+ * \param  handle    pointer to a previously created LAMMPS instance
+ * \param  buffer    string buffer to copy the JSON text to
+ * \param  buf_size  size of the provided string buffer
+ * \return           length of the JSON text, 0 if no timing data is available */
+
+int lammps_get_timer_info(void *handle, char *buffer, int buf_size)
+{
+  auto lmp = (LAMMPS *) handle;
+  int len = 0;
+
+  const bool copy = buffer && (buf_size > 0);
+  if (copy) buffer[0] = buffer[buf_size-1] = '\0';
+
+  BEGIN_CAPTURE
+  {
+    const std::string &summary = lmp->timer->get_summary();
+    len = summary.size();
+    if (copy) strncpy(buffer, summary.c_str(), buf_size-1);
+  }
+  END_CAPTURE
+
+  return len;
+}
+
+/* ---------------------------------------------------------------------- */
+
 /** Query LAMMPS about global settings.
  *
 \verbatim embed:rst
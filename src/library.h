@@ -157,6 +157,7 @@ void lammps_reset_box(void *handle, double *boxlo, double *boxhi, double xy, dou
 
 void lammps_memory_usage(void *handle, double *meminfo);
 int lammps_get_mpi_comm(void *handle);
+int lammps_get_timer_info(void *handle, char *buffer, int buf_size);
 
 int lammps_extract_setting(void *handle, const char *keyword);
 int lammps_extract_global_datatype(void *handle, const char *name);
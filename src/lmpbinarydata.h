@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_BINARY_DATA_H
+#define LMP_BINARY_DATA_H
+
+#include <cstdint>
+
+// binary data file format written by write_data binary, read by read_data binary
+//
+// file = header, column index, column data
+// every item of the file is stored in a named column of fixed width values
+// columns are contiguous arrays starting at 8-byte aligned file offsets
+// readers look up columns by name and ignore columns they do not know,
+//   so new columns can be added without changing the format version
+
+namespace LAMMPS_NS {
+namespace BinaryData {
+
+  static constexpr char MAGIC[8] = {'L', 'A', 'M', 'M', 'P', 'S', 'B', 'D'};
+  static constexpr int32_t ENDIAN = 0x0001;
+  static constexpr int32_t VERSION = 1;
+
+  enum { INT64 = 1, FLOAT64 = 2, CHAR = 3 };
+
+  static constexpr int NAMELEN = 40;
+
+  struct Header {
+    char magic[8];       // MAGIC
+    int32_t endian;      // ENDIAN, to detect files written with other byte order
+    int32_t version;     // VERSION
+    int64_t ncolumns;    // # of entries in column index
+    int64_t index;       // file offset of column index
+  };
+
+  struct Column {
+    char name[NAMELEN];    // section/field name, null terminated
+    int32_t type;          // INT64 or FLOAT64 or CHAR
+    int32_t width;         // bytes per value
+    int64_t count;         // # of values
+    int64_t offset;        // file offset of first value
+  };
+
+}    // namespace BinaryData
+}    // namespace LAMMPS_NS
+
+#endif
@@ -16,6 +16,13 @@
 
 #include "error.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+
 #if defined(LMP_INTEL) && ((defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)))
 #ifndef LMP_INTEL_NO_TBB
 #define LMP_USE_TBB_ALLOCATOR
@@ -34,20 +41,133 @@
 #define LAMMPS_MEMALIGN 64
 #endif
 
+// NUMA first-touch placement needs OpenMP and the usable size of a block
+
+#if defined(__linux__) && defined(_OPENMP) && !defined(LMP_USE_TBB_ALLOCATOR)
+#define LMP_NUMA_TOUCH
+#include <malloc.h>
+#include <omp.h>
+#endif
+
+// huge page and arena backend for large blocks maps memory directly
+
+#if defined(__linux__) && !defined(LMP_USE_TBB_ALLOCATOR)
+#define LMP_MEMORY_POOL
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unordered_map>
+#endif
+
+// allocations with operator new are traced by the address of their caller,
+// if it is replaced by the version in memory_trace_new.cpp
+
+#if defined(__GLIBC__) && !defined(LMP_USE_TBB_ALLOCATOR)
+#define LMP_TRACE_NEW
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
 using namespace LAMMPS_NS;
 
-/* ---------------------------------------------------------------------- */
+enum { NONE, THP, EXPLICIT };
 
-Memory::Memory(LAMMPS *lmp) : Pointers(lmp) {}
+static constexpr bigint HUGEPAGE = 1 << 21;    // 2 MB, size of x86_64 and aarch64 huge pages
 
 /* ----------------------------------------------------------------------
-   safe malloc
+   blocks of HUGEPAGE or more bytes when a backend is selected
+   each block is mapped separately in multiples of HUGEPAGE bytes
+   blocks kept in the arena are reused by later allocations up to
+     twice as large as needed, e.g. after neighbor list pages are
+     freed at the start of a run or a per-atom array moved on growing
 ------------------------------------------------------------------------- */
 
-void *Memory::smalloc(bigint nbytes, const char *name)
+#if defined(LMP_MEMORY_POOL)
+namespace LAMMPS_NS {
+struct MemoryPool {
+  std::mutex lock;                            // smalloc() may be called by threads
+  std::atomic<bigint> nlive;                  // # of blocks in use
+  std::unordered_map<void *, bigint> live;    // capacity of blocks in use
+  std::multimap<bigint, void *> arena;        // freed blocks by capacity
+  bigint live_bytes, arena_bytes, max_bytes;
+  bigint nmap, nreuse, ninplace, nhuge, nfallback;
+
+  MemoryPool() :
+    nlive(0), live_bytes(0), arena_bytes(0), max_bytes(0), nmap(0), nreuse(0),
+    ninplace(0), nhuge(0), nfallback(0) {}
+};
+}    // namespace LAMMPS_NS
+#endif
+
+/* ----------------------------------------------------------------------
+   heap allocations while a run is traced
+   smalloc() and srealloc() calls are recorded by the name of the array,
+     operator new calls by the innermost return addresses into the LAMMPS code
+   only one LAMMPS instance can trace operator new at a time
+------------------------------------------------------------------------- */
+
+static constexpr int NCALLERS = 3;
+
+namespace LAMMPS_NS {
+struct MemoryTrace {
+  struct Site {
+    bigint count, bytes;
+  };
+  typedef std::array<const void *, NCALLERS> Callers;
+  std::mutex lock;                      // allocations may happen in threads
+  std::map<std::string, Site> named;    // smalloc() and srealloc() by array name
+  std::map<Callers, Site> code;         // operator new by return addresses
+  bigint nsteps, nruns;
+
+  MemoryTrace() : nsteps(0), nruns(0) {}
+};
+}    // namespace LAMMPS_NS
+
+static std::atomic<MemoryTrace *> active_trace(nullptr);
+static thread_local int in_trace = 0;    // no tracing of allocations by the trace itself
+
+#if defined(LMP_NUMA_TOUCH)
+static constexpr bigint NUMA_MINBYTES = 1 << 20;    // smaller blocks stay with the caller
+static constexpr uintptr_t NUMA_PAGE = 4096;
+
+/* ----------------------------------------------------------------------
+   write nbytes at ptr with each OpenMP thread writing one contiguous
+     page aligned part, in the same order as a static loop schedule
+   the OS places pages on the NUMA node of the thread touching them first
+   first ncopy bytes are copied from src, the rest is zeroed
+------------------------------------------------------------------------- */
+
+static void first_touch(void *ptr, const void *src, bigint ncopy, bigint nbytes)
 {
-  if (nbytes == 0) return nullptr;
+  auto dst = (char *) ptr;
+  auto from = (const char *) src;
+  const auto base = (uintptr_t) ptr;
+
+#pragma omp parallel default(shared)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+
+    bigint lo = 0, hi = nbytes;
+    if (tid > 0) {
+      uintptr_t addr = base + nbytes * tid / nthreads;
+      lo = MIN(nbytes, (bigint) ((addr + NUMA_PAGE - 1) / NUMA_PAGE * NUMA_PAGE - base));
+    }
+    if (tid < nthreads - 1) {
+      uintptr_t addr = base + nbytes * (tid + 1) / nthreads;
+      hi = MIN(nbytes, (bigint) ((addr + NUMA_PAGE - 1) / NUMA_PAGE * NUMA_PAGE - base));
+    }
+    const bigint mid = MAX(lo, MIN(hi, ncopy));
+    if (mid > lo) memcpy(dst + lo, from + lo, mid - lo);
+    if (hi > mid) memset(dst + mid, 0, hi - mid);
+  }
+}
+#endif
+
+/* ---------------------------------------------------------------------- */
 
+static void *aligned_malloc(bigint nbytes)
+{
 #if defined(LAMMPS_MEMALIGN)
   void *ptr;
 
@@ -61,8 +181,61 @@ void *Memory::smalloc(bigint nbytes, const char *name)
 #else
   void *ptr = malloc(nbytes);
 #endif
+  return ptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+Memory::Memory(LAMMPS *lmp) :
+  Pointers(lmp), numa_flag(0), hugepage(NONE), arena_flag(0), pool(nullptr), tracing(0),
+  trace(nullptr) {}
+
+/* ----------------------------------------------------------------------
+   blocks still in use are not unmapped, their owners free them too late
+------------------------------------------------------------------------- */
+
+Memory::~Memory()
+{
+  if (tracing) active_trace = nullptr;
+  delete trace;
+#if defined(LMP_MEMORY_POOL)
+  arena_flag = 0;
+  pool_release();
+  delete pool;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   return true if first-touch placement of large blocks is available
+------------------------------------------------------------------------- */
+
+bool Memory::numa_support()
+{
+#if defined(LMP_NUMA_TOUCH)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   safe malloc
+------------------------------------------------------------------------- */
+
+void *Memory::smalloc(bigint nbytes, const char *name)
+{
+  if (nbytes == 0) return nullptr;
+  if (tracing) trace_record(name, nbytes);
+
+  void *ptr = nullptr;
+  if (nbytes >= HUGEPAGE) ptr = pool_alloc(nbytes);
+  if (ptr == nullptr) ptr = aligned_malloc(nbytes);
   if (ptr == nullptr)
     error->one(FLERR,"Failed to allocate {} bytes for array {}", nbytes,name);
+
+#if defined(LMP_NUMA_TOUCH)
+  if (numa_flag && (nbytes >= NUMA_MINBYTES)) first_touch(ptr, nullptr, 0, nbytes);
+#endif
   return ptr;
 }
 
@@ -76,6 +249,52 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
     destroy(ptr);
     return nullptr;
   }
+  if (tracing) trace_record(name, nbytes);
+
+  // a block of the backend grows in place up to its capacity
+  // otherwise it is moved, as is a malloc() block growing large
+
+#if defined(LMP_MEMORY_POOL)
+  bigint capacity = 0;
+  if (pool && ptr && pool->nlive) capacity = pool_capacity(ptr);
+  if (capacity >= nbytes) {
+    std::lock_guard<std::mutex> guard(pool->lock);
+    ++pool->ninplace;
+    return ptr;
+  }
+  if (capacity || (ptr && pool_minbytes() && (nbytes >= HUGEPAGE))) {
+    void *optr = ptr;
+    const bigint ncopy = capacity ? capacity : MIN(nbytes, (bigint) malloc_usable_size(optr));
+    ptr = pool_alloc(nbytes);
+    if (ptr == nullptr) ptr = aligned_malloc(nbytes);
+    if (ptr == nullptr)
+      error->one(FLERR,"Failed to reallocate {} bytes for array {}", nbytes,name);
+#if defined(LMP_NUMA_TOUCH)
+    if (numa_flag) first_touch(ptr, optr, ncopy, nbytes);
+    else memcpy(ptr, optr, ncopy);
+#else
+    memcpy(ptr, optr, ncopy);
+#endif
+    if (capacity) pool_free(optr);
+    else free(optr);
+    return ptr;
+  }
+#endif
+
+  // a new block is needed, so its pages are placed by the threads using them
+  // realloc() would keep or place them where the calling thread runs
+
+#if defined(LMP_NUMA_TOUCH)
+  if (numa_flag && ptr && (nbytes >= NUMA_MINBYTES)) {
+    void *optr = ptr;
+    ptr = aligned_malloc(nbytes);
+    if (ptr == nullptr)
+      error->one(FLERR,"Failed to reallocate {} bytes for array {}", nbytes,name);
+    first_touch(ptr, optr, MIN(nbytes, (bigint) malloc_usable_size(optr)), nbytes);
+    free(optr);
+    return ptr;
+  }
+#endif
 
 #if defined(LMP_USE_TBB_ALLOCATOR)
   ptr = scalable_aligned_realloc(ptr, nbytes, LAMMPS_MEMALIGN);
@@ -112,6 +331,12 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
 void Memory::sfree(void *ptr)
 {
   if (ptr == nullptr) return;
+#if defined(LMP_MEMORY_POOL)
+  if (pool && pool->nlive && pool_capacity(ptr)) {
+    pool_free(ptr);
+    return;
+  }
+#endif
   #if defined(LMP_USE_TBB_ALLOCATOR)
   scalable_aligned_free(ptr);
   #else
@@ -127,3 +352,381 @@ void Memory::fail(const char *name)
 {
   error->one(FLERR,"Cannot create/grow a vector/array of pointers for {}",name);
 }
+
+/* ----------------------------------------------------------------------
+   select backend for blocks of 2 MB or more
+------------------------------------------------------------------------- */
+
+void Memory::modify_params(int narg, char **arg)
+{
+  if (narg < 1) utils::missing_cmd_args(FLERR, "memory", error);
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"hugepage") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "memory hugepage", error);
+      if (strcmp(arg[iarg+1],"none") == 0) hugepage = NONE;
+      else if (strcmp(arg[iarg+1],"thp") == 0) hugepage = THP;
+      else if (strcmp(arg[iarg+1],"explicit") == 0) hugepage = EXPLICIT;
+      else error->all(FLERR,"Unknown memory hugepage setting: {}", arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"arena") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "memory arena", error);
+      arena_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"trace") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "memory trace", error);
+      delete trace;
+      trace = nullptr;
+      if (utils::logical(FLERR,arg[iarg+1],false,lmp)) trace = new MemoryTrace;
+      iarg += 2;
+    } else error->all(FLERR,"Unknown memory keyword: {}", arg[iarg]);
+  }
+
+#if defined(LMP_MEMORY_POOL)
+  if (!pool && pool_minbytes()) pool = new MemoryPool;
+  if (!arena_flag) pool_release();
+#else
+  if (pool_minbytes())
+    error->all(FLERR,"Memory hugepage and arena settings are only supported on Linux");
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   return minimum size of blocks handled by the backend, 0 if none is used
+------------------------------------------------------------------------- */
+
+bigint Memory::pool_minbytes() const
+{
+  return ((hugepage != NONE) || arena_flag) ? HUGEPAGE : 0;
+}
+
+/* ----------------------------------------------------------------------
+   return backend settings and statistics for the info command
+------------------------------------------------------------------------- */
+
+std::string Memory::pool_info()
+{
+  const char *hugename[] = {"none", "thp", "explicit"};
+  std::string mesg = fmt::format("Large block allocator: hugepage = {}, arena = {}\n",
+                                 hugename[hugepage], arena_flag ? "yes" : "no");
+#if defined(LMP_MEMORY_POOL)
+  if (!pool) return mesg;
+
+  std::lock_guard<std::mutex> guard(pool->lock);
+  const double mb = 1.0 / (1024.0 * 1024.0);
+  mesg += fmt::format("  blocks in use:   {} with {:.4} Mbyte (max {:.4} Mbyte)\n"
+                      "  blocks in arena: {} with {:.4} Mbyte\n"
+                      "  mapped: {}, reused from arena: {}, grown in place: {}\n",
+                      pool->live.size(), pool->live_bytes * mb, pool->max_bytes * mb,
+                      pool->arena.size(), pool->arena_bytes * mb,
+                      pool->nmap, pool->nreuse, pool->ninplace);
+  if (hugepage == EXPLICIT)
+    mesg += fmt::format("  explicit huge page blocks: {}, fell back to transparent: {}\n",
+                        pool->nhuge, pool->nfallback);
+#endif
+  return mesg;
+}
+
+/* ----------------------------------------------------------------------
+   record heap allocations from now on, if tracing is enabled
+   called before the timestep loop of a run or minimization
+------------------------------------------------------------------------- */
+
+void Memory::trace_start()
+{
+  if (!trace) return;
+  MemoryTrace *none = nullptr;
+  if (!active_trace.compare_exchange_strong(none, trace))
+    error->all(FLERR,"Only one LAMMPS instance can trace heap allocations at a time");
+  tracing = 1;
+}
+
+/* ----------------------------------------------------------------------
+   stop recording heap allocations after nsteps timesteps
+------------------------------------------------------------------------- */
+
+void Memory::trace_stop(bigint nsteps)
+{
+  if (!tracing) return;
+  tracing = 0;
+  active_trace = nullptr;
+  trace->nsteps += nsteps;
+  ++trace->nruns;
+}
+
+/* ----------------------------------------------------------------------
+   return # of heap allocations recorded so far, -1 if tracing is off
+------------------------------------------------------------------------- */
+
+bigint Memory::trace_count()
+{
+  if (!trace) return -1;
+
+  std::lock_guard<std::mutex> guard(trace->lock);
+  bigint count = 0;
+  for (const auto &site : trace->named) count += site.second.count;
+  for (const auto &site : trace->code) count += site.second.count;
+  return count;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Memory::trace_record(const char *name, bigint nbytes)
+{
+  if (in_trace) return;
+  in_trace = 1;
+  {
+    std::lock_guard<std::mutex> guard(trace->lock);
+    auto &site = trace->named[name ? name : "(unnamed)"];
+    ++site.count;
+    site.bytes += nbytes;
+  }
+  in_trace = 0;
+}
+
+#if defined(LMP_TRACE_NEW)
+
+/* ----------------------------------------------------------------------
+   name of function containing code address, for the trace report
+   only symbols exported from a shared library or an executable linked
+     with -rdynamic have a name, otherwise the module and offset is
+     given, which addr2line can resolve
+------------------------------------------------------------------------- */
+
+static std::string code_name(const void *addr)
+{
+  Dl_info info;
+  const void *where = (const char *) addr - 1;    // inside the call instruction
+  if (!addr || !dladdr(where, &info)) return fmt::format("{}", addr);
+
+  if (info.dli_sname) {
+    int status = 0;
+    char *name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string mesg = fmt::format("{}+{:#x}", (status == 0) ? name : info.dli_sname,
+                                   (const char *) where - (const char *) info.dli_saddr);
+    free(name);
+    return mesg;
+  }
+  return fmt::format("{}+{:#x}", platform::path_basename(info.dli_fname),
+                     (const char *) where - (const char *) info.dli_fbase);
+}
+
+#endif
+
+/* ----------------------------------------------------------------------
+   record operator new call while tracing, by the first NCALLERS return
+     addresses on the stack into the module containing this function,
+     so that allocations inside the C++ library are attributed to the
+     LAMMPS code calling it and allocations in helpers like fmt::format()
+     to their callers
+   called by the replacement of operator new in memory_trace_new.cpp
+------------------------------------------------------------------------- */
+
+#if defined(LMP_TRACE_NEW)
+
+static constexpr int MAXFRAMES = 16;
+
+void __attribute__((noinline)) Memory::trace_new(std::size_t nbytes)
+{
+  MemoryTrace *trace = active_trace.load(std::memory_order_relaxed);
+  if (!trace || in_trace) return;
+  in_trace = 1;
+
+  void *frames[MAXFRAMES];
+  const int nframes = backtrace(frames, MAXFRAMES);
+
+  // frames[0] is this function, frames[1] is operator new
+
+  Dl_info self, info;
+  MemoryTrace::Callers site;
+  site.fill(nullptr);
+  int ncallers = 0;
+  if (dladdr((void *) &Memory::trace_new, &self)) {
+    for (int i = 2; (i < nframes) && (ncallers < NCALLERS); ++i) {
+      if (dladdr((const char *) frames[i] - 1, &info) && (info.dli_fbase == self.dli_fbase))
+        site[ncallers++] = frames[i];
+    }
+  }
+  if (!ncallers && (nframes > 2)) site[0] = frames[2];
+
+  {
+    std::lock_guard<std::mutex> guard(trace->lock);
+    auto &entry = trace->code[site];
+    ++entry.count;
+    entry.bytes += nbytes;
+  }
+  in_trace = 0;
+}
+
+#else
+
+void Memory::trace_new(std::size_t) {}
+
+#endif
+
+/* ----------------------------------------------------------------------
+   return report of traced heap allocations for the info command
+   sites are sorted by number of allocations
+------------------------------------------------------------------------- */
+
+std::string Memory::trace_info()
+{
+  if (!trace) return "Heap allocation tracing is off, enable with: memory trace yes\n";
+
+  typedef std::pair<std::string, MemoryTrace::Site> SiteInfo;
+  std::vector<SiteInfo> sites;
+  bigint nsteps, count = 0;
+  in_trace = 1;
+  {
+    std::lock_guard<std::mutex> guard(trace->lock);
+    nsteps = trace->nsteps;
+    for (const auto &site : trace->named)
+      sites.emplace_back("array " + site.first, site.second);
+#if defined(LMP_TRACE_NEW)
+    for (const auto &site : trace->code) {
+      std::string name = "new in " + code_name(site.first[0]);
+      for (int i = 1; (i < NCALLERS) && site.first[i]; ++i)
+        name += "\n" + std::string(36, ' ') + "from " + code_name(site.first[i]);
+      sites.emplace_back(name, site.second);
+    }
+#endif
+  }
+  in_trace = 0;
+
+  std::sort(sites.begin(), sites.end(), [](const SiteInfo &a, const SiteInfo &b) {
+    return a.second.count > b.second.count;
+  });
+  for (const auto &site : sites) count += site.second.count;
+
+  const double perstep = (nsteps > 0) ? 1.0 / nsteps : 0.0;
+  std::string mesg = fmt::format("Heap allocations during {} runs with {} steps: {} "
+                                 "({:.4} per step)\n", trace->nruns, nsteps, count,
+                                 count * perstep);
+  if (sites.empty()) return mesg;
+
+  mesg += "     Count   Per step      Bytes  Call site\n";
+  for (const auto &site : sites)
+    mesg += fmt::format("{:>10} {:>10.4} {:>10}  {}\n", site.second.count,
+                        site.second.count * perstep, site.second.bytes, site.first);
+  return mesg;
+}
+
+#if defined(LMP_MEMORY_POOL)
+
+/* ----------------------------------------------------------------------
+   get block for nbytes from arena or map a new one
+   explicit huge pages come from the hugetlbfs pool, which may be empty
+   transparent huge pages need a 2 MB aligned range, so the mapping is
+     trimmed to that and the kernel is advised to back it by huge pages
+   return nullptr if the backend is not used or mapping failed
+------------------------------------------------------------------------- */
+
+void *Memory::pool_alloc(bigint nbytes)
+{
+  if (!pool || !pool_minbytes() || (nbytes < HUGEPAGE)) return nullptr;
+
+  const bigint capacity = (nbytes + HUGEPAGE - 1) / HUGEPAGE * HUGEPAGE;
+  void *ptr = nullptr;
+
+  std::lock_guard<std::mutex> guard(pool->lock);
+
+  auto it = pool->arena.lower_bound(capacity);
+  if ((it != pool->arena.end()) && (it->first <= 2 * capacity)) {
+    ptr = it->second;
+    pool->live[ptr] = it->first;
+    pool->live_bytes += it->first;
+    pool->arena_bytes -= it->first;
+    pool->arena.erase(it);
+    ++pool->nreuse;
+    ++pool->nlive;
+    pool->max_bytes = MAX(pool->max_bytes, pool->live_bytes);
+    return ptr;
+  }
+
+#if defined(MAP_HUGETLB)
+  if (hugepage == EXPLICIT) {
+    ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr == MAP_FAILED) {
+      ptr = nullptr;
+      ++pool->nfallback;
+    } else ++pool->nhuge;
+  }
+#endif
+
+  if (!ptr) {
+    const bigint nmap = capacity + HUGEPAGE;
+    auto base = (char *) mmap(nullptr, nmap, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((void *) base == MAP_FAILED) return nullptr;
+    auto start = (char *) (((uintptr_t) base + HUGEPAGE - 1) / HUGEPAGE * HUGEPAGE);
+    if (start > base) munmap(base, start - base);
+    if (base + nmap > start + capacity) munmap(start + capacity, base + nmap - start - capacity);
+    ptr = start;
+#if defined(MADV_HUGEPAGE)
+    if (hugepage != NONE) madvise(ptr, capacity, MADV_HUGEPAGE);
+#endif
+  }
+
+  pool->live[ptr] = capacity;
+  pool->live_bytes += capacity;
+  pool->max_bytes = MAX(pool->max_bytes, pool->live_bytes);
+  ++pool->nmap;
+  ++pool->nlive;
+  return ptr;
+}
+
+/* ----------------------------------------------------------------------
+   return capacity of a block in use from the backend, 0 if not from it
+------------------------------------------------------------------------- */
+
+bigint Memory::pool_capacity(void *ptr)
+{
+  std::lock_guard<std::mutex> guard(pool->lock);
+  auto it = pool->live.find(ptr);
+  return (it == pool->live.end()) ? 0 : it->second;
+}
+
+/* ----------------------------------------------------------------------
+   move a block to the arena or unmap it
+------------------------------------------------------------------------- */
+
+void Memory::pool_free(void *ptr)
+{
+  std::lock_guard<std::mutex> guard(pool->lock);
+  auto it = pool->live.find(ptr);
+  if (it == pool->live.end()) return;
+
+  const bigint capacity = it->second;
+  pool->live.erase(it);
+  pool->live_bytes -= capacity;
+  --pool->nlive;
+
+  if (arena_flag) {
+    pool->arena.emplace(capacity, ptr);
+    pool->arena_bytes += capacity;
+  } else munmap(ptr, capacity);
+}
+
+/* ----------------------------------------------------------------------
+   unmap all blocks in the arena
+------------------------------------------------------------------------- */
+
+void Memory::pool_release()
+{
+  if (!pool) return;
+  std::lock_guard<std::mutex> guard(pool->lock);
+  for (const auto &block : pool->arena) munmap(block.second, block.first);
+  pool->arena.clear();
+  pool->arena_bytes = 0;
+}
+
+#else
+
+void *Memory::pool_alloc(bigint) { return nullptr; }
+bigint Memory::pool_capacity(void *) { return 0; }
+void Memory::pool_free(void *) {}
+void Memory::pool_release() {}
+
+#endif
@@ -19,15 +19,32 @@
 
 namespace LAMMPS_NS {
 
+struct MemoryPool;
+struct MemoryTrace;
+
 class Memory : protected Pointers {
  public:
   Memory(class LAMMPS *);
+  ~Memory() override;
 
   void *smalloc(bigint n, const char *);
   void *srealloc(void *, bigint n, const char *);
   void sfree(void *);
   void fail(const char *);
 
+  int numa_flag;    // 1 if large blocks are first touched by all OpenMP threads
+  static bool numa_support();
+
+  void modify_params(int, char **);
+  bigint pool_minbytes() const;
+  std::string pool_info();
+
+  void trace_start();
+  void trace_stop(bigint);
+  bigint trace_count();
+  std::string trace_info();
+  static void trace_new(std::size_t);
+
 /* ----------------------------------------------------------------------
    create/grow/destroy vecs and multidim arrays with contiguous memory blocks
    only use with primitive data types, e.g. 1d vec of ints, 2d array of doubles
@@ -941,6 +958,20 @@ class Memory : protected Pointers {
     bytes += ((double) sizeof(TYPE ***)) * n1;
     return bytes;
   }
+
+ private:
+  int hugepage;        // backend for large blocks: NONE, THP, or EXPLICIT huge pages
+  int arena_flag;      // 1 if freed large blocks are kept for reuse
+  MemoryPool *pool;    // large blocks in use and in the arena
+  int tracing;         // 1 while heap allocations are recorded
+  MemoryTrace *trace;  // heap allocations during runs by call site
+
+  void trace_record(const char *, bigint);
+
+  void *pool_alloc(bigint);
+  bigint pool_capacity(void *);
+  void pool_free(void *);
+  void pool_release();
 };
 
 }    // namespace LAMMPS_NS
@@ -0,0 +1,52 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   replacement of the global operator new, so heap allocations of
+     C++ containers and strings are traced by the memory trace command
+   only compiled with -DLAMMPS_TRACE_NEW, since it applies to the whole
+     process, and Memory::trace_new() only records calls with glibc
+   operator new[] and the nothrow variants of the C++ library call it,
+     and the matching delete operators call operator delete(void *)
+   operator delete is not inlined, where GCC would flag free() of
+     memory returned by operator new
+------------------------------------------------------------------------- */
+
+#if defined(LAMMPS_TRACE_NEW)
+
+#include "memory.h"
+
+#include <cstdlib>
+#include <new>
+
+void *operator new(std::size_t nbytes)
+{
+  LAMMPS_NS::Memory::trace_new(nbytes);
+
+  if (nbytes == 0) nbytes = 1;
+  void *ptr;
+  while ((ptr = malloc(nbytes)) == nullptr) {
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc();
+    handler();
+  }
+  return ptr;
+}
+
+void __attribute__((noinline)) operator delete(void *ptr) noexcept
+{
+  free(ptr);
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "domain.h"
 #include "error.h"
 #include "finish.h"
+#include "memory.h"
 #include "min.h"
 #include "timer.h"
 #include "update.h"
@@ -60,7 +61,9 @@ void Minimize::command(int narg, char **arg)
 
   timer->init();
   timer->barrier_start();
+  memory->trace_start();
   update->minimize->run(update->nsteps);
+  memory->trace_stop(update->minimize->niter);
   timer->barrier_stop();
 
   update->minimize->cleanup();
@@ -25,6 +25,7 @@
 #include "input.h"
 #include "memory.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -79,6 +80,8 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
   end_of_step_every = nullptr;
 
   list_timeflag = nullptr;
+  fix_timer = nullptr;
+  maxfix_timer = 0;
 
   restart_pbc_any = 0;
   nfix_restart_global = 0;
@@ -163,6 +166,7 @@ Modify::~Modify()
 
   delete[] end_of_step_every;
   delete[] list_timeflag;
+  memory->destroy(fix_timer);
 
   restart_deallocate(0);
 
@@ -247,6 +251,10 @@ void Modify::init()
   n_post_force_any = n_post_force + n_post_force_group;
   n_post_force_respa_any = n_post_force_respa + n_post_force_group;
 
+  // create sub-timers for the callbacks each fix is invoked for
+
+  init_fix_timer();
+
   // create list of computes that store invocation times
 
   list_init_compute();
@@ -388,8 +396,11 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
+  for (int i = 0; i < n_initial_integrate; i++) {
+    timer->sub_start(fix_timer[list_initial_integrate[i]][TIME_INITIAL_INTEGRATE]);
     fix[list_initial_integrate[i]]->initial_integrate(vflag);
+    timer->sub_stop(fix_timer[list_initial_integrate[i]][TIME_INITIAL_INTEGRATE]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -398,7 +409,11 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++) fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    timer->sub_start(fix_timer[list_post_integrate[i]][TIME_POST_INTEGRATE]);
+    fix[list_post_integrate[i]]->post_integrate();
+    timer->sub_stop(fix_timer[list_post_integrate[i]][TIME_POST_INTEGRATE]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -407,7 +422,11 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++) fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    timer->sub_start(fix_timer[list_pre_exchange[i]][TIME_PRE_EXCHANGE]);
+    fix[list_pre_exchange[i]]->pre_exchange();
+    timer->sub_stop(fix_timer[list_pre_exchange[i]][TIME_PRE_EXCHANGE]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -416,7 +435,11 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++) fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    timer->sub_start(fix_timer[list_pre_neighbor[i]][TIME_PRE_NEIGHBOR]);
+    fix[list_pre_neighbor[i]]->pre_neighbor();
+    timer->sub_stop(fix_timer[list_pre_neighbor[i]][TIME_PRE_NEIGHBOR]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -425,7 +448,11 @@ void Modify::pre_neighbor()
 
 void Modify::post_neighbor()
 {
-  for (int i = 0; i < n_post_neighbor; i++) fix[list_post_neighbor[i]]->post_neighbor();
+  for (int i = 0; i < n_post_neighbor; i++) {
+    timer->sub_start(fix_timer[list_post_neighbor[i]][TIME_POST_NEIGHBOR]);
+    fix[list_post_neighbor[i]]->post_neighbor();
+    timer->sub_stop(fix_timer[list_post_neighbor[i]][TIME_POST_NEIGHBOR]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -434,7 +461,11 @@ void Modify::post_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++) fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    timer->sub_start(fix_timer[list_pre_force[i]][TIME_PRE_FORCE]);
+    fix[list_pre_force[i]]->pre_force(vflag);
+    timer->sub_stop(fix_timer[list_pre_force[i]][TIME_PRE_FORCE]);
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -442,7 +473,11 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++) fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    timer->sub_start(fix_timer[list_pre_reverse[i]][TIME_PRE_REVERSE]);
+    fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+    timer->sub_stop(fix_timer[list_pre_reverse[i]][TIME_PRE_REVERSE]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -454,11 +489,19 @@ void Modify::pre_reverse(int eflag, int vflag)
 void Modify::post_force(int vflag)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++) fix[list_post_force_group[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force_group; i++) {
+      timer->sub_start(fix_timer[list_post_force_group[i]][TIME_POST_FORCE]);
+      fix[list_post_force_group[i]]->post_force(vflag);
+      timer->sub_stop(fix_timer[list_post_force_group[i]][TIME_POST_FORCE]);
+    }
   }
 
   if (n_post_force) {
-    for (int i = 0; i < n_post_force; i++) fix[list_post_force[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force; i++) {
+      timer->sub_start(fix_timer[list_post_force[i]][TIME_POST_FORCE]);
+      fix[list_post_force[i]]->post_force(vflag);
+      timer->sub_stop(fix_timer[list_post_force[i]][TIME_POST_FORCE]);
+    }
   }
 }
 
@@ -468,7 +511,11 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++) fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    timer->sub_start(fix_timer[list_final_integrate[i]][TIME_FINAL_INTEGRATE]);
+    fix[list_final_integrate[i]]->final_integrate();
+    timer->sub_stop(fix_timer[list_final_integrate[i]][TIME_FINAL_INTEGRATE]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -479,7 +526,11 @@ void Modify::final_integrate()
 void Modify::end_of_step()
 {
   for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0) fix[list_end_of_step[i]]->end_of_step();
+    if (update->ntimestep % end_of_step_every[i] == 0) {
+      timer->sub_start(fix_timer[list_end_of_step[i]][TIME_END_OF_STEP]);
+      fix[list_end_of_step[i]]->end_of_step();
+      timer->sub_stop(fix_timer[list_end_of_step[i]][TIME_END_OF_STEP]);
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -1120,7 +1171,7 @@ const std::vector<Fix *> Modify::get_fix_by_style(const std::string &style) cons
 
 const std::vector<Fix *> &Modify::get_fix_list()
 {
-  fix_list = std::vector<Fix *>(fix, fix + nfix);
+  fix_list.assign(fix, fix + nfix);
   return fix_list;
 }
 
@@ -1385,7 +1436,7 @@ const std::vector<Compute *> Modify::get_compute_by_style(const std::string &sty
 
 const std::vector<Compute *> &Modify::get_compute_list()
 {
-  compute_list = std::vector<Compute *>(compute, compute + ncompute);
+  compute_list.assign(compute, compute + ncompute);
   return compute_list;
 }
 
@@ -1784,6 +1835,50 @@ void Modify::list_init_compute()
     if (compute[i]->timeflag) list_timeflag[n_timeflag++] = i;
 }
 
+/* ----------------------------------------------------------------------
+   create sub-timers "fix ID" with one child per callback in the lists
+   all entries are -1 without timer full or trace
+------------------------------------------------------------------------- */
+
+void Modify::init_fix_timer()
+{
+  static const char *callback[] = {"initial_integrate", "post_integrate", "pre_exchange",
+                                   "pre_neighbor",      "post_neighbor",  "pre_force",
+                                   "pre_reverse",       "post_force",     "final_integrate",
+                                   "end_of_step"};
+  const int nlist[] = {n_initial_integrate, n_post_integrate, n_pre_exchange, n_pre_neighbor,
+                       n_post_neighbor,     n_pre_force,      n_pre_reverse,  n_post_force,
+                       n_final_integrate,   n_end_of_step};
+  const int *list[] = {list_initial_integrate, list_post_integrate, list_pre_exchange,
+                       list_pre_neighbor,      list_post_neighbor,  list_pre_force,
+                       list_pre_reverse,       list_post_force,     list_final_integrate,
+                       list_end_of_step};
+
+  if (nfix > maxfix_timer) {
+    maxfix_timer = nfix;
+    memory->destroy(fix_timer);
+    memory->create(fix_timer, maxfix_timer, NUM_FIX_TIMER, "modify:fix_timer");
+  }
+  for (int i = 0; i < nfix; i++)
+    for (int j = 0; j < NUM_FIX_TIMER; j++) fix_timer[i][j] = -1;
+
+  for (int j = 0; j < NUM_FIX_TIMER; j++) {
+    for (int i = 0; i < nlist[j]; i++) {
+      const int ifix = list[j][i];
+      int parent = timer->sub_timer(Timer::MODIFY, std::string("fix ") + fix[ifix]->id);
+      fix_timer[ifix][j] = timer->sub_timer(Timer::MODIFY, callback[j], parent);
+    }
+  }
+
+  // fix GROUP instances are called separately before other post_force() calls
+
+  for (int i = 0; i < n_post_force_group; i++) {
+    const int ifix = list_post_force_group[i];
+    int parent = timer->sub_timer(Timer::MODIFY, std::string("fix ") + fix[ifix]->id);
+    fix_timer[ifix][TIME_POST_FORCE] = timer->sub_timer(Timer::MODIFY, "post_force", parent);
+  }
+}
+
 /* ----------------------------------------------------------------------
    return # of bytes of allocated memory from all fixes
 ------------------------------------------------------------------------- */
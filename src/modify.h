@@ -176,6 +176,24 @@ class Modify : protected Pointers {
   int n_timeflag;    // list of computes that store time invocation
   int *list_timeflag;
 
+  // sub-timers per fix and callback of the timestep, -1 unless timer full or trace
+
+  enum {
+    TIME_INITIAL_INTEGRATE,
+    TIME_POST_INTEGRATE,
+    TIME_PRE_EXCHANGE,
+    TIME_PRE_NEIGHBOR,
+    TIME_POST_NEIGHBOR,
+    TIME_PRE_FORCE,
+    TIME_PRE_REVERSE,
+    TIME_POST_FORCE,
+    TIME_FINAL_INTEGRATE,
+    TIME_END_OF_STEP,
+    NUM_FIX_TIMER
+  };
+  int **fix_timer;
+  int maxfix_timer;
+
   char **id_restart_global;       // stored fix global info
   char **style_restart_global;    // from read-in restart file
   char **state_restart_global;
@@ -198,6 +216,7 @@ class Modify : protected Pointers {
   void list_init_energy_global(int &, int *&);
   void list_init_energy_atom(int &, int *&);
   void list_init_post_force_group(int &, int *&);
+  void init_fix_timer();
   void list_init_post_force_respa_group(int &, int *&);
   void list_init_dofflag(int &, int *&);
   void list_init_compute();
@@ -13,6 +13,8 @@
 
 #include "my_page.h"
 
+#include "memory.h"
+
 #if defined(LMP_INTEL) && !defined(LAMMPS_MEMALIGN) && !defined(_WIN32)
 #define LAMMPS_MEMALIGN 64
 #endif
@@ -59,7 +61,7 @@ using namespace LAMMPS_NS;
 template <class T>
 MyPage<T>::MyPage() :
     ndatum(0), nchunk(0), pages(nullptr), page(nullptr), npage(0), ipage(-1), index(-1),
-    maxchunk(-1), pagesize(-1), pagedelta(1), errorflag(0){};
+    maxchunk(-1), pagesize(-1), pagedelta(1), memory(nullptr), errorflag(0){};
 
 template <class T> MyPage<T>::~MyPage()
 {
@@ -74,21 +76,25 @@ template <class T> MyPage<T>::~MyPage()
  * \param  user_maxchunk   Expected maximum number of items for one chunk
  * \param  user_pagesize   Number of items on a single memory page
  * \param  user_pagedelta  Number of pages to allocate with one malloc
+ * \param  user_memory     Memory class instance to allocate pages from, so
+ *                         they can use its huge page or arena backend (optional)
  * \return                 1 if there were invalid parameters, 2 if there was an allocation error or 0 if successful */
 
-template <class T> int MyPage<T>::init(int user_maxchunk, int user_pagesize, int user_pagedelta)
+template <class T>
+int MyPage<T>::init(int user_maxchunk, int user_pagesize, int user_pagedelta, Memory *user_memory)
 {
-  maxchunk = user_maxchunk;
-  pagesize = user_pagesize;
-  pagedelta = user_pagedelta;
-
-  if (maxchunk <= 0 || pagesize <= 0 || pagedelta <= 0) return 1;
-  if (maxchunk > pagesize) return 1;
+  if (user_maxchunk <= 0 || user_pagesize <= 0 || user_pagedelta <= 0) return 1;
+  if (user_maxchunk > user_pagesize) return 1;
 
-  // free storage if re-initialized
+  // free storage if re-initialized, with the settings it was allocated with
 
   deallocate();
 
+  maxchunk = user_maxchunk;
+  pagesize = user_pagesize;
+  pagedelta = user_pagedelta;
+  memory = user_memory;
+
   // initial page allocation
 
   allocate();
@@ -154,6 +160,13 @@ template <class T> void MyPage<T>::allocate()
     return;
   }
 
+  if (memory) {
+    auto block = (T *) memory->smalloc((bigint) pagedelta * pagesize * sizeof(T), "mypage:block");
+    for (int i = npage - pagedelta; i < npage; i++)
+      pages[i] = block + (bigint) (i - npage + pagedelta) * pagesize;
+    return;
+  }
+
   for (int i = npage - pagedelta; i < npage; i++) {
 #if defined(LAMMPS_MEMALIGN)
     void *ptr;
@@ -171,7 +184,11 @@ template <class T> void MyPage<T>::allocate()
 template <class T> void MyPage<T>::deallocate()
 {
   reset();
-  for (int i = 0; i < npage; i++) free(pages[i]);
+  if (memory) {
+    for (int i = 0; i < npage; i += pagedelta) memory->sfree(pages[i]);
+  } else {
+    for (int i = 0; i < npage; i++) free(pages[i]);
+  }
   free(pages);
   pages = nullptr;
   npage = 0;
@@ -22,6 +22,8 @@
 
 namespace LAMMPS_NS {
 
+class Memory;
+
 struct HyperOneCoeff {
   double biascoeff;
   tagint tag;
@@ -34,7 +36,8 @@ template <class T> class MyPage {
   MyPage();
   virtual ~MyPage();
 
-  int init(int user_maxchunk = 1, int user_pagesize = 1024, int user_pagedelta = 1);
+  int init(int user_maxchunk = 1, int user_pagesize = 1024, int user_pagedelta = 1,
+           Memory *user_memory = nullptr);
 
   T *get(int n = 1);
 
@@ -100,6 +103,7 @@ template <class T> class MyPage {
   int maxchunk;     // max # of datums in one requested chunk
   int pagesize;     // # of datums in one page, default = 1024
   int pagedelta;    // # of pages to allocate at once, default = 1
+  Memory *memory;   // if set, allocate pagedelta pages as one block from it
 
   int errorflag;    // flag > 0 if error has occurred
                     // 1 = chunk size exceeded maxchunk
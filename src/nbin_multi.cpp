@@ -51,10 +51,11 @@ void NBinMulti::bin_atoms_setup(int nall)
 
   // bins and atom2bin = per-atom vectors
   // for both local and ghost atoms
+  // sized like other per-atom arrays, not reallocated when the # of ghosts varies
   // for multi, bins and atom2bin correspond to different binlists
 
   if (nall > maxatom) {
-    maxatom = nall;
+    maxatom = MAX(nall,atom->nmax);
     memory->destroy(bins);
     memory->create(bins,maxatom,"neigh:bins");
     memory->destroy(atom2bin);
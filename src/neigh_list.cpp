@@ -182,19 +182,43 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
 
   int nmypage = comm->nthreads;
   ipage = new MyPage<int>[nmypage];
-  for (int i = 0; i < nmypage; i++)
-    ipage[i].init(oneatom,pgsize,PGDELTA);
+
+  // with a huge page or arena backend, pages are allocated from it
+  // in blocks large enough for the backend
+
+  Memory *pgmemory = nullptr;
+  int pgdelta = PGDELTA;
+  if (memory->pool_minbytes()) {
+    pgmemory = memory;
+    const bigint pgbytes = (bigint) pgsize * sizeof(int);
+    pgdelta = MAX(PGDELTA, (memory->pool_minbytes() + pgbytes - 1) / pgbytes);
+  }
+
+  // with NUMA placement, each thread allocates the pages it fills during
+  // a threaded neighbor list build, so they come from its own heap arena
+  // and get placed on its NUMA node when first written
+
+  if (memory->numa_flag) {
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static) default(shared)
+#endif
+    for (int i = 0; i < nmypage; i++)
+      ipage[i].init(oneatom,pgsize,pgdelta,pgmemory);
+  } else {
+    for (int i = 0; i < nmypage; i++)
+      ipage[i].init(oneatom,pgsize,pgdelta,pgmemory);
+  }
 
   if (respainner) {
     ipage_inner = new MyPage<int>[nmypage];
     for (int i = 0; i < nmypage; i++)
-      ipage_inner[i].init(oneatom,pgsize,PGDELTA);
+      ipage_inner[i].init(oneatom,pgsize,pgdelta,pgmemory);
   }
 
   if (respamiddle) {
     ipage_middle = new MyPage<int>[nmypage];
     for (int i = 0; i < nmypage; i++)
-      ipage_middle[i].init(oneatom,pgsize,PGDELTA);
+      ipage_middle[i].init(oneatom,pgsize,pgdelta,pgmemory);
   }
 }
 
@@ -48,6 +48,7 @@
 #include "style_nstencil.h"  // IWYU pragma: keep
 #include "style_ntopo.h"  // IWYU pragma: keep
 #include "suffix.h"
+#include "timer.h"
 #include "tokenizer.h"
 #include "update.h"
 
@@ -126,6 +127,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   MPI_Comm_size(world,&nprocs);
 
   firsttime = 1;
+  build_timer = -1;
 
   style = Neighbor::BIN;
   every = 1;
@@ -692,6 +694,8 @@ void Neighbor::init()
   // instantiated topo styles can change from run to run
 
   init_topology();
+
+  build_timer = timer->sub_timer(Timer::NEIGH, "build");
 }
 
 /* ----------------------------------------------------------------------
@@ -2383,6 +2387,8 @@ void Neighbor::build(int topoflag)
 {
   int i,m;
 
+  timer->sub_start(build_timer);
+
   ago = 0;
   ncalls++;
   lastcall = update->ntimestep;
@@ -2461,6 +2467,8 @@ void Neighbor::build(int topoflag)
   // skip if GPU package styles will call it explicitly to overlap with GPU computation.
 
   if ((atom->molecular != Atom::ATOMIC) && topoflag && !overlap_topo) build_topology();
+
+  timer->sub_stop(build_timer);
 }
 
 /* ----------------------------------------------------------------------
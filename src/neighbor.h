@@ -179,6 +179,7 @@ class Neighbor : protected Pointers {
  protected:
   int me, nprocs;
   int firsttime;    // flag for calling init_styles() only once
+  int build_timer;  // sub-timer of build(), -1 unless timer full or trace
 
   int dimension;      // 2/3 for 2d/3d
   int triclinic;      // 0 if domain is orthog, 1 if triclinic
@@ -123,7 +123,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->async_wait();
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -620,6 +623,19 @@ void Output::write_restart(bigint ntimestep)
   last_restart = ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   wait until dumps with async output have written their last snapshot
+   called by Finish at the end of a run, so the files are complete
+------------------------------------------------------------------------- */
+
+void Output::finish_dumps()
+{
+  for (int idump = 0; idump < ndump; idump++) {
+    dump[idump]->async_wait();
+    dump[idump]->async_check();
+  }
+}
+
 /* ----------------------------------------------------------------------
    timestep is being changed, called by update->reset_timestep()
    for dumps, require that no dump is "active"
@@ -818,6 +834,7 @@ void Output::delete_dump(const std::string &id)
   for (idump = 0; idump < ndump; idump++) if (id == dump[idump]->id) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID: {}", id);
 
+  dump[idump]->async_wait();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -858,7 +875,7 @@ Dump *Output::get_dump_by_id(const std::string &id) const
 
 const std::vector<Dump *> &Output::get_dump_list()
 {
-  dump_list = std::vector<Dump *>(dump, dump + ndump);
+  dump_list.assign(dump, dump + ndump);
   return dump_list;
 }
 
@@ -1010,6 +1027,8 @@ void Output::create_restart(int narg, char **arg)
   restart = new WriteRestart(lmp);
   int iarg = nfile+1;
   restart->multiproc_options(multiproc,mpiioflag,narg-iarg,&arg[iarg]);
+  if ((nfile == 2) && restart->deltaflag)
+    error->all(FLERR,"Restart delta and keep are not allowed with two restart files");
 }
 
 /* ----------------------------------------------------------------------
@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -102,6 +103,7 @@ Pair::Pair(LAMMPS *lmp) :
   tabinner = sqrt(2.0);
   tabinner_disp = sqrt(2.0);
   trim_flag = 1;
+  cost_flag = 0;
 
   allocated = 0;
   suffix_flag = Suffix::NONE;
@@ -2000,6 +2002,37 @@ void Pair::hessian_twobody(double fforce, double dfac, double delr[3], double ph
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   add estimated cost of pairwise interactions to per-atom cost of owned atoms
+   each neighbor pair I,J adds factor[itype][jtype] to atom I
+   return 0 if no current neighbor list is available, else 1
+------------------------------------------------------------------------- */
+
+int Pair::atom_cost(double **factor, double *cost)
+{
+  if (!list || (neighbor->ago < 0)) return 0;
+
+  const int inum = list->inum;
+  const int *ilist = list->ilist;
+  const int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  const int *type = atom->type;
+  const int nlocal = atom->nlocal;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    if (i >= nlocal) continue;
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    const double *factori = factor[type[i]];
+    double sum = 0.0;
+    for (int jj = 0; jj < jnum; jj++) sum += factori[type[jlist[jj] & NEIGHMASK]];
+    cost[i] += sum;
+  }
+  return 1;
+}
+
 /* ---------------------------------------------------------------------- */
 
 double Pair::memory_usage()
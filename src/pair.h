@@ -83,6 +83,7 @@ class Pair : protected Pointers {
   double etail, ptail;    // energy/pressure tail corrections
   double etail_ij, ptail_ij;
   int trim_flag;    // pair_modify flag for trimming neigh list
+  int cost_flag;    // 1 if balance weight cost requests per-atom cost estimates
 
   int evflag;    // energy,virial settings
   int eflag_either, eflag_global, eflag_atom;
@@ -213,6 +214,8 @@ class Pair : protected Pointers {
 
   virtual double memory_usage();
 
+  virtual int atom_cost(double **, double *);
+
   void set_copymode(int value) { copymode = value; }
 
   // specific child-class methods for certain Pair styles
@@ -25,6 +25,7 @@
 #include "pair.h"
 #include "respa.h"
 #include "suffix.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -34,8 +35,9 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 PairHybrid::PairHybrid(LAMMPS *lmp) :
-    Pair(lmp), styles(nullptr), cutmax_style(nullptr), keywords(nullptr), multiple(nullptr),
-    nmap(nullptr), map(nullptr), special_lj(nullptr), special_coul(nullptr), compute_tally(nullptr)
+    Pair(lmp), styles(nullptr), cutmax_style(nullptr), cost_time(nullptr), subtimer(nullptr),
+    keywords(nullptr), multiple(nullptr), nmap(nullptr), map(nullptr), special_lj(nullptr),
+    special_coul(nullptr), compute_tally(nullptr)
 {
   nstyles = 0;
 
@@ -57,6 +59,8 @@ PairHybrid::~PairHybrid()
   }
   delete[] styles;
   delete[] cutmax_style;
+  delete[] cost_time;
+  delete[] subtimer;
   delete[] keywords;
   delete[] multiple;
 
@@ -130,9 +134,13 @@ void PairHybrid::compute(int eflag, int vflag)
       // outerflag is set and sub-style has a compute_outer() method
 
       if (styles[m]->compute_flag == 0) continue;
+      double tstart = cost_flag ? platform::walltime() : 0.0;
+      timer->sub_start(subtimer[m]);
       if (outerflag && styles[m]->respa_enable)
         styles[m]->compute_outer(eflag,vflag_substyle);
       else styles[m]->compute(eflag,vflag_substyle);
+      timer->sub_stop(subtimer[m]);
+      if (cost_flag) cost_time[m] += platform::walltime() - tstart;
     }
 
     restore_special(saved_special);
@@ -348,6 +356,12 @@ void PairHybrid::settings(int narg, char **arg)
   delete[] cutmax_style;
   cutmax_style = new double[nstyles];
   memset(cutmax_style, 0, nstyles*sizeof(double));
+  delete[] cost_time;
+  cost_time = new double[nstyles];
+  memset(cost_time, 0, nstyles*sizeof(double));
+  delete[] subtimer;
+  subtimer = new int[nstyles];
+  for (int m = 0; m < nstyles; m++) subtimer[m] = -1;
 
   // multiple[i] = 1 to M if sub-style used multiple times, else 0
 
@@ -638,6 +652,14 @@ void PairHybrid::init_style()
 
   for (istyle = 0; istyle < nstyles; istyle++) styles[istyle]->init_style();
 
+  // sub-timer for each sub-style, with timer full or trace
+
+  for (istyle = 0; istyle < nstyles; istyle++) {
+    std::string name = keywords[istyle];
+    if (multiple[istyle]) name += " " + std::to_string(multiple[istyle]);
+    subtimer[istyle] = timer->sub_timer(Timer::PAIR, name);
+  }
+
   // create skip lists inside each pair neigh request
   // any kind of list can have its skip flag set in this loop
 
@@ -826,6 +848,12 @@ void PairHybrid::read_restart(FILE *fp)
   delete[] cutmax_style;
   cutmax_style = new double[nstyles];
   memset(cutmax_style, 0, nstyles*sizeof(double));
+  delete[] cost_time;
+  cost_time = new double[nstyles];
+  memset(cost_time, 0, nstyles*sizeof(double));
+  delete[] subtimer;
+  subtimer = new int[nstyles];
+  for (int m = 0; m < nstyles; m++) subtimer[m] = -1;
   keywords = new char*[nstyles];
   multiple = new int[nstyles];
 
@@ -1208,6 +1236,52 @@ double PairHybrid::radii2cut(double r1, double r2)
   return cut;
 }
 
+/* ----------------------------------------------------------------------
+   add estimated cost of each sub-style to per-atom cost
+   if all sub-styles were timed since the last call, the estimate of
+     each sub-style is scaled by its measured time per unit of estimate,
+     so that expensive sub-styles weigh more than cheap ones
+------------------------------------------------------------------------- */
+
+int PairHybrid::atom_cost(double **factor, double *cost)
+{
+  const int nlocal = atom->nlocal;
+  double *stylecost;
+  memory->create(stylecost,nstyles*nlocal+1,"pair:stylecost");
+  memset(stylecost,0,(nstyles*nlocal+1)*sizeof(double));
+
+  int flag = 1;
+  auto mine = new double[2*nstyles];
+  for (int m = 0; m < nstyles; m++) {
+    double *onecost = stylecost + m*nlocal;
+    if (styles[m]->compute_flag && !styles[m]->atom_cost(factor,onecost)) flag = 0;
+    double sum = 0.0;
+    for (int i = 0; i < nlocal; i++) sum += onecost[i];
+    mine[m] = sum;
+    mine[nstyles+m] = cost_time[m];
+    cost_time[m] = 0.0;
+  }
+
+  auto all = new double[2*nstyles];
+  MPI_Allreduce(mine,all,2*nstyles,MPI_DOUBLE,MPI_SUM,world);
+
+  int timed = cost_flag;
+  for (int m = 0; m < nstyles; m++)
+    if ((all[m] > 0.0) && (all[nstyles+m] <= 0.0)) timed = 0;
+
+  for (int m = 0; m < nstyles; m++) {
+    double scale = 1.0;
+    if (timed && (all[m] > 0.0)) scale = all[nstyles+m] / all[m];
+    const double *onecost = stylecost + m*nlocal;
+    for (int i = 0; i < nlocal; i++) cost[i] += scale*onecost[i];
+  }
+
+  delete[] mine;
+  delete[] all;
+  memory->destroy(stylecost);
+  return flag;
+}
+
 /* ----------------------------------------------------------------------
    memory usage of each sub-style
 ------------------------------------------------------------------------- */
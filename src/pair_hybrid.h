@@ -68,11 +68,14 @@ class PairHybrid : public Pair {
   void del_tally_callback(class Compute *) override;
   double atom2cut(int) override;
   double radii2cut(double, double) override;
+  int atom_cost(double **, double *) override;
 
  protected:
   int nstyles;             // # of sub-styles
   Pair **styles;           // list of Pair style classes
   double *cutmax_style;    // max cutoff for each style
+  double *cost_time;       // accumulated compute time of each style, if cost_flag set
+  int *subtimer;           // sub-timer of each style, -1 unless timer full or trace
   char **keywords;         // style name of each Pair style
   int *multiple;           // 0 if style used once, else Mth instance
 
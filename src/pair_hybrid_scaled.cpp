@@ -22,6 +22,7 @@
 #include "memory.h"
 #include "respa.h"
 #include "suffix.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -149,10 +150,12 @@ void PairHybridScaled::compute(int eflag, int vflag)
       // outerflag is set and sub-style has a compute_outer() method
 
       if (styles[m]->compute_flag == 0) continue;
+      timer->sub_start(subtimer[m]);
       if (outerflag && styles[m]->respa_enable)
         styles[m]->compute_outer(eflag, vflag_substyle);
       else
         styles[m]->compute(eflag, vflag_substyle);
+      timer->sub_stop(subtimer[m]);
     }
 
     // add scaled forces to global sum
@@ -278,6 +281,9 @@ void PairHybridScaled::settings(int narg, char **arg)
   styles = new Pair *[narg];
   cutmax_style = new double[narg];
   memset(cutmax_style, 0.0, narg * sizeof(double));
+  delete[] subtimer;
+  subtimer = new int[narg];
+  for (int m = 0; m < narg; m++) subtimer[m] = -1;
   keywords = new char *[narg];
   multiple = new int[narg];
 
@@ -43,6 +43,7 @@
 #include <cstring>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -51,6 +52,10 @@ static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
 static constexpr int DELTA = 4;       // must be 2 or larger
 static constexpr int MAXBODY = 32;    // max # of lines in one body
+static constexpr bigint PARALLEL_BLOCK = 4194304;    // max bytes per proc and round for parallel read
+static constexpr bigint PARALLEL_MINBLOCK = 4096;    // min bytes per proc and round for parallel read
+static constexpr int BINARY_CHUNK = 65536;    // rows per read from binary data file columns
+static constexpr int RVOUS = 1;    // 0 for irregular, 1 for all2all
 
 // customize for new sections
 
@@ -154,6 +159,9 @@ void ReadData::command(int narg, char **arg)
       extra_improper_types = 0;
 
   groupbit = 0;
+  parallelflag = 0;
+  binaryflag = 0;
+  atoms_end = -1;
 
   nfix = 0;
   fix_index = nullptr;
@@ -209,6 +217,13 @@ void ReadData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg], "nocoeff") == 0) {
       coeffflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg], "binary") == 0) {
+      binaryflag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "extra/atom/types") == 0) {
       if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data extra/atom/types", error);
       extra_atom_types = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
@@ -342,6 +357,11 @@ void ReadData::command(int narg, char **arg)
     error->all(FLERR, "Cannot use read_data without add keyword after simulation box is defined");
   if (!domain->box_exist && addflag)
     error->all(FLERR, "Cannot use read_data add before simulation box is defined");
+  if (binaryflag && (addflag != NONE))
+    error->all(FLERR, "Cannot use read_data binary with add keyword");
+  if (binaryflag && (offsetflag || shiftflag))
+    error->all(FLERR, "Cannot use read_data binary with offset or shift keyword");
+  if (binaryflag && nfix) error->all(FLERR, "Cannot use read_data binary with fix keyword");
   if (offsetflag) {
     if (addflag == NONE) {
       error->all(FLERR, "Cannot use read_data offset without add keyword");
@@ -365,6 +385,7 @@ void ReadData::command(int narg, char **arg)
 
   if (!platform::file_is_readable(arg[0]))
     error->all(FLERR, fmt::format("Cannot open file {}: {}", arg[0], utils::getsyserror()));
+  datafile = arg[0];
 
   // reset so we can warn about reset image flags exactly once per data file
 
@@ -500,13 +521,17 @@ void ReadData::command(int narg, char **arg)
 
     if (me == 0) {
       if (firstpass) utils::logmesg(lmp, "Reading data file ...\n");
-      open(arg[0]);
+      if (!binaryflag) open(arg[0]);
     } else
       fp = nullptr;
 
     // read header info
+    // a binary data file is opened on all procs
 
-    header(firstpass);
+    if (binaryflag)
+      binary_header();
+    else
+      header(firstpass);
 
     // problem setup using info from header
     // only done once, if firstpass and first data file
@@ -608,6 +633,14 @@ void ReadData::command(int narg, char **arg)
       lmap = new LabelMap(lmp, ntypes, nbondtypes, nangletypes, ndihedraltypes, nimpropertypes);
     }
 
+    // binary data file has no sections, read all atoms and topology at once
+
+    if (binaryflag) {
+      atomflag = 1;
+      atoms();
+      if (atom->molecular == Atom::MOLECULAR) topology_binary();
+    }
+
     // customize for new sections
     // read rest of file in free format
 
@@ -621,6 +654,8 @@ void ReadData::command(int narg, char **arg)
                 FLERR, "Atom style in data file {} differs from currently defined atom style {}",
                 style, atom->atom_style);
           atoms();
+        } else if (atoms_end >= 0) {
+          if (me == 0) platform::fseek(fp, atoms_end);
         } else
           skip_lines(natoms);
 
@@ -937,7 +972,7 @@ void ReadData::command(int narg, char **arg)
 
     // close file
 
-    if (me == 0) {
+    if (fp) {
       if (compressed)
         platform::pclose(fp);
       else
@@ -945,9 +980,9 @@ void ReadData::command(int narg, char **arg)
       fp = nullptr;
     }
 
-    // done if this was 2nd pass
+    // done if this was 2nd pass or a binary data file
 
-    if (!firstpass) break;
+    if (!firstpass || binaryflag) break;
 
     // at end of 1st pass, error check for required sections
     // customize for new sections
@@ -1397,19 +1432,28 @@ void ReadData::atoms()
 {
   int nchunk, eof;
 
-  if (me == 0) utils::logmesg(lmp, "  reading atoms ...\n");
+  // parallel read requires a plain file that every proc can seek in
 
-  bigint nread = 0;
-
-  while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    if (tlabelflag && !lmap->is_complete(Atom::ATOM))
-      error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
-    atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
-                     lmap->lmap2lmap.atom);
-    nread += nchunk;
+  MPI_Bcast(&compressed, 1, MPI_INT, 0, world);
+  if (binaryflag) {
+    atoms_binary();
+  } else if (parallelflag && !compressed && (comm->nprocs > 1)) {
+    atoms_parallel();
+  } else {
+    if (me == 0) utils::logmesg(lmp, "  reading atoms ...\n");
+
+    bigint nread = 0;
+
+    while (nread < natoms) {
+      nchunk = MIN(natoms - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+        error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
+      atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
+                       lmap->lmap2lmap.atom);
+      nread += nchunk;
+    }
   }
 
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
@@ -1458,6 +1502,134 @@ void ReadData::atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   read Atoms section in parallel
+   each proc reads a byte range of the file per round, up to PARALLEL_BLOCK
+   a line belongs to the proc whose byte range contains its first character
+   lines are counted across procs to find the end of the section,
+     each proc parses only its own lines into atoms and
+     atoms are then migrated to their owning procs
+   proc 0 positions its file pointer after the Atoms section when done
+------------------------------------------------------------------------- */
+
+void ReadData::atoms_parallel()
+{
+  if (me == 0) utils::logmesg(lmp, "  reading atoms in parallel ...\n");
+
+  if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+    error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
+
+  // split the rest of the file evenly, so all procs take part also for small files
+
+  bigint range[2] = {0, 0};    // start of Atoms section and end of file
+  if (me == 0) {
+    range[0] = platform::ftell(fp);
+    platform::fseek(fp, platform::END_OF_FILE);
+    range[1] = platform::ftell(fp);
+    platform::fseek(fp, range[0]);
+  }
+  MPI_Bcast(range, 2, MPI_LMP_BIGINT, 0, world);
+  const bigint start = range[0];
+  const bigint block =
+      MIN(PARALLEL_BLOCK, MAX(PARALLEL_MINBLOCK, (range[1] - start) / comm->nprocs + 1));
+
+  FILE *pfp = fopen(datafile.c_str(), "r");
+  if (!pfp) error->one(FLERR, "Cannot open file {}: {}", datafile, utils::getsyserror());
+
+  // read one line of arbitrary length into str, return 0 on EOF
+
+  auto readline = [&](std::string &str) {
+    str.clear();
+    while (fgets(line, MAXLINE, pfp)) {
+      str += line;
+      if (str.back() == '\n') break;
+    }
+    return str.empty() ? 0 : 1;
+  };
+
+  std::string text, onestr;
+  std::vector<bigint> lineend;
+  bigint nread = 0;
+  bigint base = start;
+  bigint end = start;
+
+  while (nread < natoms) {
+    bigint lo = base + me * block;
+    bigint hi = lo + block;
+    bigint pos = lo;
+
+    // skip partial line owned by previous byte range
+
+    if (lo > start) {
+      platform::fseek(pfp, lo - 1);
+      int c = fgetc(pfp);
+      if ((c != EOF) && (c != '\n')) pos += readline(onestr) ? onestr.size() : 0;
+    } else
+      platform::fseek(pfp, lo);
+
+    text.clear();
+    lineend.clear();
+    while ((pos < hi) && readline(onestr)) {
+      pos += onestr.size();
+      if (onestr.back() != '\n') onestr += '\n';
+      text += onestr;
+      lineend.push_back(pos);
+    }
+
+    // count lines before mine in this round and use those still in Atoms section
+
+    bigint nmine = lineend.size();
+    bigint nbefore, ntotal;
+    MPI_Scan(&nmine, &nbefore, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+    MPI_Allreduce(&nmine, &ntotal, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+    nbefore -= nmine;
+    if (ntotal == 0) error->all(FLERR, "Unexpected end of data file");
+
+    bigint nremain = natoms - nread;
+    bigint nuse = MAX(0, MIN(nmine, nremain - nbefore));
+    if (nuse > 0) {
+      if (nbefore + nuse == nremain) end = lineend[nuse - 1];
+      atom->data_atoms(nuse, &text[0], id_offset, mol_offset, toffset, shiftflag, shift,
+                       tlabelflag, lmap->lmap2lmap.atom, 1);
+    }
+    nread += MIN(ntotal, nremain);
+    base += comm->nprocs * block;
+  }
+  fclose(pfp);
+
+  MPI_Allreduce(&end, &atoms_end, 1, MPI_LMP_BIGINT, MPI_MAX, world);
+  if (me == 0) platform::fseek(fp, atoms_end);
+
+  migrate_new_atoms();
+}
+
+/* ----------------------------------------------------------------------
+   move atoms read on arbitrary procs to their owning procs
+------------------------------------------------------------------------- */
+
+void ReadData::migrate_new_atoms()
+{
+  // image flag resets may have happened on any proc
+
+  int reset[3], allreset[3];
+  for (int i = 0; i < 3; i++) reset[i] = atom->reset_image_flag[i] ? 1 : 0;
+  MPI_Allreduce(reset, allreset, 3, MPI_INT, MPI_MAX, world);
+  for (int i = 0; i < 3; i++) atom->reset_image_flag[i] = (allreset[i] != 0);
+
+  // move atoms to their owning procs
+  // set up atom map first, since Irregular clears it
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  auto irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1);
+  delete irregular;
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+}
+
 /* ----------------------------------------------------------------------
    read all velocities
    to find atoms, must build atom map if not a molecular system
@@ -2484,3 +2656,495 @@ int ReadData::style_match(const char *one, const char *two)
   if ((len1 == 0) || (len1 == len2) || (strncmp(one, two, len1) == 0)) return 1;
   return 0;
 }
+
+/* ----------------------------------------------------------------------
+   open binary data file on all procs, read column index and header values
+   see lmpbinarydata.h for the layout
+------------------------------------------------------------------------- */
+
+void ReadData::binary_header()
+{
+  using namespace BinaryData;
+
+  compressed = 0;
+  fp = fopen(datafile.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", datafile, utils::getsyserror());
+
+  // proc 0 reads header and column index and broadcasts them, all procs check them
+
+  Header header;
+  memset(&header, 0, sizeof(Header));
+  int eof = 0;
+  if (me == 0) eof = (fread(&header, sizeof(Header), 1, fp) != 1) ? 1 : 0;
+  MPI_Bcast(&eof, 1, MPI_INT, 0, world);
+  if (eof) error->all(FLERR, "Unexpected end of binary data file");
+  MPI_Bcast(&header, sizeof(Header), MPI_CHAR, 0, world);
+
+  if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0)
+    error->all(FLERR, "File {} is not a LAMMPS binary data file", datafile);
+  if (header.endian != ENDIAN)
+    error->all(FLERR, "Binary data file {} was written with different byte order", datafile);
+  if (header.version > VERSION)
+    error->all(FLERR, "Binary data file {} format version {} is newer than supported version {}",
+               datafile, header.version, VERSION);
+  if (header.ncolumns < 0)
+    error->all(FLERR, "Invalid column index in binary data file {}", datafile);
+
+  bincolumns.resize(header.ncolumns);
+  if (me == 0) {
+    platform::fseek(fp, header.index);
+    eof = (fread(bincolumns.data(), sizeof(Column), header.ncolumns, fp) !=
+           (std::size_t) header.ncolumns) ? 1 : 0;
+  }
+  MPI_Bcast(&eof, 1, MPI_INT, 0, world);
+  if (eof) error->all(FLERR, "Unexpected end of binary data file");
+  MPI_Bcast(bincolumns.data(), header.ncolumns * sizeof(Column), MPI_CHAR, 0, world);
+
+  // small header values
+
+  auto read_int = [&](const std::string &name) {
+    int64_t value = 0;
+    auto col = binary_column("header/" + name, INT64, 1, 0);
+    if (col) binary_read(col, 0, 1, &value);
+    return (bigint) value;
+  };
+  auto read_string = [&](const std::string &name) {
+    std::string value;
+    auto col = binary_column("header/" + name, CHAR, -1, 0);
+    if (col) {
+      value.resize(col->count);
+      binary_read(col, 0, col->count, &value[0]);
+    }
+    return value;
+  };
+
+  if (me == 0) {
+    auto units = read_string("units");
+    if (!units.empty() && (units != update->unit_style))
+      error->warning(FLERR, "Inconsistent units in data file: current = {}, data file = {}",
+                     update->unit_style, units);
+    auto style = read_string("atom_style");
+    if (!style_match(style.c_str(), atom->atom_style))
+      error->warning(FLERR,
+                     "Atom style in data file {} differs from currently defined atom style {}",
+                     style, atom->atom_style);
+  }
+
+  natoms = read_int("natoms");
+  ntypes = read_int("ntypes");
+  nbonds = read_int("nbonds");
+  nangles = read_int("nangles");
+  ndihedrals = read_int("ndihedrals");
+  nimpropers = read_int("nimpropers");
+  nbondtypes = read_int("nbondtypes");
+  nangletypes = read_int("nangletypes");
+  ndihedraltypes = read_int("ndihedraltypes");
+  nimpropertypes = read_int("nimpropertypes");
+
+  atom->natoms = natoms;
+  atom->nbonds = nbonds;
+  atom->nangles = nangles;
+  atom->ndihedrals = ndihedrals;
+  atom->nimpropers = nimpropers;
+  atom->ntypes = ntypes + extra_atom_types;
+  atom->nbondtypes = nbondtypes + extra_bond_types;
+  atom->nangletypes = nangletypes + extra_angle_types;
+  atom->ndihedraltypes = ndihedraltypes + extra_dihedral_types;
+  atom->nimpropertypes = nimpropertypes + extra_improper_types;
+
+  binary_read(binary_column("header/boxlo", FLOAT64, 3, 1), 0, 3, boxlo);
+  binary_read(binary_column("header/boxhi", FLOAT64, 3, 1), 0, 3, boxhi);
+  auto col = binary_column("header/tilt", FLOAT64, 3, 0);
+  if (col) {
+    double tilt[3];
+    binary_read(col, 0, 3, tilt);
+    triclinic = 1;
+    xy = tilt[0];
+    xz = tilt[1];
+    yz = tilt[2];
+  }
+
+  // error checks, same as for text data files
+
+  if (atom->natoms < 0 || atom->natoms >= MAXBIGINT)
+    error->all(FLERR, "System in data file is too big");
+  if (atom->ellipsoid_flag || atom->line_flag || atom->tri_flag || atom->body_flag)
+    error->all(FLERR, "Read_data binary does not support atom styles with bonus data");
+  if ((atom->nbonds || atom->nbondtypes) && atom->avec->bonds_allow == 0)
+    error->all(FLERR, "No bonds allowed with this atom style");
+  if ((atom->nangles || atom->nangletypes) && atom->avec->angles_allow == 0)
+    error->all(FLERR, "No angles allowed with this atom style");
+  if ((atom->ndihedrals || atom->ndihedraltypes) && atom->avec->dihedrals_allow == 0)
+    error->all(FLERR, "No dihedrals allowed with this atom style");
+  if ((atom->nimpropers || atom->nimpropertypes) && atom->avec->impropers_allow == 0)
+    error->all(FLERR, "No impropers allowed with this atom style");
+  if (atom->molecular == Atom::TEMPLATE) {
+    if (atom->nbonds || atom->nangles || atom->ndihedrals || atom->nimpropers)
+      error->all(FLERR, "No molecule topology allowed with atom style template");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   find column of binary data file by name
+   check type and count, unless count < 0
+   return nullptr or error out if not found, depending on required
+------------------------------------------------------------------------- */
+
+const BinaryData::Column *ReadData::binary_column(const std::string &name, int type, bigint count,
+                                                  int required)
+{
+  for (const auto &col : bincolumns) {
+    if (strncmp(col.name, name.c_str(), BinaryData::NAMELEN) != 0) continue;
+    if ((col.type != type) || ((count >= 0) && (col.count != count)))
+      error->all(FLERR, "Inconsistent column {} in binary data file", name);
+    return &col;
+  }
+  if (required) error->all(FLERR, "Binary data file has no column {}", name);
+  return nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   read N values starting at index first from a column of binary data file
+------------------------------------------------------------------------- */
+
+void ReadData::binary_read(const BinaryData::Column *col, bigint first, bigint n, void *buf)
+{
+  if (n <= 0) return;
+  platform::fseek(fp, col->offset + first * col->width);
+  if (fread(buf, col->width, n, fp) != (std::size_t) n)
+    error->one(FLERR, "Unexpected end of binary data file");
+}
+
+/* ----------------------------------------------------------------------
+   read atoms and velocities from binary data file
+   each proc reads a contiguous slice of all per-atom columns,
+     creates those atoms, then atoms are migrated to their owning procs
+------------------------------------------------------------------------- */
+
+void ReadData::atoms_binary()
+{
+  using namespace BinaryData;
+
+  if (me == 0) utils::logmesg(lmp, "  reading atoms ...\n");
+
+  std::vector<std::string> atomnames, velnames;
+  std::vector<int> atomint, velint;
+  atom->avec->data_columns(atomnames, atomint, velnames, velint);
+
+  int natomcol = atomnames.size();
+  std::vector<const Column *> acols;
+  for (int i = 0; i < natomcol; i++)
+    acols.push_back(binary_column("atoms/" + atomnames[i], atomint[i] ? INT64 : FLOAT64, natoms, 1));
+
+  // velocity columns are optional, but must be complete, no atom ID column
+
+  int nvelcol = velnames.size() - 1;
+  std::vector<const Column *> vcols;
+  if (binary_column("velocities/" + velnames[1], FLOAT64, natoms, 0)) {
+    for (int i = 1; i <= nvelcol; i++)
+      vcols.push_back(binary_column("velocities/" + velnames[i], velint[i] ? INT64 : FLOAT64,
+                                    natoms, 1));
+  } else
+    nvelcol = 0;
+
+  int xcol = -1;
+  for (int i = 0; i < natomcol; i++)
+    if (atomnames[i] == "x[1]") xcol = i;
+  if (xcol < 0) error->all(FLERR, "Binary data file has no atom coordinates");
+
+  // my slice of atoms
+
+  int nprocs = comm->nprocs;
+  bigint lo = natoms * me / nprocs;
+  bigint hi = natoms * (me + 1) / nprocs;
+
+  std::vector<double> abuf((bigint) natomcol * BINARY_CHUNK);
+  std::vector<double> vbuf((bigint) nvelcol * BINARY_CHUNK);
+  std::vector<double> avalues(natomcol), vvalues(nvelcol + 1, 0.0);
+  double xdata[3];
+  imageint imagedata;
+
+  for (bigint first = lo; first < hi; first += BINARY_CHUNK) {
+    int n = MIN(hi - first, BINARY_CHUNK);
+    for (int c = 0; c < natomcol; c++) binary_read(acols[c], first, n, &abuf[(bigint) c * n]);
+    for (int c = 0; c < nvelcol; c++) binary_read(vcols[c], first, n, &vbuf[(bigint) c * n]);
+
+    for (int i = 0; i < n; i++) {
+      for (int c = 0; c < natomcol; c++) avalues[c] = abuf[(bigint) c * n + i];
+
+      // image flags are the last 3 columns, reset for non-periodic dims as in data_atoms()
+
+      int imx = (int) ubuf(avalues[natomcol - 3]).i;
+      int imy = (int) ubuf(avalues[natomcol - 2]).i;
+      int imz = (int) ubuf(avalues[natomcol - 1]).i;
+      if ((domain->dimension == 2) && (imz != 0))
+        error->one(FLERR, "Z-direction image flag must be 0 for 2d-systems");
+      if ((!domain->xperiodic) && (imx != 0)) { atom->reset_image_flag[0] = true; imx = 0; }
+      if ((!domain->yperiodic) && (imy != 0)) { atom->reset_image_flag[1] = true; imy = 0; }
+      if ((!domain->zperiodic) && (imz != 0)) { atom->reset_image_flag[2] = true; imz = 0; }
+      imagedata = ((imageint) (imx + IMGMAX) & IMGMASK) |
+          (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
+          (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
+
+      xdata[0] = avalues[xcol];
+      xdata[1] = avalues[xcol + 1];
+      xdata[2] = avalues[xcol + 2];
+      domain->remap(xdata, imagedata);
+
+      atom->avec->data_atom_binary(xdata, imagedata, avalues.data());
+      int ilocal = atom->nlocal - 1;
+      if ((atom->type[ilocal] <= 0) || (atom->type[ilocal] > atom->ntypes))
+        error->one(FLERR, "Invalid atom type {} in binary data file", atom->type[ilocal]);
+
+      if (nvelcol) {
+        for (int c = 0; c < nvelcol; c++) vvalues[c + 1] = vbuf[(bigint) c * n + i];
+        atom->avec->data_vel_binary(ilocal, vvalues.data());
+      }
+    }
+  }
+
+  // per-type masses
+
+  auto mcol = binary_column("masses/mass", FLOAT64, ntypes, 0);
+  if (mcol && atom->mass) {
+    std::vector<double> mass(ntypes);
+    binary_read(mcol, 0, ntypes, mass.data());
+    for (int i = 0; i < ntypes; i++) atom->set_mass(FLERR, i + 1, mass[i]);
+  }
+
+  if (me == 0 && nvelcol) utils::logmesg(lmp, "  reading velocities ...\n");
+
+  migrate_new_atoms();
+}
+
+/* ----------------------------------------------------------------------
+   read bonds, angles, dihedrals, and impropers from binary data file
+   each proc reads a contiguous slice of each section and sends its entries
+     via rendezvous comm to the procs owning the atoms that store them,
+     then sizes the per-atom arrays from the received entries and stores them
+------------------------------------------------------------------------- */
+
+void ReadData::topology_binary()
+{
+  using namespace BinaryData;
+
+  const char *names[4] = {"bonds", "angles", "dihedrals", "impropers"};
+  const int natom[4] = {2, 3, 4, 4};
+  const bigint ntotal[4] = {nbonds, nangles, ndihedrals, nimpropers};
+  const int ntype[4] = {atom->nbondtypes, atom->nangletypes, atom->ndihedraltypes,
+                        atom->nimpropertypes};
+  const int extra[4] = {atom->extra_bond_per_atom, atom->extra_angle_per_atom,
+                        atom->extra_dihedral_per_atom, atom->extra_improper_per_atom};
+  int *per_atom[4] = {&atom->bond_per_atom, &atom->angle_per_atom, &atom->dihedral_per_atom,
+                      &atom->improper_per_atom};
+
+  int nprocs = comm->nprocs;
+  int nlocal = atom->nlocal;
+  tagint *tag = atom->tag;
+  int newton_bond = force->newton_bond;
+
+  // owning proc of each atom ID in rendezvous decomposition
+  // each proc assigned every 1/Pth atom
+
+  std::vector<int> proclist(nlocal);
+  std::vector<OwnerRvous> idbuf(nlocal);
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
+  }
+
+  char *buf;
+  comm->rendezvous(RVOUS, nlocal, (char *) idbuf.data(), sizeof(OwnerRvous), 0, proclist.data(),
+                   rendezvous_owners, 0, buf, 0, (void *) this);
+
+  TopoRvous *entries[4] = {nullptr, nullptr, nullptr, nullptr};
+  int nentries[4] = {0, 0, 0, 0};
+  std::vector<int64_t> ibuf;
+  std::vector<int> count(nlocal);
+
+  for (int k = 0; k < 4; k++) {
+    if (ntotal[k] == 0) continue;
+    if (me == 0) utils::logmesg(lmp, "  reading {} ...\n", names[k]);
+
+    int ncol = natom[k] + 1;
+    std::vector<const Column *> cols;
+    cols.push_back(binary_column(fmt::format("{}/type", names[k]), INT64, ntotal[k], 1));
+    for (int m = 1; m <= natom[k]; m++)
+      cols.push_back(binary_column(fmt::format("{}/atom{}", names[k], m), INT64, ntotal[k], 1));
+    ibuf.resize((bigint) ncol * BINARY_CHUNK);
+
+    // my slice of entries, stored with 1st atom of bonds and 2nd atom of others,
+    //   or with all if newton off
+
+    bigint lo = ntotal[k] * me / nprocs;
+    bigint hi = ntotal[k] * (me + 1) / nprocs;
+    bigint nsend = (hi - lo) * (newton_bond ? 1 : natom[k]);
+    if (nsend > MAXSMALLINT)
+      error->one(FLERR, "Too many {} per proc in binary data file", names[k]);
+
+    std::vector<TopoRvous> inbuf(nsend);
+    proclist.resize(nsend);
+    nsend = 0;
+
+    for (bigint first = lo; first < hi; first += BINARY_CHUNK) {
+      int n = MIN(hi - first, BINARY_CHUNK);
+      for (int c = 0; c < ncol; c++) binary_read(cols[c], first, n, &ibuf[(bigint) c * n]);
+
+      for (int i = 0; i < n; i++) {
+        TopoRvous entry;
+        entry.type = ibuf[i];
+        if ((entry.type <= 0) || (entry.type > ntype[k]))
+          error->one(FLERR, "Invalid type {} in {} of binary data file", entry.type, names[k]);
+        for (int m = 0; m < 4; m++) {
+          entry.ids[m] = (m < natom[k]) ? ibuf[(bigint) (m + 1) * n + i] : 0;
+          if ((m < natom[k]) && ((entry.ids[m] <= 0) || (entry.ids[m] > atom->map_tag_max)))
+            error->one(FLERR, "Invalid atom ID {} in {} of binary data file", entry.ids[m],
+                       names[k]);
+        }
+        for (int m = 0; m < natom[k]; m++) {
+          if (newton_bond && (m != ((k == 0) ? 0 : 1))) continue;
+          entry.atomID = entry.ids[m];
+          proclist[nsend] = entry.atomID % nprocs;
+          inbuf[nsend++] = entry;
+        }
+      }
+    }
+
+    nentries[k] = comm->rendezvous(RVOUS, nsend, (char *) inbuf.data(), sizeof(TopoRvous), 0,
+                                   proclist.data(), rendezvous_topology, 0, buf,
+                                   sizeof(TopoRvous), (void *) this);
+    entries[k] = (TopoRvous *) buf;
+
+    // store max entries/atom with extra
+
+    std::fill(count.begin(), count.end(), 0);
+    for (int i = 0; i < nentries[k]; i++) {
+      int j = atom->map(entries[k][i].atomID);
+      if ((j < 0) || (j >= nlocal))
+        error->one(FLERR, "Atom {} of {} in binary data file is not owned", entries[k][i].atomID,
+                   names[k]);
+      count[j]++;
+    }
+
+    int max = 0;
+    for (int i = 0; i < nlocal; i++) max = MAX(max, count[i]);
+    int maxall;
+    MPI_Allreduce(&max, &maxall, 1, MPI_INT, MPI_MAX, world);
+    *per_atom[k] = maxall + extra[k];
+    if (me == 0) utils::logmesg(lmp, "  {} = max {}/atom\n", *per_atom[k], names[k]);
+  }
+  rvous_owner.clear();
+
+  // reallocate topology arrays with new per-atom sizes
+
+  atom->deallocate_topology();
+  atom->avec->grow(atom->nmax);
+
+  for (int k = 0; k < 4; k++) {
+    if (ntotal[k] == 0) continue;
+
+    for (int i = 0; i < nentries[k]; i++) {
+      const TopoRvous &entry = entries[k][i];
+      const tagint *ids = entry.ids;
+      int j = atom->map(entry.atomID);
+      if (k == 0) {
+        int nb = atom->num_bond[j];
+        atom->bond_type[j][nb] = entry.type;
+        atom->bond_atom[j][nb] = (entry.atomID == ids[0]) ? ids[1] : ids[0];
+        atom->num_bond[j]++;
+        atom->avec->data_bonds_post(j, atom->num_bond[j], ids[0], ids[1], 0);
+      } else if (k == 1) {
+        int na = atom->num_angle[j];
+        atom->angle_type[j][na] = entry.type;
+        atom->angle_atom1[j][na] = ids[0];
+        atom->angle_atom2[j][na] = ids[1];
+        atom->angle_atom3[j][na] = ids[2];
+        atom->num_angle[j]++;
+      } else if (k == 2) {
+        int nd = atom->num_dihedral[j];
+        atom->dihedral_type[j][nd] = entry.type;
+        atom->dihedral_atom1[j][nd] = ids[0];
+        atom->dihedral_atom2[j][nd] = ids[1];
+        atom->dihedral_atom3[j][nd] = ids[2];
+        atom->dihedral_atom4[j][nd] = ids[3];
+        atom->num_dihedral[j]++;
+      } else {
+        int ni = atom->num_improper[j];
+        atom->improper_type[j][ni] = entry.type;
+        atom->improper_atom1[j][ni] = ids[0];
+        atom->improper_atom2[j][ni] = ids[1];
+        atom->improper_atom3[j][ni] = ids[2];
+        atom->improper_atom4[j][ni] = ids[3];
+        atom->num_improper[j]++;
+      }
+    }
+    memory->sfree(entries[k]);
+
+    // check all entries were assigned
+
+    int *num = (k == 0) ? atom->num_bond
+        : (k == 1)      ? atom->num_angle
+        : (k == 2)      ? atom->num_dihedral
+                        : atom->num_improper;
+    bigint mine = 0;
+    for (int i = 0; i < nlocal; i++) mine += num[i];
+    bigint sum;
+    MPI_Allreduce(&mine, &sum, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+    int factor = newton_bond ? 1 : natom[k];
+    if (me == 0) utils::logmesg(lmp, "  {} {}\n", sum / factor, names[k]);
+    if (sum != factor * ntotal[k])
+      error->all(FLERR, "{} assigned incorrectly", utils::uppercase(names[k]));
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store owning procs of atoms assigned to me in rendezvous decomposition
+   inbuf = list of N OwnerRvous datums
+   no outbuf
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_owners(int n, char *inbuf, int &flag, int *& /*proclist*/,
+                                char *& /*outbuf*/, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (OwnerRvous *) inbuf;
+
+  rptr->rvous_owner.clear();
+  rptr->rvous_owner.reserve(n);
+  for (int i = 0; i < n; i++) rptr->rvous_owner[in[i].atomID] = in[i].me;
+
+  // flag = 0: no second comm needed in rendezvous
+
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   route topology entries stored with atoms assigned to me in rendezvous
+     decomposition to the procs owning those atoms
+   inbuf = list of N TopoRvous datums
+   outbuf = same list of N TopoRvous datums, routed to different procs
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_topology(int n, char *inbuf, int &flag, int *&proclist,
+                                  char *&outbuf, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (TopoRvous *) inbuf;
+
+  rptr->memory->create(proclist, n, "read_data:proclist");
+  for (int i = 0; i < n; i++) {
+    auto owner = rptr->rvous_owner.find(in[i].atomID);
+    if (owner == rptr->rvous_owner.end())
+      rptr->error->one(FLERR, "Invalid atom ID {} in topology of binary data file",
+                       in[i].atomID);
+    proclist[i] = owner->second;
+  }
+
+  // flag = 1: outbuf = inbuf
+
+  outbuf = inbuf;
+  flag = 1;
+  return n;
+}
@@ -21,6 +21,10 @@ CommandStyle(read_data,ReadData);
 #define LMP_READ_DATA_H
 
 #include "command.h"
+#include "lmpbinarydata.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace LAMMPS_NS {
 class Fix;
@@ -35,6 +39,7 @@ class ReadData : public Command {
   int me, compressed;
   char *line, *keyword, *buffer, *style;
   FILE *fp;
+  std::string datafile;
   char **coeffarg;
   int ncoeffarg, maxcoeffarg;
   std::string argoffset1, argoffset2;
@@ -43,6 +48,7 @@ class ReadData : public Command {
 
   int nlocal_previous;
   bigint natoms;
+  bigint atoms_end;    // file offset after Atoms section when read in parallel, -1 if unknown
   bigint nbonds, nangles, ndihedrals, nimpropers;
   int ntypes, nbondtypes, nangletypes, ndihedraltypes, nimpropertypes;
 
@@ -67,7 +73,7 @@ class ReadData : public Command {
 
   // optional args
 
-  int addflag, offsetflag, shiftflag, coeffflag, settypeflag;
+  int addflag, offsetflag, shiftflag, coeffflag, settypeflag, parallelflag, binaryflag;
   int tlabelflag, blabelflag, alabelflag, dlabelflag, ilabelflag;
   tagint addvalue;
   int toffset, boffset, aoffset, doffset, ioffset;
@@ -93,6 +99,8 @@ class ReadData : public Command {
   int style_match(const char *, const char *);
 
   void atoms();
+  void atoms_parallel();
+  void migrate_new_atoms();
   void velocities();
 
   void bonds(int);
@@ -114,6 +122,34 @@ class ReadData : public Command {
   void typelabels(int);
 
   void fix(Fix *, char *);
+
+  // binary data files
+
+  std::vector<BinaryData::Column> bincolumns;
+
+  void binary_header();
+  const BinaryData::Column *binary_column(const std::string &, int, bigint, int);
+  void binary_read(const BinaryData::Column *, bigint, bigint, void *);
+  void atoms_binary();
+  void topology_binary();
+
+  // data used by rendezvous callbacks of binary topology read
+
+  std::unordered_map<tagint, int> rvous_owner;
+
+  struct OwnerRvous {
+    int me;
+    tagint atomID;
+  };
+
+  struct TopoRvous {
+    tagint atomID;
+    tagint ids[4];
+    int type;
+  };
+
+  static int rendezvous_owners(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_topology(int, char *, int &, int *&, char *&, void *);
 };
 
 }    // namespace LAMMPS_NS
@@ -69,6 +69,10 @@ ReadDump::ReadDump(LAMMPS *lmp) : Command(lmp)
   clustercomm = MPI_COMM_NULL;
   filereader = 0;
   parallel = 0;
+
+  npartition = 1;
+  ipartition = 0;
+  nselect = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -289,6 +293,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
         readers[0]->open_file(multiname);
       } else readers[0]->open_file(files[ifile]);
 
+      readers[0]->seek(nrequest);
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
         if (eofflag) break;
@@ -303,6 +308,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
     currentfile = ifile;
     if (ntimestep < nrequest) ntimestep = -1;
     if (exact && ntimestep != nrequest) ntimestep = -1;
+    nselect = 1;
   }
 
   if (!parallel) {
@@ -332,6 +338,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
 
+      readers[i]->seek(ntimestep);
       bigint step;
       while (true) {
         eofflag = readers[i]->read_time(step);
@@ -382,6 +389,9 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
         } else readers[0]->open_file(files[ifile]);
       }
 
+      // snapshots up to Ncurrent are skipped without being counted
+
+      readers[0]->seek(ncurrent+1);
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
         if (eofflag) break;
@@ -394,6 +404,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
         iskip++;
         if (nevery && ntimestep % nevery) readers[0]->skip();
         else if (iskip < nskip) readers[0]->skip();
+        else if ((nselect++ % npartition) != ipartition) readers[0]->skip();
         else break;
       }
 
@@ -434,6 +445,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname);
 
+      readers[i]->seek(ntimestep);
       bigint step;
       while (true) {
         eofflag = readers[i]->read_time(step);
@@ -451,6 +463,28 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
   return ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   share snapshots selected by next() with other partitions
+   snapshots are assigned round-robin, starting with the one found by seek()
+------------------------------------------------------------------------- */
+
+void ReadDump::partition(int n, int i)
+{
+  npartition = n;
+  ipartition = i;
+}
+
+/* ----------------------------------------------------------------------
+   skip current snapshot found by seek() or next() without reading it
+   called by all procs, only procs which read files do something
+------------------------------------------------------------------------- */
+
+void ReadDump::skip()
+{
+  if (filereader)
+    for (int i = 0; i < nreader; i++) readers[i]->skip();
+}
+
 /* ----------------------------------------------------------------------
    read and broadcast and store snapshot header info
    set nsnapatoms = # of atoms in snapshot
@@ -37,6 +37,8 @@ class ReadDump : public Command {
   bigint seek(bigint, int);
   void header(int);
   bigint next(bigint, bigint, int, int);
+  void partition(int, int);
+  void skip();
   void atoms();
   int fields_and_keywords(int, char **);
 
@@ -60,6 +62,10 @@ class ReadDump : public Command {
   int filereader;    // 1 if this proc reads from a dump file(s)
   int parallel;      // 1 if parallel reading (e.g. via ADIOS2)
 
+  int npartition;    // # of partitions which share the snapshots of the files
+  int ipartition;    // which partition I am in, processes every Npartition-th snapshot
+  bigint nselect;    // # of snapshots selected by next() so far, incl the one found by seek()
+
   int dimension;    // same as in Domain
   int triclinic;
 
@@ -26,6 +26,7 @@
 #include "force.h"
 #include "group.h"
 #include "improper.h"
+#include "input.h"
 #include "irregular.h"
 #include "label_map.h"
 #include "memory.h"
@@ -120,6 +121,31 @@ void ReadRestart::command(int narg, char **arg)
   format_revision();
   check_eof_magic();
 
+  // a delta restart file names its full restart file in the same directory
+  // read full file first, then overwrite its state with the delta
+
+  bigint curpos = 0;
+  if (me == 0) curpos = platform::ftell(fp);
+  if (read_int() == DELTA_BASE) {
+    char *base = read_string();
+    auto basefile = platform::path_join(platform::path_dirname(file),base);
+    delete[] base;
+    if (me == 0) utils::logmesg(lmp,"  delta of restart file {}\n",basefile);
+
+    input->one(fmt::format("read_restart \"{}\" {}",basefile,remapflag ? "remap" : "noremap"));
+    if (me == 0) utils::logmesg(lmp,"Reading delta restart file ...\n");
+    read_delta(remapflag);
+
+    delete[] file;
+    delete mpiio;
+
+    MPI_Barrier(world);
+    if (comm->me == 0)
+      utils::logmesg(lmp,"  read_restart CPU = {:.3f} seconds\n",platform::walltime()-time1);
+    return;
+  }
+  if (me == 0) platform::fseek(fp,curpos);
+
   if ((comm->me == 0) && (modify->get_fix_by_style("property/atom").size() > 0))
     error->warning(FLERR, "Fix property/atom command must be specified after read_restart "
                    "to restore its data.");
@@ -410,58 +436,7 @@ void ReadRestart::command(int narg, char **arg)
   // for multiproc or MPI-IO files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc || mpiioflag) {
-
-    // if remapflag set, remap all atoms I read back to box before migrating
-
-    if (remapflag) {
-      double **x = atom->x;
-      imageint *image = atom->image;
-      int nlocal = atom->nlocal;
-
-      for (int i = 0; i < nlocal; i++)
-        domain->remap(x[i],image[i]);
-    }
-
-    // create a temporary fix to hold and migrate extra atom info
-    // necessary b/c irregular will migrate atoms
-
-    if (nextra)
-      modify->add_fix(fmt::format("_read_restart all READ_RESTART {} {}",
-                                  nextra,modify->nfix_restart_peratom));
-
-    // move atoms to new processors via irregular()
-    // turn sorting on in migrate_atoms() to avoid non-reproducible restarts
-    // in case read by different proc than wrote restart file
-    // first do map_init() since irregular->migrate_atoms() will do map_clear()
-
-    if (atom->map_style != Atom::MAP_NONE) {
-      atom->map_init();
-      atom->map_set();
-    }
-    if (domain->triclinic) domain->x2lamda(atom->nlocal);
-    auto irregular = new Irregular(lmp);
-    irregular->migrate_atoms(1);
-    delete irregular;
-    if (domain->triclinic) domain->lamda2x(atom->nlocal);
-
-    // put extra atom info held by fix back into atom->extra
-    // destroy temporary fix
-
-    if (nextra) {
-      memory->destroy(atom->extra);
-      memory->create(atom->extra,atom->nmax,nextra,"atom:extra");
-      auto fix = dynamic_cast<FixReadRestart *>(modify->get_fix_by_id("_read_restart"));
-      int *count = fix->count;
-      double **extra = fix->extra;
-      double **atom_extra = atom->extra;
-      int nlocal = atom->nlocal;
-      for (int i = 0; i < nlocal; i++)
-        for (int j = 0; j < count[i]; j++)
-          atom_extra[i][j] = extra[i][j];
-      modify->delete_fix("_read_restart");
-    }
-  }
+  if (multiproc || mpiioflag) migrate_atoms(remapflag,nextra);
 
   // check that all atoms were assigned to procs
 
@@ -582,6 +557,165 @@ std::string ReadRestart::file_search(const std::string &inpfile)
   return platform::path_join(dirname,filename);
 }
 
+/* ----------------------------------------------------------------------
+   apply delta restart file to state read from its full restart file
+   delta has header subset, groups, type arrays, force fields, fix info,
+     and per-atom records of all atoms without topology
+   each proc overwrites the atoms it owns, then atoms are migrated
+------------------------------------------------------------------------- */
+
+void ReadRestart::read_delta(int remapflag)
+{
+  bigint natoms_base = atom->natoms;
+
+  header();
+  if (atom->natoms != natoms_base)
+    error->all(FLERR,"Delta restart file does not match atom count of its full restart file");
+
+  domain->print_box("  ");
+  domain->set_initial_box(0);
+  domain->set_global_box();
+  domain->set_local_box();
+
+  group->read_restart(fp);
+  type_arrays();
+  force_fields();
+
+  // replace fix info of full file with fix info of delta file
+
+  modify->restart_deallocate(0);
+  int nextra = modify->read_restart(fp);
+  atom->nextra_store = nextra;
+  memory->destroy(atom->extra);
+  memory->create(atom->extra,atom->nmax,nextra,"atom:extra");
+
+  file_layout();
+
+  // need atom map to find owned atoms, create temporarily if necessary
+
+  int mapflag = 0;
+  if (atom->map_style == Atom::MAP_NONE) {
+    mapflag = 1;
+    atom->map_init();
+    atom->map_set();
+  }
+
+  // proc 0 reads a chunk and bcasts it to other procs
+  // each proc updates the atoms it owns, records start with x and atom ID
+
+  AtomVec *avec = atom->avec;
+  int nlocal = atom->nlocal;
+  int maxbuf = 0;
+  double *buf = nullptr;
+  bigint nmine = 0;
+
+  for (int iproc = 0; iproc < nprocs_file; iproc++) {
+    if (read_int() != PERPROC)
+      error->all(FLERR,"Invalid flag in peratom section of restart file");
+
+    int n = read_int();
+    if (n > maxbuf) {
+      maxbuf = n;
+      memory->destroy(buf);
+      memory->create(buf,maxbuf,"read_restart:buf");
+    }
+    read_double_vec(n,buf);
+
+    int m = 0;
+    while (m < n) {
+      int i = atom->map((tagint) ubuf(buf[m+4]).i);
+      if ((i >= 0) && (i < nlocal)) {
+        avec->unpack_restart_delta(i,&buf[m]);
+        nmine++;
+      }
+      m += static_cast<int> (buf[m]);
+    }
+  }
+
+  if (me == 0) {
+    fclose(fp);
+    fp = nullptr;
+  }
+  memory->destroy(buf);
+
+  bigint nall;
+  MPI_Allreduce(&nmine,&nall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (nall != atom->natoms)
+    error->all(FLERR,"Delta restart file does not match atoms of its full restart file");
+
+  if (mapflag) {
+    atom->map_delete();
+    atom->map_style = Atom::MAP_NONE;
+  }
+
+  // atoms have moved since full restart file was written
+
+  migrate_atoms(remapflag,nextra);
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   migrate atoms I own to correct procs via irregular comm
+   nextra = # of extra quantities stored with each atom
+------------------------------------------------------------------------- */
+
+void ReadRestart::migrate_atoms(int remapflag, int nextra)
+{
+  // if remapflag set, remap all atoms I read back to box before migrating
+
+  if (remapflag) {
+    double **x = atom->x;
+    imageint *image = atom->image;
+    int nlocal = atom->nlocal;
+
+    for (int i = 0; i < nlocal; i++)
+      domain->remap(x[i],image[i]);
+  }
+
+  // create a temporary fix to hold and migrate extra atom info
+  // necessary b/c irregular will migrate atoms
+
+  if (nextra)
+    modify->add_fix(fmt::format("_read_restart all READ_RESTART {} {}",
+                                nextra,modify->nfix_restart_peratom));
+
+  // move atoms to new processors via irregular()
+  // turn sorting on in migrate_atoms() to avoid non-reproducible restarts
+  // in case read by different proc than wrote restart file
+  // first do map_init() since irregular->migrate_atoms() will do map_clear()
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  auto irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1);
+  delete irregular;
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+
+  // put extra atom info held by fix back into atom->extra
+  // destroy temporary fix
+
+  if (nextra) {
+    memory->destroy(atom->extra);
+    memory->create(atom->extra,atom->nmax,nextra,"atom:extra");
+    auto fix = dynamic_cast<FixReadRestart *>(modify->get_fix_by_id("_read_restart"));
+    int *count = fix->count;
+    double **extra = fix->extra;
+    double **atom_extra = atom->extra;
+    int nlocal = atom->nlocal;
+    for (int i = 0; i < nlocal; i++)
+      for (int j = 0; j < count[i]; j++)
+        atom_extra[i][j] = extra[i][j];
+    modify->delete_fix("_read_restart");
+  }
+}
+
 /* ----------------------------------------------------------------------
    read header of restart file
 ------------------------------------------------------------------------- */
@@ -898,6 +1032,7 @@ void ReadRestart::type_arrays()
 
     } else if (flag == LABELMAP) {
       read_int();
+      delete atom->lmap;
       atom->add_label_map();
       atom->lmap->read_restart(fp);
 
@@ -47,6 +47,8 @@ class ReadRestart : public Command {
   MPI_Offset assignedChunkOffset, headerOffset;
 
   std::string file_search(const std::string &);
+  void read_delta(int);
+  void migrate_atoms(int, int);
   void header();
   void type_arrays();
   void force_fields();
@@ -84,3 +84,10 @@ void Reader::settings(int narg, char ** /*args*/)
 {
   if (narg > 0) error->all(FLERR, "Illegal read_dump command");
 }
+
+/* ----------------------------------------------------------------------
+   move to next snapshot with timestep >= Nrequest without reading the ones before
+   only for formats with an index of snapshots, others read and skip them in order
+------------------------------------------------------------------------- */
+
+void Reader::seek(bigint /*nrequest*/) {}
@@ -294,6 +294,25 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     labelline = line + strlen("ITEM: ATOMS ");
   }
 
+  if (match_fields(labelline, nfield, fieldtype, fieldlabel, scaleflag, wrapflag,
+                   fieldflag, xflag, yflag, zflag) == 0) return 1;
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   match Nfield fields to the per-atom column labels in labelline
+   allocate and set fieldindex = which column each field maps to
+   set fieldflag = -1 if any fields not found, and xyz flags
+   return # of columns, 0 if there are none
+   also used by readers of other file formats derived from this class
+------------------------------------------------------------------------- */
+
+int ReaderNative::match_fields(const std::string &labelline, int nfield,
+                               int *fieldtype, char **fieldlabel,
+                               int scaleflag, int wrapflag, int &fieldflag,
+                               int &xflag, int &yflag, int &zflag)
+{
   Tokenizer tokens(labelline);
   std::map<std::string, int> labels;
   nwords = 0;
@@ -302,16 +321,14 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     labels[tokens.next()] = nwords++;
   }
 
-
-  if (nwords == 0) {
-    return 1;
-  }
+  if (nwords == 0) return 0;
 
   // match each field with a column of per-atom data
   // if fieldlabel set, match with explicit column
   // else infer one or more column matches from fieldtype
   // xyz flag set by scaleflag + wrapflag (if fieldlabel set) or column label
 
+  memory->destroy(fieldindex);
   memory->create(fieldindex,nfield,"read_dump:fieldindex");
 
   int s_index,u_index,su_index;
@@ -432,7 +449,7 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
   for (int i = 0; i < nfield; i++)
     if (fieldindex[i] < 0) fieldflag = -1;
 
-  return natoms;
+  return nwords;
 }
 
 /* ----------------------------------------------------------------------
@@ -14,6 +14,7 @@
 
 #include "rerun.h"
 
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "finish.h"
@@ -22,10 +23,13 @@
 #include "modify.h"
 #include "output.h"
 #include "read_dump.h"
+#include "thermo.h"
 #include "timer.h"
+#include "universe.h"
 #include "update.h"
 #include "variable.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -56,6 +60,7 @@ void Rerun::command(int narg, char **arg)
     if (strcmp(arg[iarg],"stop") == 0) break;
     if (strcmp(arg[iarg],"dump") == 0) break;
     if (strcmp(arg[iarg],"post") == 0) break;
+    if (strcmp(arg[iarg],"partition") == 0) break;
     iarg++;
   }
   int nfile = iarg;
@@ -71,6 +76,7 @@ void Rerun::command(int narg, char **arg)
   int startflag = 0;
   int stopflag = 0;
   int postflag = 0;
+  int partitionflag = 0;
   bigint start = -1;
   bigint stop = -1;
 
@@ -111,6 +117,10 @@ void Rerun::command(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
       postflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"partition") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal rerun command");
+      partitionflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"dump") == 0) {
       break;
     } else error->all(FLERR,"Illegal rerun command");
@@ -134,6 +144,10 @@ void Rerun::command(int narg, char **arg)
   if (nremain) rd->setup_reader(nremain,&arg[narg-nremain]);
   else rd->setup_reader(0,nullptr);
 
+  // with partition yes, each partition processes every Nworlds-th snapshot
+
+  if (partitionflag) rd->partition(universe->nworlds,universe->iworld);
+
   // perform the pseudo run
   // invoke lmp->init() only once
   // read all relevant snapshots
@@ -159,7 +173,16 @@ void Rerun::command(int narg, char **arg)
   if (ntimestep < 0)
     error->all(FLERR,"Rerun dump file does not contain requested snapshot");
 
-  while (true) {
+  // first snapshot belongs to partition 0, others find their own first snapshot
+  // a partition may get no snapshot at all
+
+  thermo_lines.clear();
+  if (partitionflag && universe->iworld > 0) {
+    rd->skip();
+    ntimestep = rd->next(ntimestep,last,nevery,nskip);
+  }
+
+  while (ntimestep >= 0) {
     ndump++;
     rd->header(firstflag);
     update->reset_timestep(ntimestep, false);
@@ -243,18 +266,24 @@ void Rerun::command(int narg, char **arg)
     output->next_dump_any = ntimestep;
     if (firstflag) output->setup();
     else if (output->next) output->write(ntimestep);
+    if (partitionflag && (output->last_thermo == ntimestep))
+      thermo_lines.emplace_back(ntimestep,output->thermo->get_line());
 
     firstflag = 0;
     ntimestep = rd->next(ntimestep,last,nevery,nskip);
     if (stopflag && ntimestep > stop)
       error->all(FLERR,"Read rerun dump file timestep {} > specified stop {}", ntimestep, stop);
-    if (ntimestep < 0) break;
   }
 
   // ensure thermo output on last dump timestep
 
-  output->next_thermo = update->ntimestep;
-  output->write(update->ntimestep);
+  if (ndump) {
+    output->next_thermo = update->ntimestep;
+    output->write(update->ntimestep);
+    if (partitionflag && (thermo_lines.empty() || (thermo_lines.back().first != update->ntimestep)))
+      thermo_lines.emplace_back(update->ntimestep,output->thermo->get_line());
+  } else if (comm->me == 0)
+    utils::logmesg(lmp,"No dump snapshots left for this partition\n");
 
   timer->barrier_stop();
 
@@ -264,8 +293,11 @@ void Rerun::command(int narg, char **arg)
 
   update->nsteps = ndump;
 
-  Finish finish(lmp);
-  finish.end(postflag);
+  if (ndump) {
+    Finish finish(lmp);
+    finish.end(postflag);
+  }
+  if (partitionflag && (universe->nworlds > 1)) merge_thermo();
 
   update->whichflag = 0;
   update->firststep = update->laststep = 0;
@@ -275,3 +307,83 @@ void Rerun::command(int narg, char **arg)
 
   delete rd;
 }
+
+/* ----------------------------------------------------------------------
+   send thermo output of all partitions to universe proc 0
+   which prints it to universe screen and logfile in timestep order
+------------------------------------------------------------------------- */
+
+void Rerun::merge_thermo()
+{
+  MPI_Comm roots;
+  int root = (comm->me == 0) ? 1 : 0;
+  MPI_Comm_split(universe->uworld,root ? 0 : MPI_UNDEFINED,universe->me,&roots);
+  if (!root) return;
+
+  int iroot,nroots;
+  MPI_Comm_rank(roots,&iroot);
+  MPI_Comm_size(roots,&nroots);
+
+  int n = thermo_lines.size();
+  std::vector<bigint> steps(n);
+  std::vector<int> lengths(n);
+  std::string text;
+  for (int i = 0; i < n; i++) {
+    steps[i] = thermo_lines[i].first;
+    lengths[i] = thermo_lines[i].second.size();
+    text += thermo_lines[i].second;
+  }
+  int ntext = text.size();
+
+  std::vector<int> counts(nroots), tcounts(nroots), displs(nroots), tdispls(nroots);
+  MPI_Gather(&n,1,MPI_INT,counts.data(),1,MPI_INT,0,roots);
+  MPI_Gather(&ntext,1,MPI_INT,tcounts.data(),1,MPI_INT,0,roots);
+
+  int nall = 0, ntextall = 0;
+  if (iroot == 0) {
+    for (int i = 0; i < nroots; i++) {
+      displs[i] = nall;
+      tdispls[i] = ntextall;
+      nall += counts[i];
+      ntextall += tcounts[i];
+    }
+  }
+
+  std::vector<bigint> allsteps(nall);
+  std::vector<int> alllengths(nall);
+  std::vector<char> alltext(ntextall+1);
+  MPI_Gatherv(steps.data(),n,MPI_LMP_BIGINT,allsteps.data(),counts.data(),displs.data(),
+              MPI_LMP_BIGINT,0,roots);
+  MPI_Gatherv(lengths.data(),n,MPI_INT,alllengths.data(),counts.data(),displs.data(),
+              MPI_INT,0,roots);
+  MPI_Gatherv(text.data(),ntext,MPI_CHAR,alltext.data(),tcounts.data(),tdispls.data(),
+              MPI_CHAR,0,roots);
+  MPI_Comm_free(&roots);
+
+  if (iroot) return;
+
+  // offset of each line in gathered text, then sort lines by timestep
+
+  std::vector<int> offsets(nall), order(nall);
+  int offset = 0;
+  for (int i = 0; i < nall; i++) {
+    offsets[i] = offset;
+    offset += alllengths[i];
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(),order.end(),
+                   [&allsteps](int a, int b) { return allsteps[a] < allsteps[b]; });
+
+  const std::string &header = output->thermo->get_header();
+  std::string mesg = fmt::format("Rerun thermo output of {} partitions in timestep order:\n",
+                                 nroots);
+  mesg += header;
+  for (const auto &i : order) mesg.append(&alltext[offsets[i]],alllengths[i]);
+  if (utils::strmatch(header,"^---")) mesg += "...\n";
+
+  if (universe->uscreen) fputs(mesg.c_str(),universe->uscreen);
+  if (universe->ulogfile) {
+    fputs(mesg.c_str(),universe->ulogfile);
+    fflush(universe->ulogfile);
+  }
+}
@@ -22,12 +22,20 @@ CommandStyle(rerun,Rerun);
 
 #include "command.h"
 
+#include <string>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class Rerun : public Command {
  public:
   Rerun(class LAMMPS *);
   void command(int, char **) override;
+
+ private:
+  std::vector<std::pair<bigint, std::string>> thermo_lines;    // thermo output per snapshot
+
+  void merge_thermo();
 };
 
 }    // namespace LAMMPS_NS
@@ -290,6 +290,9 @@ void Respa::init()
   if (modify->nfix == 0 && comm->me == 0)
     error->warning(FLERR, "No fixes defined, atoms won't move");
 
+  if (force->kspace && force->kspace->mts_every > 1)
+    error->all(FLERR, "Kspace_modify every requires run_style verlet, use a respa kspace level");
+
   // create fix needed for storing atom-based respa level forces
   // will delete it at end of run
   // if supported, we also store torques on a per-level basis
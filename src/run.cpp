@@ -19,6 +19,7 @@
 #include "finish.h"
 #include "input.h"
 #include "integrate.h"
+#include "memory.h"
 #include "modify.h"
 #include "output.h"
 #include "timer.h"
@@ -173,7 +174,9 @@ void Run::command(int narg, char **arg)
 
     timer->init();
     timer->barrier_start();
+    memory->trace_start();
     update->integrate->run(nsteps);
+    memory->trace_stop(update->ntimestep - update->firststep);
     timer->barrier_stop();
 
     update->integrate->cleanup();
@@ -214,7 +217,9 @@ void Run::command(int narg, char **arg)
 
       timer->init();
       timer->barrier_start();
+      memory->trace_start();
       update->integrate->run(nsteps);
+      memory->trace_stop(update->ntimestep - update->firststep);
       timer->barrier_stop();
 
       update->integrate->cleanup();
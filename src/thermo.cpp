@@ -47,6 +47,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 
 using namespace LAMMPS_NS;
@@ -335,9 +336,9 @@ void Thermo::init()
 
 void Thermo::header()
 {
+  hdr.clear();
   if (lineflag == MULTILINE) return;
 
-  std::string hdr;
   if (lineflag == YAMLLINE) hdr = "---\nkeywords: [";
   for (int i = 0; i < nfield; i++) {
     auto head = keyword[i];
@@ -355,7 +356,8 @@ void Thermo::header()
   else
     hdr.resize(hdr.size() - 1);    // chop off trailing blank
 
-  if (comm->me == 0) utils::logmesg(lmp, hdr + "\n");
+  hdr += "\n";
+  if (comm->me == 0) utils::logmesg(lmp, hdr);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -412,7 +414,7 @@ void Thermo::compute(int flag)
       cpu = timer->elapsed(Timer::TOTAL);
     else
       cpu = 0.0;
-    line += fmt::format(FORMAT_MULTI_HEADER, ntimestep, cpu);
+    fmt::format_to(std::back_inserter(line), FORMAT_MULTI_HEADER, ntimestep, cpu);
   }
 
   // add each thermo value to line with its specific format
@@ -47,11 +47,13 @@ class Thermo : protected Pointers {
   const bigint *get_timestep() const { return &ntimestep; }
   const std::vector<multitype> &get_fields() const { return field_data; }
   const std::vector<std::string> &get_keywords() const { return keyword; }
+  const std::string &get_header() const { return hdr; }
+  const std::string &get_line() const { return line; }
 
  private:
   int nfield, nfield_initial;
   int *vtype;
-  std::string line;
+  std::string line, hdr;
   std::vector<std::string> keyword, format, format_column_user, keyword_user;
   std::string format_line_user, format_float_user, format_int_user, format_bigint_user;
   std::map<std::string, int> key2col;
@@ -16,9 +16,11 @@
 #include "comm.h"
 #include "error.h"
 #include "fmt/chrono.h"
+#include "update.h"
 
 #include <cstring>
 #include <ctime>
+#include <functional>
 
 using namespace LAMMPS_NS;
 
@@ -32,6 +34,12 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
   _s_timeout = -1;
   _checkfreq = 10;
   _nextcheck = -1;
+  _trace_sample = 100;
+  _trace_every = 0;
+  _tracing = 0;
+  _trace_dirty = 0;
+  _trace_step = 0;
+  _trace_origin = _trace_start = 0.0;
   this->_stamp(RESET);
 }
 
@@ -43,6 +51,28 @@ void Timer::init()
     cpu_array[i] = 0.0;
     wall_array[i] = 0.0;
   }
+  for (auto &sub : subs) {
+    sub.wall = 0.0;
+    sub.count = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return index of sub-timer with name below parent sub-timer or category
+   sub-timer is created if it does not exist, -1 if timer level is not full
+   must be called in the same order on all MPI ranks
+------------------------------------------------------------------------- */
+
+int Timer::sub_timer(enum ttype category, const std::string &name, int parent)
+{
+  if ((_level < FULL) && !_trace_every) return -1;
+
+  for (int i = 0; i < (int) subs.size(); ++i)
+    if ((subs[i].category == category) && (subs[i].parent == parent) && (subs[i].name == name))
+      return i;
+
+  subs.push_back({name, category, parent, 0.0, 0.0, 0});
+  return (int) subs.size() - 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -62,6 +92,8 @@ void Timer::_stamp(enum ttype which)
     wall_array[which] += delta_wall;
     cpu_array[ALL] += delta_cpu;
     wall_array[ALL] += delta_wall;
+    if (_tracing)
+      trace.push_back({which, MAX(previous_wall, _trace_start), current_wall, _trace_step});
   }
 
   previous_cpu = current_cpu;
@@ -80,6 +112,7 @@ void Timer::_stamp(enum ttype which)
 
     cpu_array[SYNC] += current_cpu - previous_cpu;
     wall_array[SYNC] += current_wall - previous_wall;
+    if (_tracing) trace.push_back({SYNC, previous_wall, current_wall, _trace_step});
     previous_cpu = current_cpu;
     previous_wall = current_wall;
   }
@@ -112,6 +145,8 @@ void Timer::barrier_stop()
 
   MPI_Barrier(world);
 
+  if (_trace_dirty) write_trace();
+
   if (_level < LOOP) return;
 
   current_cpu = platform::cputime();
@@ -231,6 +266,37 @@ void Timer::modify_params(int narg, char **arg)
         _timeout = utils::timespec2seconds(arg[iarg]);
       } else
         error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "export") == 0) {
+      ++iarg;
+      if (iarg < narg) {
+        if (strcmp(arg[iarg], "none") == 0)
+          exportfile.clear();
+        else
+          exportfile = arg[iarg];
+      } else
+        error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "trace") == 0) {
+      ++iarg;
+      if (iarg < narg) {
+        trace.clear();
+        _trace_dirty = 0;
+        if (strcmp(arg[iarg], "none") == 0) {
+          tracefile.clear();
+          _trace_every = 0;
+        } else {
+          tracefile = arg[iarg];
+          MPI_Barrier(world);
+          _trace_origin = platform::walltime();
+        }
+      } else
+        error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "sample") == 0) {
+      ++iarg;
+      if (iarg < narg) {
+        _trace_sample = utils::inumeric(FLERR, arg[iarg], false, lmp);
+        if (_trace_sample <= 0) error->all(FLERR, "Illegal timer command");
+      } else
+        error->all(FLERR, "Illegal timer command");
     } else if (strcmp(arg[iarg], "every") == 0) {
       ++iarg;
       if (iarg < narg) {
@@ -243,6 +309,8 @@ void Timer::modify_params(int narg, char **arg)
     ++iarg;
   }
 
+  if (!tracefile.empty()) _trace_every = _trace_sample;
+
   timeout_start = platform::walltime();
   if (comm->me == 0) {
 
@@ -257,3 +325,250 @@ void Timer::modify_params(int narg, char **arg)
                    timer_mode[_sync], timeout);
   }
 }
+
+/* ----------------------------------------------------------------------
+   collect timings of the last run from all MPI ranks into a tree of
+   sections and their sub-timers and keep it as JSON text
+   sub-timers without own measurement report the sum of their children
+   write JSON or CSV file depending on the export file name suffix
+------------------------------------------------------------------------- */
+
+static const char *timer_name[] = {"Total", "Pair", "Bond",   "Kspace", "Neigh",
+                                   "Comm",  "Modify", "Output", "Sync",  "Other"};
+static constexpr int NUM_SECTION = Timer::SYNC + 1;
+
+static std::string json_quote(const std::string &text)
+{
+  std::string quoted = "\"";
+  for (const auto &c : text) {
+    if ((c == '"') || (c == '\\')) quoted += '\\';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+void Timer::summarize(double time_loop)
+{
+  int me, nprocs;
+  MPI_Comm_rank(world, &me);
+  MPI_Comm_size(world, &nprocs);
+
+  // sub-timers are only usable if they were registered identically on all ranks
+
+  int nsub = subs.size(), nsubmin, nsubmax;
+  MPI_Allreduce(&nsub, &nsubmin, 1, MPI_INT, MPI_MIN, world);
+  MPI_Allreduce(&nsub, &nsubmax, 1, MPI_INT, MPI_MAX, world);
+  if (nsubmin != nsubmax) {
+    if (me == 0) error->warning(FLERR, "Sub-timers differ between MPI ranks and are not exported");
+    nsub = 0;
+  }
+
+  // one value per section including "Other", followed by sub-timers
+
+  const int n = NUM_SECTION + 1 + nsub;
+  std::vector<double> local(n, 0.0), tmin(n), tmax(n), tsum(n);
+  std::vector<bigint> count(nsub, 0), cmax(nsub);
+
+  double other = wall_array[TOTAL];
+  for (int i = PAIR; i < NUM_SECTION; ++i) {
+    local[i] = wall_array[i];
+    other -= wall_array[i];
+  }
+  local[NUM_SECTION] = other;
+
+  for (int i = 0; i < nsub; ++i) {
+    if (subs[i].count > 0) local[NUM_SECTION + 1 + i] += subs[i].wall;
+    count[i] = subs[i].count;
+  }
+  for (int i = nsub - 1; i >= 0; --i)
+    if ((subs[i].parent >= 0) && (subs[subs[i].parent].count == 0))
+      local[NUM_SECTION + 1 + subs[i].parent] += local[NUM_SECTION + 1 + i];
+
+  MPI_Allreduce(local.data(), tmin.data(), n, MPI_DOUBLE, MPI_MIN, world);
+  MPI_Allreduce(local.data(), tmax.data(), n, MPI_DOUBLE, MPI_MAX, world);
+  MPI_Allreduce(local.data(), tsum.data(), n, MPI_DOUBLE, MPI_SUM, world);
+  if (nsub > 0) MPI_Allreduce(count.data(), cmax.data(), nsub, MPI_LMP_BIGINT, MPI_MAX, world);
+
+  if (time_loop <= 0.0) time_loop = 1.0;
+
+  // recursively format sections and sub-timers that were used during the run
+  // the same tree is also flattened into CSV rows with ':' separated paths
+
+  std::string csv = "section,calls,min,avg,max,percent\n";
+
+  std::function<std::string(int, int, const std::string &, const std::string &)> node =
+      [&](int idx, int category, const std::string &name, const std::string &path) {
+        const int k = (idx < 0) ? category : NUM_SECTION + 1 + idx;
+        const double avg = tsum[k] / nprocs;
+        const bigint calls = (idx < 0) ? 0 : cmax[idx];
+        const std::string ncalls = (calls > 0) ? std::to_string(calls) : "";
+        csv += fmt::format("\"{}\",{},{:.6g},{:.6g},{:.6g},{:.2f}\n", path, ncalls, tmin[k], avg,
+                           tmax[k], avg / time_loop * 100.0);
+
+        std::string children;
+        if (category < NUM_SECTION) {
+          for (int i = 0; i < nsub; ++i) {
+            if ((subs[i].category != category) || (subs[i].parent != idx)) continue;
+            if ((cmax[i] == 0) && (tmax[NUM_SECTION + 1 + i] == 0.0)) continue;
+            if (!children.empty()) children += ", ";
+            children += node(i, category, subs[i].name, path + ":" + subs[i].name);
+          }
+        }
+        auto text = fmt::format("{{\"name\": {}, ", json_quote(name));
+        if (calls > 0) text += fmt::format("\"calls\": {}, ", calls);
+        text += fmt::format("\"min\": {:.6g}, \"avg\": {:.6g}, \"max\": {:.6g}, \"percent\": {:.2f}",
+                            tmin[k], avg, tmax[k], avg / time_loop * 100.0);
+        if (!children.empty()) text += ", \"children\": [" + children + "]";
+        return text + "}";
+      };
+
+  std::string sections;
+  for (int i = PAIR; i <= NUM_SECTION; ++i) {
+    if (!sections.empty()) sections += ",\n    ";
+    sections += node(-1, i, timer_name[i], timer_name[i]);
+  }
+
+  summary = fmt::format("{{\n  \"timestep\": {}, \"nsteps\": {}, \"nprocs\": {}, \"nthreads\": {}, "
+                        "\"level\": \"{}\", \"loop_time\": {:.6g},\n  \"timers\": [\n    {}\n  ]\n}}\n",
+                        update->ntimestep, update->nsteps, nprocs, comm->nthreads,
+                        (_level == FULL) ? "full" : "normal", time_loop, sections);
+
+  if ((me == 0) && !exportfile.empty()) {
+    auto file = utils::star_subst(exportfile, update->ntimestep, 0);
+    FILE *fp = fopen(file.c_str(), "w");
+    if (!fp) {
+      error->warning(FLERR, "Cannot open timer export file {}: {}", file, utils::getsyserror());
+    } else {
+      fputs(utils::strmatch(file, "\\.csv$") ? csv.c_str() : summary.c_str(), fp);
+      fclose(fp);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start recording trace events, if timestep is sampled
+   all MPI ranks sample the same timesteps
+------------------------------------------------------------------------- */
+
+void Timer::_trace_begin(bigint step)
+{
+  if (step % _trace_every) return;
+  _tracing = 1;
+  _trace_step = step;
+  _trace_start = platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   end of traced timestep: time spent waiting for the slowest MPI rank
+   is recorded as MPI wait and added to the Sync section
+------------------------------------------------------------------------- */
+
+void Timer::_trace_end()
+{
+  const double wait_start = platform::walltime();
+  MPI_Barrier(world);
+  const double wait_stop = platform::walltime();
+
+  trace.push_back({TRACE_WAIT, wait_start, wait_stop, _trace_step});
+  trace.push_back({TRACE_STEP, _trace_start, wait_stop, _trace_step});
+  _tracing = 0;
+  _trace_dirty = 1;
+
+  if (_level > LOOP) {
+    wall_array[SYNC] += wait_stop - previous_wall;
+    previous_wall = wait_stop;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write all trace events recorded so far in Chrome trace event format
+   with one process per MPI rank and timestamps in microseconds
+   one file per rank if file name contains '%', else all ranks in one file
+------------------------------------------------------------------------- */
+
+void Timer::write_trace()
+{
+  int me, nprocs;
+  MPI_Comm_rank(world, &me);
+  MPI_Comm_size(world, &nprocs);
+  _trace_dirty = 0;
+
+  // full names of sub-timers include names of their parents
+
+  std::vector<std::string> subname(subs.size());
+  for (std::size_t i = 0; i < subs.size(); ++i) {
+    if (subs[i].parent < 0)
+      subname[i] = subs[i].name;
+    else
+      subname[i] = subname[subs[i].parent] + " " + subs[i].name;
+  }
+
+  std::string events = fmt::format("{{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": {}, "
+                                   "\"tid\": 0, \"args\": {{\"name\": \"MPI rank {}\"}}}}",
+                                   me, me);
+  for (const auto &event : trace) {
+    std::string name, cat;
+    if (event.id == TRACE_STEP) {
+      name = fmt::format("Step {}", event.step);
+      cat = "Step";
+    } else if (event.id == TRACE_WAIT) {
+      name = "MPI wait";
+      cat = timer_name[SYNC];
+    } else if (event.id >= TRACE_SUB) {
+      name = subname[event.id - TRACE_SUB];
+      cat = timer_name[subs[event.id - TRACE_SUB].category];
+    } else {
+      name = cat = timer_name[event.id];
+    }
+    events += fmt::format(",\n{{\"name\": {}, \"cat\": \"{}\", \"ph\": \"X\", \"ts\": {:.3f}, "
+                          "\"dur\": {:.3f}, \"pid\": {}, \"tid\": 0, \"args\": {{\"step\": {}}}}}",
+                          json_quote(name), cat, 1.0e6 * (event.start - _trace_origin),
+                          1.0e6 * (event.stop - event.start), me, event.step);
+  }
+
+  const char *header = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  const char *footer = "\n]}\n";
+
+  if (tracefile.find('%') != std::string::npos) {
+    auto file = tracefile;
+    file.replace(file.find('%'), 1, std::to_string(me));
+    FILE *fp = fopen(file.c_str(), "w");
+    if (!fp) error->one(FLERR, "Cannot open trace file {}: {}", file, utils::getsyserror());
+    fmt::print(fp, "{}{}{}", header, events, footer);
+    fclose(fp);
+    return;
+  }
+
+  // collect events of all ranks on rank 0, one rank at a time
+
+  FILE *fp = nullptr;
+  int flag = 0;
+  if (me == 0) {
+    fp = fopen(tracefile.c_str(), "w");
+    if (!fp) flag = 1;
+  }
+  MPI_Bcast(&flag, 1, MPI_INT, 0, world);
+  if (flag) error->all(FLERR, "Cannot open trace file {}", tracefile);
+
+  if (me == 0) {
+    fmt::print(fp, "{}{}", header, events);
+    std::string buf;
+    for (int iproc = 1; iproc < nprocs; ++iproc) {
+      int len;
+      MPI_Status status;
+      MPI_Send(&flag, 0, MPI_INT, iproc, 0, world);
+      MPI_Recv(&len, 1, MPI_INT, iproc, 0, world, &status);
+      buf.resize(len);
+      MPI_Recv(&buf[0], len, MPI_CHAR, iproc, 0, world, &status);
+      fmt::print(fp, ",\n{}", buf);
+    }
+    fputs(footer, fp);
+    fclose(fp);
+  } else {
+    int len = events.size();
+    MPI_Status status;
+    MPI_Recv(&flag, 0, MPI_INT, 0, 0, world, &status);
+    MPI_Send(&len, 1, MPI_INT, 0, 0, world);
+    MPI_Send(&events[0], len, MPI_CHAR, 0, 0, world);
+  }
+}
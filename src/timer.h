@@ -104,6 +104,44 @@ class Timer : protected Pointers {
 
   void modify_params(int, char **);
 
+  // sub-timers below a category, e.g. per fix and callback in Modify
+  // only recorded with full detail or tracing, otherwise sub_timer() returns -1
+
+  int sub_timer(enum ttype, const std::string &, int parent = -1);
+
+  void sub_start(int id)
+  {
+    if (id >= 0) subs[id].start = platform::walltime();
+  }
+
+  void sub_stop(int id)
+  {
+    if (id >= 0) {
+      const double now = platform::walltime();
+      subs[id].wall += now - subs[id].start;
+      ++subs[id].count;
+      if (_tracing) trace.push_back({TRACE_SUB + id, subs[id].start, now, _trace_step});
+    }
+  }
+
+  // trace regions of every Nth timestep, called by the integrator at
+  // the beginning and end of each timestep
+
+  void trace_begin(bigint step)
+  {
+    if (_trace_every > 0) _trace_begin(step);
+  }
+  void trace_end()
+  {
+    if (_tracing) _trace_end();
+  }
+
+  // reduce timings of the last run across MPI ranks, export them
+  // and keep them as JSON text for the library interface
+
+  void summarize(double);
+  const std::string &get_summary() const { return summary; }
+
  private:
   double cpu_array[NUM_TIMER];
   double wall_array[NUM_TIMER];
@@ -117,11 +155,46 @@ class Timer : protected Pointers {
   int _checkfreq;    // frequency of timeout checking
   int _nextcheck;    // loop number of next timeout check
 
+  struct SubTimer {
+    std::string name;
+    int category;    // Timer category the sub-timer belongs to
+    int parent;      // index of parent sub-timer, -1 if directly below category
+    double start, wall;
+    bigint count;
+  };
+  std::vector<SubTimer> subs;
+
+  std::string exportfile;    // file for timings at end of each run, empty if none
+  std::string summary;       // JSON text with timings of last run
+
+  // trace events are sections, sub-timers, MPI wait, and whole timesteps
+
+  enum { TRACE_STEP = -2, TRACE_WAIT = -1, TRACE_SUB = NUM_TIMER };
+  struct TraceEvent {
+    int id;    // section, TRACE_SUB + sub-timer index, or TRACE_STEP/TRACE_WAIT
+    double start, stop;
+    bigint step;
+  };
+  std::vector<TraceEvent> trace;
+
+  std::string tracefile;    // file for trace events, empty if none
+  int _trace_sample;        // trace every Nth timestep
+  int _trace_every;         // same as _trace_sample while tracing is on, else 0
+  int _tracing;             // 1 while in a traced timestep
+  int _trace_dirty;         // 1 if events were added since last write
+  bigint _trace_step;       // current traced timestep
+  double _trace_origin;     // wall time of trace start
+  double _trace_start;      // wall time of begin of current traced timestep
+
   // update one specific timer array
   void _stamp(enum ttype);
 
   // check for timeout
   bool _check_timeout();
+
+  void _trace_begin(bigint);
+  void _trace_end();
+  void write_trace();
 };
 
 }    // namespace LAMMPS_NS
@@ -1425,8 +1425,11 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
       }
       int istop = i - 1;
 
+      // copy into buffer on the stack, so that evaluation does no heap allocation
+
       int n = istop - istart + 1;
-      auto number = new char[n+1];
+      char numbuf[MAXLINE];
+      char *number = (n < MAXLINE) ? numbuf : new char[n+1];
       strncpy(number,&str[istart],n);
       number[n] = '\0';
 
@@ -1437,7 +1440,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
         treestack[ntreestack++] = newtree;
       } else argstack[nargstack++] = atof(number);
 
-      delete[] number;
+      if (number != numbuf) delete[] number;
 
     // ----------------
     // letter: c_ID, c_ID[], c_ID[][], f_ID, f_ID[], f_ID[][],
@@ -1457,7 +1460,8 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
       int istop = i-1;
 
       int n = istop - istart + 1;
-      auto word = new char[n+1];
+      char wordbuf[MAXLINE];
+      char *word = (n < MAXLINE) ? wordbuf : new char[n+1];
       strncpy(word,&str[istart],n);
       word[n] = '\0';
 
@@ -2159,7 +2163,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
         }
       }
 
-      delete[] word;
+      if (word != wordbuf) delete[] word;
 
     // ----------------
     // math operator, including end-of-string
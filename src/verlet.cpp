@@ -19,13 +19,16 @@
 #include "atom_vec.h"
 #include "bond.h"
 #include "comm.h"
+#include "compute.h"
 #include "dihedral.h"
 #include "domain.h"
 #include "error.h"
 #include "fix.h"
+#include "fix_store_atom.h"
 #include "force.h"
 #include "improper.h"
 #include "kspace.h"
+#include "memory.h"
 #include "modify.h"
 #include "neighbor.h"
 #include "output.h"
@@ -40,7 +43,23 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 Verlet::Verlet(LAMMPS *lmp, int narg, char **arg) :
-  Integrate(lmp, narg, arg) {}
+  Integrate(lmp, narg, arg), fkspace(nullptr), fix_kspace(nullptr)
+{
+  kspace_every = 1;
+  kspace_extrapolate = 0;
+  nkspace_skip = 0;
+  kspace_eflag = 0;
+  kspace_estart = 0.0;
+  nmax_fkspace = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+Verlet::~Verlet()
+{
+  memory->destroy(fkspace);
+  if (fix_kspace && modify->get_fix_by_id("VERLET_KSPACE")) modify->delete_fix("VERLET_KSPACE");
+}
 
 /* ----------------------------------------------------------------------
    initialization before run
@@ -84,6 +103,34 @@ void Verlet::init()
   // orthogonal vs triclinic simulation box
 
   triclinic = domain->triclinic;
+
+  // multiple time stepping for kspace
+  // styles that reduce forces themselves or write kspace forces to ghost
+  //   atoms outside of compute() cannot have their contribution isolated
+  // extrapolated forces are stored per atom, so they migrate with the atoms
+  //   and are kept across runs, since a run with pre no continues to use them
+
+  kspace_every = 1;
+  kspace_extrapolate = 0;
+  fix_kspace = dynamic_cast<FixStoreAtom *>(modify->get_fix_by_id("VERLET_KSPACE"));
+  if (force->kspace && kspace_compute_flag && force->kspace->mts_every > 1) {
+    kspace_every = force->kspace->mts_every;
+    kspace_extrapolate = force->kspace->mts_extrapolate;
+    const std::string kstyle = force->kspace_style;
+    if (utils::strmatch(kstyle,"/omp$") || utils::strmatch(kstyle,"/intel$") ||
+        utils::strmatch(kstyle,"/gpu$") || utils::strmatch(kstyle,"/kk"))
+      error->all(FLERR,"Kspace_modify every is not supported by kspace style {}",
+                 force->kspace_style);
+    if (kspace_extrapolate && force->kspace->tip4pflag)
+      error->all(FLERR,"Kspace_modify mts extrapolate is not supported by TIP4P kspace styles");
+    if (kspace_extrapolate && !fix_kspace)
+      fix_kspace = dynamic_cast<FixStoreAtom *>(
+        modify->add_fix("VERLET_KSPACE all STORE/ATOM 6 0 0 0"));
+  }
+  if (!kspace_extrapolate && fix_kspace) {
+    modify->delete_fix("VERLET_KSPACE");
+    fix_kspace = nullptr;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -103,6 +150,10 @@ void Verlet::setup(int flag)
     }
   }
 
+  if ((kspace_every > 1) && (comm->me == 0))
+    utils::logmesg(lmp,"  KSpace every : {} steps ({})\n", kspace_every,
+                   kspace_extrapolate ? "extrapolate" : "impulse");
+
   if (lmp->kokkos)
     error->all(FLERR,"KOKKOS package requires run_style verlet/kk");
 
@@ -147,9 +198,12 @@ void Verlet::setup(int flag)
     if (force->improper) force->improper->compute(eflag,vflag);
   }
 
+  kspace_nhistory = 0;
+  kspace_next = update->ntimestep;
+
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
+    if (kspace_compute_flag) kspace_compute_mts(update->ntimestep,1);
     else force->kspace->compute_dummy(eflag,vflag);
   }
 
@@ -209,9 +263,14 @@ void Verlet::setup_minimal(int flag)
     if (force->improper) force->improper->compute(eflag,vflag);
   }
 
+  // restart kspace time stepping schedule with the current step, as in setup()
+
+  kspace_nhistory = 0;
+  kspace_next = update->ntimestep;
+
   if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
+    if (kspace_compute_flag) kspace_compute_mts(update->ntimestep,1);
     else force->kspace->compute_dummy(eflag,vflag);
   }
 
@@ -243,6 +302,8 @@ void Verlet::run(int n)
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
 
+  if (kspace_every > 1) kspace_mts_start();
+
   for (int i = 0; i < n; i++) {
     if (timer->check_timeout(i)) {
       update->nsteps = i;
@@ -251,6 +312,7 @@ void Verlet::run(int n)
 
     ntimestep = ++update->ntimestep;
     ev_set(ntimestep);
+    timer->trace_begin(ntimestep);
 
     // initial time integration
 
@@ -326,7 +388,8 @@ void Verlet::run(int n)
     }
 
     if (kspace_compute_flag) {
-      force->kspace->compute(eflag,vflag);
+      if (kspace_every > 1) kspace_compute_mts(ntimestep,0);
+      else force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
     }
 
@@ -356,6 +419,8 @@ void Verlet::run(int n)
       output->write(ntimestep);
       timer->stamp(Timer::OUTPUT);
     }
+
+    timer->trace_end();
   }
 }
 
@@ -366,6 +431,123 @@ void Verlet::cleanup()
   modify->post_run();
   domain->box_too_small_check();
   update->update_time();
+
+  // report skipped invocations and total energy drift of this run
+
+  if (kspace_every > 1) {
+    double eend;
+    int eflag_end = kspace_mts_energy(eend);
+    if (comm->me == 0) {
+      utils::logmesg(lmp,"KSpace skipped on {} of {} steps with kspace_modify every {}\n",
+                     nkspace_skip, update->nsteps, kspace_every);
+      if (kspace_eflag && eflag_end && atom->natoms && update->nsteps)
+        utils::logmesg(lmp,"  total energy drift: {:.8g} per atom per step "
+                       "({:.8g} -> {:.8g})\n", (eend - kspace_estart) /
+                       (double) atom->natoms / (double) update->nsteps, kspace_estart, eend);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start of a run with kspace_modify every
+   also called for runs with pre no, which skip setup()
+------------------------------------------------------------------------- */
+
+void Verlet::kspace_mts_start()
+{
+  nkspace_skip = 0;
+  kspace_eflag = kspace_mts_energy(kspace_estart);
+}
+
+/* ----------------------------------------------------------------------
+   total energy = potential + kinetic energy of thermo computes
+   return 0 if energy was not tallied on current step
+------------------------------------------------------------------------- */
+
+int Verlet::kspace_mts_energy(double &etotal)
+{
+  if (update->eflag_global != update->ntimestep) return 0;
+  Compute *pe = modify->get_compute_by_id("thermo_pe");
+  Compute *temperature = modify->get_compute_by_id("thermo_temp");
+  if (!pe || !temperature) return 0;
+
+  double t = temperature->compute_scalar();
+  etotal = pe->compute_scalar() + 0.5 * temperature->dof * force->boltz * t;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   invoke kspace only every kspace_every steps
+   impulse: kspace force is applied N times as strong on steps it is
+     computed and not at all in between, equivalent to an r-RESPA outer
+     level kick around the kspace step
+   extrapolate: kspace force is linearly extrapolated from the last two
+     evaluations on the steps in between
+   kspace energy and virial are from the last evaluation, so on evaluation
+     steps they are also tallied, if thermo output falls before the next one
+------------------------------------------------------------------------- */
+
+void Verlet::kspace_compute_mts(bigint ntimestep, int setupflag)
+{
+  int nlocal = atom->nlocal;
+  int nall = nlocal;
+  if (force->newton) nall += atom->nghost;
+  double **f = atom->f;
+
+  if (setupflag && (kspace_every == 1)) {
+    force->kspace->compute(eflag,vflag);
+    return;
+  }
+
+  if (ntimestep < kspace_next) {
+    nkspace_skip++;
+    if (kspace_extrapolate && kspace_nhistory) {
+      double **fk = fix_kspace->astore;
+      double frac = (double) (ntimestep - kspace_last) / kspace_every;
+      for (int i = 0; i < nlocal; i++) {
+        f[i][0] += fk[i][0] + frac * (fk[i][0] - fk[i][3]);
+        f[i][1] += fk[i][1] + frac * (fk[i][1] - fk[i][4]);
+        f[i][2] += fk[i][2] + frac * (fk[i][2] - fk[i][5]);
+      }
+    }
+    return;
+  }
+
+  int keflag = eflag;
+  int kvflag = vflag;
+  if (output->next_thermo < ntimestep + kspace_every) {
+    if (nelist_global) keflag |= ENERGY_GLOBAL;
+    if (nvlist_global) kvflag |= virial_style;
+  }
+
+  if (atom->nmax > nmax_fkspace) {
+    memory->destroy(fkspace);
+    nmax_fkspace = atom->nmax;
+    memory->create(fkspace,nmax_fkspace,3,"verlet:fkspace");
+  }
+  if (nall) memcpy(&fkspace[0][0],&f[0][0],3*sizeof(double)*nall);
+
+  force->kspace->compute(keflag,kvflag);
+  kspace_last = ntimestep;
+  kspace_next = ntimestep + kspace_every;
+
+  if (kspace_extrapolate) {
+    double **fk = fix_kspace->astore;
+    for (int i = 0; i < nlocal; i++) {
+      for (int k = 0; k < 3; k++) {
+        double fnew = f[i][k] - fkspace[i][k];
+        fk[i][k+3] = kspace_nhistory ? fk[i][k] : fnew;
+        fk[i][k] = fnew;
+      }
+    }
+    kspace_nhistory++;
+  } else {
+    for (int i = 0; i < nall; i++) {
+      f[i][0] = fkspace[i][0] + kspace_every * (f[i][0] - fkspace[i][0]);
+      f[i][1] = fkspace[i][1] + kspace_every * (f[i][1] - fkspace[i][1]);
+      f[i][2] = fkspace[i][2] + kspace_every * (f[i][2] - fkspace[i][2]);
+    }
+  }
 }
 
 /* ----------------------------------------------------------------------
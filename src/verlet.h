@@ -27,6 +27,7 @@ namespace LAMMPS_NS {
 class Verlet : public Integrate {
  public:
   Verlet(class LAMMPS *, int, char **);
+  ~Verlet() override;
   void init() override;
   void setup(int flag) override;
   void setup_minimal(int) override;
@@ -37,6 +38,24 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+
+  // multiple time stepping of kspace via kspace_modify every
+
+  int kspace_every;          // invoke kspace every this many steps
+  int kspace_extrapolate;    // 1 if extrapolate kspace forces, 0 if impulse
+  bigint kspace_next;        // next timestep to invoke kspace on
+  bigint kspace_last;        // last timestep kspace was invoked on
+  int kspace_nhistory;       // # of stored kspace force evaluations
+  bigint nkspace_skip;       // # of steps kspace was not invoked on in current run
+  int kspace_eflag;          // 1 if total energy at start of run is known
+  double kspace_estart;      // total energy at start of run, for drift diagnostic
+  int nmax_fkspace;
+  double **fkspace;                  // copy of forces before kspace compute
+  class FixStoreAtom *fix_kspace;    // kspace forces of last two invocations
+
+  void kspace_mts_start();
+  void kspace_compute_mts(bigint, int);
+  int kspace_mts_energy(double &);
 };
 
 }    // namespace LAMMPS_NS
@@ -26,6 +26,7 @@
 #include "force.h"
 #include "improper.h"
 #include "label_map.h"
+#include "lmpbinarydata.h"
 #include "memory.h"
 #include "modify.h"
 #include "output.h"
@@ -34,11 +35,13 @@
 #include "update.h"
 
 #include <cstring>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
 enum{II,IJ};
 enum{ELLIPSOID,LINE,TRIANGLE,BODY};   // also in AtomVecHybrid
+enum{BONDS,ANGLES,DIHEDRALS,IMPROPERS};
 
 /* ---------------------------------------------------------------------- */
 
@@ -73,6 +76,7 @@ void WriteData::command(int narg, char **arg)
   coeffflag = 1;
   fixflag = 1;
   lmapflag = 1;
+  binaryflag = 0;
   // store current (default) setting since we may change it.
   int types_style = atom->types_style;
   int noinit = 0;
@@ -97,6 +101,9 @@ void WriteData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg],"nolabelmap") == 0) {
       lmapflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg],"binary") == 0) {
+      binaryflag = 1;
+      iarg++;
     } else if (strcmp(arg[iarg],"types") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "write_data types", error);
       if (strcmp(arg[iarg+1],"numeric") == 0) atom->types_style = Atom::NUMERIC;
@@ -186,6 +193,11 @@ void WriteData::write(const std::string &file)
     MPI_Allreduce(&nimpropers_local,&nimpropers,1,MPI_LMP_BIGINT,MPI_SUM,world);
   }
 
+  if (binaryflag) {
+    write_binary(file,natoms);
+    return;
+  }
+
   // open data file
 
   if (me == 0) {
@@ -786,3 +798,264 @@ void WriteData::fix(Fix *ifix, int mth)
 
   memory->destroy(buf);
 }
+
+/* ----------------------------------------------------------------------
+   write binary data file, see lmpbinarydata.h for the layout
+   proc 0 writes header, column index and all small columns
+   per-atom and topology columns are gathered from all procs
+------------------------------------------------------------------------- */
+
+void WriteData::write_binary(const std::string &file, bigint natoms)
+{
+  using namespace BinaryData;
+
+  if (atom->ellipsoid_flag || atom->line_flag || atom->tri_flag || atom->body_flag)
+    error->all(FLERR,"Write_data binary does not support atom styles with bonus data");
+  if (me == 0) {
+    if (fixflag)
+      for (auto &ifix : modify->get_fix_list())
+        if (ifix->wd_header || ifix->wd_section)
+          error->warning(FLERR,"Write_data binary does not store data file info of fix {}",
+                         ifix->id);
+    if (coeffflag && force->pair && force->pair->writedata)
+      error->warning(FLERR,"Write_data binary does not store force field coefficients");
+  }
+
+  // build column index
+  // small columns are stored in smalldata, large columns are written later
+
+  std::vector<Column> columns;
+  std::vector<std::string> smalldata;
+
+  auto add = [&](const std::string &name, int type, bigint count, const void *data) {
+    Column col;
+    memset(&col,0,sizeof(Column));
+    strncpy(col.name,name.c_str(),NAMELEN-1);
+    col.type = type;
+    col.width = (type == CHAR) ? 1 : 8;
+    col.count = count;
+    columns.push_back(col);
+    if (data) smalldata.emplace_back((const char *) data,count*col.width);
+    else smalldata.emplace_back();
+  };
+  auto add_string = [&](const std::string &name, const std::string &value) {
+    add(name,CHAR,value.size(),value.c_str());
+  };
+  auto add_int = [&](const std::string &name, bigint value) {
+    int64_t ivalue = value;
+    add(name,INT64,1,&ivalue);
+  };
+
+  add_string("header/version",lmp->version);
+  add_string("header/units",update->unit_style);
+  add_string("header/atom_style",atom->atom_style);
+  add_int("header/ntimestep",update->ntimestep);
+  add_int("header/natoms",natoms);
+  add_int("header/ntypes",atom->ntypes);
+  add_int("header/nbondtypes",atom->nbondtypes);
+  add_int("header/nangletypes",atom->nangletypes);
+  add_int("header/ndihedraltypes",atom->ndihedraltypes);
+  add_int("header/nimpropertypes",atom->nimpropertypes);
+
+  int molecular = (atom->molecular == Atom::MOLECULAR);
+  bigint nb = (molecular && atom->nbonds) ? nbonds : 0;
+  bigint na = (molecular && atom->nangles) ? nangles : 0;
+  bigint nd = (molecular && atom->ndihedrals) ? ndihedrals : 0;
+  bigint ni = (molecular && atom->nimpropers) ? nimpropers : 0;
+  add_int("header/nbonds",nb);
+  add_int("header/nangles",na);
+  add_int("header/ndihedrals",nd);
+  add_int("header/nimpropers",ni);
+
+  add("header/boxlo",FLOAT64,3,domain->boxlo);
+  add("header/boxhi",FLOAT64,3,domain->boxhi);
+  if (domain->triclinic) {
+    double tilt[3] = {domain->xy,domain->xz,domain->yz};
+    add("header/tilt",FLOAT64,3,tilt);
+  }
+
+  if (atom->mass) add("masses/mass",FLOAT64,atom->ntypes,&atom->mass[1]);
+
+  std::vector<std::string> atomnames,velnames;
+  std::vector<int> atomint,velint;
+  atom->avec->data_columns(atomnames,atomint,velnames,velint);
+
+  int firstatom = columns.size();
+  for (std::size_t i = 0; i < atomnames.size(); i++)
+    add("atoms/" + atomnames[i],atomint[i] ? INT64 : FLOAT64,natoms,nullptr);
+  for (std::size_t i = 1; i < velnames.size(); i++)
+    add("velocities/" + velnames[i],velint[i] ? INT64 : FLOAT64,natoms,nullptr);
+
+  const char *topo[4] = {"bonds","angles","dihedrals","impropers"};
+  const int ntopoatom[4] = {2,3,4,4};
+  bigint ntopo[4] = {nb,na,nd,ni};
+  int firsttopo[4];
+  for (int k = 0; k < 4; k++) {
+    firsttopo[k] = columns.size();
+    if (ntopo[k] == 0) continue;
+    add(fmt::format("{}/type",topo[k]),INT64,ntopo[k],nullptr);
+    for (int m = 1; m <= ntopoatom[k]; m++)
+      add(fmt::format("{}/atom{}",topo[k],m),INT64,ntopo[k],nullptr);
+  }
+
+  // assign file offsets, 8-byte aligned
+
+  Header header;
+  memset(&header,0,sizeof(Header));
+  memcpy(header.magic,MAGIC,sizeof(header.magic));
+  header.endian = ENDIAN;
+  header.version = VERSION;
+  header.ncolumns = columns.size();
+  header.index = sizeof(Header);
+
+  int64_t offset = header.index + columns.size()*sizeof(Column);
+  binoffset.clear();
+  for (auto &col : columns) {
+    offset = (offset + 7) & ~((int64_t) 7);
+    col.offset = offset;
+    binoffset.push_back(offset);
+    offset += col.count*col.width;
+  }
+
+  // proc 0 writes header, index, and small columns
+
+  if (me == 0) {
+    fp = fopen(file.c_str(),"wb");
+    if (fp == nullptr)
+      error->one(FLERR,"Cannot open data file {}: {}",file,utils::getsyserror());
+    if ((fwrite(&header,sizeof(Header),1,fp) != 1) ||
+        (fwrite(columns.data(),sizeof(Column),columns.size(),fp) != columns.size()))
+      error->one(FLERR,"Error writing binary data file {}: {}",file,utils::getsyserror());
+    for (std::size_t i = 0; i < columns.size(); i++) {
+      if (smalldata[i].empty()) continue;
+      platform::fseek(fp,columns[i].offset);
+      if (fwrite(smalldata[i].data(),1,smalldata[i].size(),fp) != smalldata[i].size())
+        error->one(FLERR,"Error writing binary data file {}: {}",file,utils::getsyserror());
+    }
+  } else fp = nullptr;
+
+  // large columns
+
+  if (natoms) binary_atoms(firstatom,atomnames.size(),velnames.size()-1);
+  for (int k = 0; k < 4; k++)
+    if (ntopo[k]) binary_topology(k,firsttopo[k],ntopoatom[k]+1);
+
+  if ((me == 0) && (fclose(fp) != 0))
+    error->one(FLERR,"Error writing binary data file {}: {}",file,utils::getsyserror());
+}
+
+/* ----------------------------------------------------------------------
+   write per-atom columns of binary data file
+   each proc packs its atoms column by column, proc 0 writes them
+     to the slice of each column that follows the previous proc
+------------------------------------------------------------------------- */
+
+void WriteData::binary_atoms(int firstcol, int natomcol, int nvelcol)
+{
+  int nlocal = atom->nlocal;
+  int ncol = natomcol + nvelcol;
+  int maxrow;
+  MPI_Allreduce(&nlocal,&maxrow,1,MPI_INT,MPI_MAX,world);
+
+  double **abuf,**vbuf;
+  memory->create(abuf,MAX(1,nlocal),natomcol,"write_data:abuf");
+  memory->create(vbuf,MAX(1,nlocal),nvelcol+1,"write_data:vbuf");
+  atom->avec->pack_data(abuf);
+  atom->avec->pack_vel(vbuf);
+
+  // transpose to column-major, skip atom ID in velocity values
+
+  std::vector<double> buf((bigint) ncol*MAX(maxrow,1));
+  for (int i = 0; i < nlocal; i++) {
+    for (int c = 0; c < natomcol; c++) buf[(bigint) c*nlocal+i] = abuf[i][c];
+    for (int c = 0; c < nvelcol; c++) buf[(bigint) (natomcol+c)*nlocal+i] = vbuf[i][c+1];
+  }
+  memory->destroy(abuf);
+  memory->destroy(vbuf);
+
+  int tmp,recvrow;
+  if (me == 0) {
+    MPI_Status status;
+    MPI_Request request;
+
+    bigint first = 0;
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      if (iproc) {
+        MPI_Irecv(buf.data(),maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
+        MPI_Send(&tmp,0,MPI_INT,iproc,0,world);
+        MPI_Wait(&request,&status);
+        MPI_Get_count(&status,MPI_DOUBLE,&recvrow);
+        recvrow /= ncol;
+      } else recvrow = nlocal;
+
+      for (int c = 0; c < ncol; c++) {
+        platform::fseek(fp,binoffset[firstcol+c] + first*sizeof(double));
+        if (fwrite(&buf[(bigint) c*recvrow],sizeof(double),recvrow,fp) != (std::size_t) recvrow)
+          error->one(FLERR,"Error writing binary data file: {}",utils::getsyserror());
+      }
+      first += recvrow;
+    }
+
+  } else {
+    MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+    MPI_Rsend(buf.data(),nlocal*ncol,MPI_DOUBLE,0,0,world);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write bond, angle, dihedral, or improper columns of binary data file
+   ncol = type + atom IDs
+------------------------------------------------------------------------- */
+
+void WriteData::binary_topology(int which, int firstcol, int ncol)
+{
+  bigint nmine = 0;
+  if (which == BONDS) nmine = nbonds_local;
+  else if (which == ANGLES) nmine = nangles_local;
+  else if (which == DIHEDRALS) nmine = ndihedrals_local;
+  else if (which == IMPROPERS) nmine = nimpropers_local;
+
+  int sendrow = static_cast<int> (nmine);
+  int maxrow;
+  MPI_Allreduce(&sendrow,&maxrow,1,MPI_INT,MPI_MAX,world);
+
+  tagint **tbuf;
+  memory->create(tbuf,MAX(1,sendrow),ncol,"write_data:tbuf");
+  if (which == BONDS) atom->avec->pack_bond(tbuf);
+  else if (which == ANGLES) atom->avec->pack_angle(tbuf);
+  else if (which == DIHEDRALS) atom->avec->pack_dihedral(tbuf);
+  else if (which == IMPROPERS) atom->avec->pack_improper(tbuf);
+
+  std::vector<int64_t> buf((bigint) ncol*MAX(maxrow,1));
+  for (int i = 0; i < sendrow; i++)
+    for (int c = 0; c < ncol; c++) buf[(bigint) c*sendrow+i] = tbuf[i][c];
+  memory->destroy(tbuf);
+
+  int tmp,recvrow;
+  if (me == 0) {
+    MPI_Status status;
+    MPI_Request request;
+
+    bigint first = 0;
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      if (iproc) {
+        MPI_Irecv(buf.data(),maxrow*ncol,MPI_LMP_BIGINT,iproc,0,world,&request);
+        MPI_Send(&tmp,0,MPI_INT,iproc,0,world);
+        MPI_Wait(&request,&status);
+        MPI_Get_count(&status,MPI_LMP_BIGINT,&recvrow);
+        recvrow /= ncol;
+      } else recvrow = sendrow;
+
+      for (int c = 0; c < ncol; c++) {
+        platform::fseek(fp,binoffset[firstcol+c] + first*sizeof(int64_t));
+        if (fwrite(&buf[(bigint) c*recvrow],sizeof(int64_t),recvrow,fp) != (std::size_t) recvrow)
+          error->one(FLERR,"Error writing binary data file: {}",utils::getsyserror());
+      }
+      first += recvrow;
+    }
+
+  } else {
+    MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+    MPI_Rsend(buf.data(),sendrow*ncol,MPI_LMP_BIGINT,0,0,world);
+  }
+}
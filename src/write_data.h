@@ -22,6 +22,8 @@ CommandStyle(write_data,WriteData);
 
 #include "command.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class WriteData : public Command {
@@ -36,6 +38,7 @@ class WriteData : public Command {
   int coeffflag;
   int fixflag;
   int lmapflag;
+  int binaryflag;
   FILE *fp;
   bigint nbonds_local, nbonds;
   bigint nangles_local, nangles;
@@ -53,6 +56,12 @@ class WriteData : public Command {
   void impropers();
   void bonus(int);
   void fix(class Fix *, int);
+
+  std::vector<bigint> binoffset;    // file offsets of binary data file columns
+
+  void write_binary(const std::string &, bigint);
+  void binary_atoms(int, int, int);
+  void binary_topology(int, int, int);
 };
 
 }    // namespace LAMMPS_NS
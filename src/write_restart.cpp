@@ -51,6 +51,10 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   multiproc = 0;
   noinit = 0;
   fp = nullptr;
+
+  deltaflag = 0;
+  delta_every = delta_keep = ndelta = 0;
+  delta_natoms = delta_topo = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -84,6 +88,8 @@ void WriteRestart::command(int narg, char **arg)
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,mpiioflag,narg-1,&arg[1]);
+  if (deltaflag)
+    error->all(FLERR,"Write_restart keywords delta and keep are only supported by restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -195,8 +201,30 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
+
+    } else if (strcmp(arg[iarg],"delta") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "restart delta", error);
+      delta_every = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (delta_every < 0) error->all(FLERR,"Invalid restart delta value {}", delta_every);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"keep") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "restart keep", error);
+      delta_keep = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (delta_keep < 0) error->all(FLERR,"Invalid restart keep value {}", delta_keep);
+      iarg += 2;
     } else error->all(FLERR,"Unknown write_restart keyword: {}", arg[iarg]);
   }
+
+  // delta files and retention require one file per restart with native output
+
+  if (delta_every || delta_keep) {
+    if (multiproc) error->all(FLERR,"Restart delta and keep are not allowed with % in filename");
+    if (mpiioflag) error->all(FLERR,"Restart delta and keep are not allowed with MPI-IO output");
+    if (delta_every && lmp->kokkos)
+      error->all(FLERR,"Restart delta is not yet supported with KOKKOS");
+  }
+  deltaflag = (delta_every || delta_keep) ? 1 : 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -224,6 +252,10 @@ void WriteRestart::write(const std::string &file)
     error->all(FLERR,"Atom count is inconsistent: {} vs {}, cannot write restart file",
                natoms, atom->natoms);
 
+  // write delta file if possible, else full file
+
+  int delta = use_delta();
+
   // open single restart file or base file for multiproc case
 
   if (me == 0) {
@@ -245,8 +277,13 @@ void WriteRestart::write(const std::string &file)
 
   // proc 0 writes header, groups, pertype info, force field info
 
+  // a delta file starts with the name of its full file, which is in the same directory
+
   if (me == 0) {
-    header();
+    if (delta) {
+      write_string(DELTA_BASE,platform::path_basename(delta_base));
+      delta_header();
+    } else header();
     group->write_restart(fp);
     type_arrays();
     force_fields();
@@ -263,7 +300,9 @@ void WriteRestart::write(const std::string &file)
   //   but nlocal * doubles-peratom could overflow
 
   int max_size;
-  int send_size = atom->avec->size_restart();
+  int send_size;
+  if (delta) send_size = atom->avec->size_restart_delta();
+  else send_size = atom->avec->size_restart();
   MPI_Allreduce(&send_size,&max_size,1,MPI_INT,MPI_MAX,world);
 
   double *buf;
@@ -303,56 +342,17 @@ void WriteRestart::write(const std::string &file)
 
   AtomVec *avec = atom->avec;
   int n = 0;
-  for (int i = 0; i < atom->nlocal; i++) n += avec->pack_restart(i,&buf[n]);
+  if (delta) {
+    for (int i = 0; i < atom->nlocal; i++) n += avec->pack_restart_delta(i,&buf[n]);
+  } else {
+    for (int i = 0; i < atom->nlocal; i++) n += avec->pack_restart(i,&buf[n]);
+  }
 
   // if any fix requires it, remap each atom's coords via PBC
   // is because fix changes atom coords (excepting an integrate fix)
   // just remap in buffer, not actual atoms
 
-  if (modify->restart_pbc_any) {
-    int triclinic = domain->triclinic;
-    double *lo,*hi,*period;
-
-    if (triclinic == 0) {
-      lo = domain->boxlo;
-      hi = domain->boxhi;
-      period = domain->prd;
-    } else {
-      lo = domain->boxlo_lamda;
-      hi = domain->boxhi_lamda;
-      period = domain->prd_lamda;
-    }
-
-    int xperiodic = domain->xperiodic;
-    int yperiodic = domain->yperiodic;
-    int zperiodic = domain->zperiodic;
-
-    double *x;
-    int m = 0;
-    for (int i = 0; i < atom->nlocal; i++) {
-      x = &buf[m+1];
-      if (triclinic) domain->x2lamda(x,x);
-
-      if (xperiodic) {
-        if (x[0] < lo[0]) x[0] += period[0];
-        if (x[0] >= hi[0]) x[0] -= period[0];
-        x[0] = MAX(x[0],lo[0]);
-      }
-      if (yperiodic) {
-        if (x[1] < lo[1]) x[1] += period[1];
-        if (x[1] >= hi[1]) x[1] -= period[1];
-        x[1] = MAX(x[1],lo[1]);
-      }
-      if (zperiodic) {
-        if (x[2] < lo[2]) x[2] += period[2];
-        if (x[2] >= hi[2]) x[2] -= period[2];
-        x[2] = MAX(x[2],lo[2]);
-      }
-
-      if (triclinic) domain->lamda2x(x,x);
-      m += static_cast<int> (buf[m]);
-    }
-  }
+  if (modify->restart_pbc_any) remap_pbc(buf);
 
   // MPI-IO output to single file
 
@@ -409,6 +409,10 @@ void WriteRestart::write(const std::string &file)
 
   memory->destroy(buf);
 
+  // track full file for next delta files and delete files no longer kept
+
+  retain(file,delta);
+
   // invoke any fixes that write their own restart file
 
   for (auto &fix : modify->get_fix_list())
@@ -416,6 +420,159 @@ void WriteRestart::write(const std::string &file)
       fix->write_restart_file(file.c_str());
 }
 
+/* ----------------------------------------------------------------------
+   write base file of a multiproc restart with nfile per-proc files to fpout
+   called by all procs, only proc 0 writes, fpout is ignored on other procs
+   used by fix buddy to keep the base file in memory
+------------------------------------------------------------------------- */
+
+void WriteRestart::write_base(FILE *fpout, int nfile)
+{
+  bigint nblocal = atom->nlocal;
+  MPI_Allreduce(&nblocal,&natoms,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  multiproc = nfile;
+  mpiioflag = 0;
+  fp = (me == 0) ? fpout : nullptr;
+
+  if (me == 0) {
+    magic_string();
+    endian();
+    version_numeric();
+    header();
+    group->write_restart(fp);
+    type_arrays();
+    force_fields();
+  }
+
+  modify->write_restart(fp);
+  file_layout(0);
+
+  if (me == 0) magic_string();
+  fp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   write per-proc file of a multiproc restart with n values of one proc
+   buf was packed with AtomVec::pack_restart()
+   only uses the file, so may be called from a thread other than the main one
+------------------------------------------------------------------------- */
+
+void WriteRestart::write_perproc(FILE *fpout, int n, double *buf)
+{
+  fp = fpout;
+  write_int(PROCSPERFILE,1);
+  write_double_vec(PERPROC,n,buf);
+  magic_string();
+  fp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if next file can be a delta of the last full file
+   requires same atoms with same topology as in the full file
+------------------------------------------------------------------------- */
+
+int WriteRestart::use_delta()
+{
+  if (!delta_every) return 0;
+  if (!atom->avec->restart_delta_flag)
+    error->all(FLERR,"Restart delta is not supported by atom style {}", atom->atom_style);
+
+  bigint topo_local = atom->avec->topology_checksum();
+  bigint topo;
+  MPI_Allreduce(&topo_local,&topo,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  int delta = 1;
+  if (delta_base.empty() || (ndelta >= delta_every)) delta = 0;
+  if ((natoms != delta_natoms) || (topo != delta_topo)) delta = 0;
+
+  if (!delta) {
+    delta_natoms = natoms;
+    delta_topo = topo;
+  }
+  return delta;
+}
+
+/* ----------------------------------------------------------------------
+   update list of full files and their latest delta file after a write
+   with keep setting, proc 0 deletes superseded delta and old full files
+------------------------------------------------------------------------- */
+
+void WriteRestart::retain(const std::string &file, int delta)
+{
+  if (delta) {
+    ndelta++;
+    auto &last = kept.back();
+    if (delta_keep && (me == 0) && !last.second.empty() && (last.second != file))
+      platform::unlink(last.second);
+    last.second = file;
+  } else {
+    ndelta = 0;
+    delta_base = file;
+    if (!kept.empty() && (kept.back().first == file)) kept.pop_back();
+    kept.emplace_back(file,"");
+  }
+
+  while (delta_keep && ((int) kept.size() > delta_keep)) {
+    if (me == 0) {
+      platform::unlink(kept.front().first);
+      if (!kept.front().second.empty()) platform::unlink(kept.front().second);
+    }
+    kept.erase(kept.begin());
+  }
+  if (!delta_keep && (kept.size() > 1)) kept.erase(kept.begin(),kept.end()-1);
+}
+
+/* ----------------------------------------------------------------------
+   remap coords of nlocal atoms packed into buf back into periodic box
+------------------------------------------------------------------------- */
+
+void WriteRestart::remap_pbc(double *buf)
+{
+  int triclinic = domain->triclinic;
+  double *lo,*hi,*period;
+
+  if (triclinic == 0) {
+    lo = domain->boxlo;
+    hi = domain->boxhi;
+    period = domain->prd;
+  } else {
+    lo = domain->boxlo_lamda;
+    hi = domain->boxhi_lamda;
+    period = domain->prd_lamda;
+  }
+
+  int xperiodic = domain->xperiodic;
+  int yperiodic = domain->yperiodic;
+  int zperiodic = domain->zperiodic;
+
+  double *x;
+  int m = 0;
+  for (int i = 0; i < atom->nlocal; i++) {
+    x = &buf[m+1];
+    if (triclinic) domain->x2lamda(x,x);
+
+    if (xperiodic) {
+      if (x[0] < lo[0]) x[0] += period[0];
+      if (x[0] >= hi[0]) x[0] -= period[0];
+      x[0] = MAX(x[0],lo[0]);
+    }
+    if (yperiodic) {
+      if (x[1] < lo[1]) x[1] += period[1];
+      if (x[1] >= hi[1]) x[1] -= period[1];
+      x[1] = MAX(x[1],lo[1]);
+    }
+    if (zperiodic) {
+      if (x[2] < lo[2]) x[2] += period[2];
+      if (x[2] >= hi[2]) x[2] -= period[2];
+      x[2] = MAX(x[2],lo[2]);
+    }
+
+    if (triclinic) domain->lamda2x(x,x);
+    m += static_cast<int> (buf[m]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes out problem description
 ------------------------------------------------------------------------- */
@@ -516,6 +673,40 @@ void WriteRestart::header()
   fwrite(&flag,sizeof(int),1,fp);
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 writes out the part of the header which can change between
+   a full restart file and its delta files
+------------------------------------------------------------------------- */
+
+void WriteRestart::delta_header()
+{
+  write_bigint(NTIMESTEP,update->ntimestep);
+  write_int(NPROCS,nprocs);
+
+  double minbound[6];
+  minbound[0] = domain->minxlo; minbound[1] = domain->minxhi;
+  minbound[2] = domain->minylo; minbound[3] = domain->minyhi;
+  minbound[4] = domain->minzlo; minbound[5] = domain->minzhi;
+  write_double_vec(BOUNDMIN,6,minbound);
+
+  write_bigint(NATOMS,natoms);
+  write_int(TRICLINIC,domain->triclinic);
+  write_double_vec(BOXLO,3,domain->boxlo);
+  write_double_vec(BOXHI,3,domain->boxhi);
+  write_double(XY,domain->xy);
+  write_double(XZ,domain->xz);
+  write_double(YZ,domain->yz);
+
+  write_double(TIMESTEP,update->dt);
+  write_bigint(ATIMESTEP,update->atimestep);
+  write_double(ATIME,update->atime);
+
+  // -1 flag signals end of header
+
+  int flag = -1;
+  fwrite(&flag,sizeof(int),1,fp);
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes out any type-based arrays that are defined
 ------------------------------------------------------------------------- */
@@ -30,6 +30,11 @@ class WriteRestart : public Command {
   void command(int, char **) override;
   void multiproc_options(int, int, int, char **);
   void write(const std::string &);
+  void write_base(FILE *, int);
+  void write_perproc(FILE *, int, double *);
+  void remap_pbc(double *);
+
+  int deltaflag;    // 1 if delta files or retention of files are used
 
  private:
   int me, nprocs;
@@ -50,7 +55,21 @@ class WriteRestart : public Command {
   class RestartMPIIO *mpiio;    // MPIIO for restart file output
   MPI_Offset headerOffset;
 
+  // delta restart files and retention of restart files
+
+  int delta_every;        // # of delta files after each full file
+  int delta_keep;         // # of full files to keep with their latest delta, 0 = all
+  int ndelta;             // # of delta files written since last full file
+  bigint delta_natoms;    // atom count of last full file
+  bigint delta_topo;      // topology checksum of last full file
+  std::string delta_base;                                   // name of last full file
+  std::vector<std::pair<std::string, std::string>> kept;    // full files and their latest delta
+
+  int use_delta();
+  void retain(const std::string &, int);
+
   void header();
+  void delta_header();
   void type_arrays();
   void force_fields();
   void file_layout(int);
@@ -0,0 +1,145 @@
+#!/usr/bin/env python
+
+# Script:  zbin.py
+# Purpose: random access to frames of a dump custom/zbin file
+# Syntax:  zbin.py file [N ...]
+#          file = zbin file written by dump custom/zbin or custom/zbin/mpiio
+#          N = timesteps to print as text dump, default = list all timesteps
+# Module:  from zbin import zbin
+#          z = zbin("dump.zbin")
+#          z.timesteps()           list of timesteps of all frames
+#          f = z.frame(N)          dict for frame with timestep N, with the
+#                                  keys "timestep", "natoms", "box",
+#                                  "boundary", "triclinic", "time" and one
+#                                  numpy array per column, e.g. f["x"]
+#          f = z.frame(N,["x"])    decompress only the listed columns
+# Requires numpy and the zstandard module (or compression.zstd of
+#   Python 3.14 and later)
+# Frames are located via the frame index at the end of the file, files
+#   without index (e.g. of a crashed run) are scanned frame by frame
+
+import struct, sys
+import numpy as np
+
+try:
+  from compression import zstd
+  def decompress(data,nbytes): return zstd.decompress(data)
+except ImportError:
+  import zstandard
+  def decompress(data,nbytes):
+    return zstandard.ZstdDecompressor().decompress(data,max_output_size=nbytes)
+
+# layout of the structs in src/COMPRESS/zbin_format.h
+
+FILEHEADER = struct.Struct("<8siiii16s")
+COLUMNINFO = struct.Struct("<32s")
+FRAMEHEADER = struct.Struct("<8sqqqqiid9d6i")
+CHUNKHEADER = struct.Struct("<qq")
+BLOCKHEADER = struct.Struct("<iidq")
+INDEXENTRY = struct.Struct("<qq")
+INDEXFOOTER = struct.Struct("<qq8s")
+
+DOUBLE,QUANTIZED,INTEGER = 1,2,3
+
+class zbin:
+  def __init__(self,file):
+    self.fp = open(file,"rb")
+    header = FILEHEADER.unpack(self.fp.read(FILEHEADER.size))
+    if header[0] != b"LMPZBIN1": raise Exception("%s is not a zbin dump file" % file)
+    if header[1] != 1:
+      raise Exception("zbin dump file %s was written with different byte order" % file)
+    self.units = header[5].split(b"\0")[0].decode()
+    self.columns = []
+    for i in range(header[3]):
+      name = COLUMNINFO.unpack(self.fp.read(COLUMNINFO.size))[0]
+      self.columns.append(name.split(b"\0")[0].decode())
+    data_start = self.fp.tell()
+
+    # frame index at end of file, or scan frames of a file without index
+
+    self.fp.seek(0,2)
+    end = self.fp.tell()
+    self.index = []
+    if end - data_start >= INDEXFOOTER.size:
+      self.fp.seek(end - INDEXFOOTER.size)
+      nframes,offset,magic = INDEXFOOTER.unpack(self.fp.read(INDEXFOOTER.size))
+      if magic == b"ZBINDEX1":
+        self.fp.seek(offset)
+        data = self.fp.read(nframes*INDEXENTRY.size)
+        self.index = [INDEXENTRY.unpack_from(data,i*INDEXENTRY.size) for i in range(nframes)]
+        return
+
+    offset = data_start
+    while offset + FRAMEHEADER.size <= end:
+      self.fp.seek(offset)
+      frame = FRAMEHEADER.unpack(self.fp.read(FRAMEHEADER.size))
+      if frame[0] != b"ZBFRAME1" or frame[3] < FRAMEHEADER.size or offset + frame[3] > end: break
+      self.index.append((frame[1],offset))
+      offset += frame[3]
+
+  def timesteps(self):
+    return [ntimestep for ntimestep,offset in self.index]
+
+  # read frame with timestep N, decompress the requested columns only
+
+  def frame(self,n,columns=None):
+    offsets = [offset for ntimestep,offset in self.index if ntimestep == n]
+    if not offsets: raise Exception("zbin dump file has no frame with timestep %d" % n)
+    if columns is None: columns = self.columns
+    needed = [name in columns for name in self.columns]
+
+    self.fp.seek(offsets[0])
+    frame = FRAMEHEADER.unpack(self.fp.read(FRAMEHEADER.size))
+    natoms,nchunks = frame[2],frame[4]
+    result = {"timestep": frame[1], "natoms": natoms, "triclinic": frame[5],
+              "time": frame[7] if frame[6] else None,
+              "box": np.array(frame[8:17]).reshape(3,3),
+              "boundary": "".join("pfsm"[flag] for flag in frame[17:23])}
+    values = [np.empty(natoms) if needed[i] else None for i in range(len(self.columns))]
+
+    row = 0
+    for ichunk in range(nchunks):
+      n,nbytes = CHUNKHEADER.unpack(self.fp.read(CHUNKHEADER.size))
+      for icol in range(len(self.columns)):
+        encoding,unused,precision,nbytes = BLOCKHEADER.unpack(self.fp.read(BLOCKHEADER.size))
+        if not needed[icol]:
+          self.fp.seek(nbytes,1)
+          continue
+        shuffled = np.frombuffer(decompress(self.fp.read(nbytes),8*n),dtype=np.uint8)
+        raw = shuffled.reshape(8,n).T.copy()
+        if encoding == DOUBLE: column = raw.view("<f8").ravel()
+        elif encoding == QUANTIZED: column = np.cumsum(raw.view("<i8").ravel())*precision
+        elif encoding == INTEGER: column = np.cumsum(raw.view("<i8").ravel())
+        else: raise Exception("unknown zbin block encoding %d" % encoding)
+        values[icol][row:row+n] = column
+      row += n
+
+    for icol,name in enumerate(self.columns):
+      if needed[icol]: result[name] = values[icol]
+    return result
+
+# print frames as text dump, or list timesteps
+
+if __name__ == "__main__":
+  if len(sys.argv) < 2:
+    raise Exception("Syntax: zbin.py file [N ...]")
+  z = zbin(sys.argv[1])
+  if len(sys.argv) == 2:
+    for n in z.timesteps(): print(n)
+    sys.exit()
+
+  for n in [int(arg) for arg in sys.argv[2:]]:
+    f = z.frame(n)
+    print("ITEM: TIMESTEP\n%d" % n)
+    print("ITEM: NUMBER OF ATOMS\n%d" % f["natoms"])
+    box,bound = f["box"],f["boundary"]
+    bounds = " ".join(bound[2*i:2*i+2] for i in range(3))
+    if f["triclinic"]:
+      print("ITEM: BOX BOUNDS xy xz yz " + bounds)
+      for i in range(3): print("%-1.16e %-1.16e %-1.16e" % tuple(box[i]))
+    else:
+      print("ITEM: BOX BOUNDS " + bounds)
+      for i in range(3): print("%-1.16e %-1.16e" % tuple(box[i][0:2]))
+    print("ITEM: ATOMS " + " ".join(z.columns))
+    for i in range(f["natoms"]):
+      print(" ".join("%g" % f[name][i] for name in z.columns))
@@ -0,0 +1,179 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// header-only consumer for the shared memory segment written by dump shm
+// see shm_format.h in src/EXTRA-DUMP for the layout and the protocol
+
+#ifndef LAMMPS_SHM_CONSUMER_H
+#define LAMMPS_SHM_CONSUMER_H
+
+#include "shm_format.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LAMMPS_NS {
+namespace Shm {
+
+  // view of one frame, pointing into the segment (no copy)
+  // columns are only safe to use as long as Consumer::valid() returns true
+
+  struct Frame {
+    int64_t index;                        // frame index in segment
+    int64_t sequence;                     // slot sequence number when frame was taken
+    int64_t ntimestep;
+    int64_t natoms;
+    int64_t wtime;                        // publishing time in ns since epoch
+    int triclinic;
+    double time;
+    double box[3][3];
+    std::vector<const double *> columns;  // one pointer to natoms values per column
+    const SlotHeader *slot;
+  };
+
+  class Consumer {
+   public:
+    explicit Consumer(const std::string &segname) : segment(nullptr), nbytes(0)
+    {
+      name = segname;
+      if (name.empty() || name[0] != '/') name = "/" + name;
+    }
+    ~Consumer() { detach(); }
+
+    // map segment read-only, return false if it does not exist (yet)
+    // a CLOSED segment (kept with dump_modify unlink no) can still be read
+
+    bool attach()
+    {
+      detach();
+      int fd = shm_open(name.c_str(), O_RDONLY, 0);
+      if (fd < 0) return false;
+      struct stat st;
+      if ((fstat(fd, &st) != 0) || (st.st_size < (off_t) sizeof(SegmentHeader))) {
+        close(fd);
+        return false;
+      }
+      nbytes = st.st_size;
+      void *ptr = mmap(nullptr, nbytes, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (ptr == MAP_FAILED) return false;
+      segment = ptr;
+
+      if ((memcmp(header()->magic, MAGIC, sizeof(MAGIC)) != 0) ||
+          (header()->version != VERSION) || (state() == 0)) {
+        detach();
+        return false;
+      }
+
+      names.clear();
+      auto info = (const ColumnInfo *) ((const char *) segment + sizeof(SegmentHeader));
+      for (int i = 0; i < header()->ncolumns; i++)
+        names.emplace_back(info[i].name, strnlen(info[i].name, NAMELEN));
+      return true;
+    }
+
+    void detach()
+    {
+      if (segment) munmap(segment, nbytes);
+      segment = nullptr;
+      nbytes = 0;
+    }
+
+    bool attached() const { return segment != nullptr; }
+
+    // ACTIVE while written, CLOSED or RESIZED when consumer must re-attach
+
+    int state() const { return header()->state.load(std::memory_order_acquire); }
+
+    int64_t nframes() const { return header()->nframes.load(std::memory_order_acquire); }
+
+    const std::vector<std::string> &column_names() const { return names; }
+
+    int column(const std::string &label) const
+    {
+      for (size_t i = 0; i < names.size(); i++)
+        if (names[i] == label) return i;
+      return -1;
+    }
+
+    // zero-copy view of frame i, return false if frame is not available
+
+    bool get(int64_t i, Frame &frame) const
+    {
+      if ((i < 0) || (i >= nframes())) return false;
+      auto hdr = header();
+      int islot = i % hdr->nslots;
+      auto slot = (const SlotHeader *) ((const char *) segment + hdr->slot_offset +
+                                        islot * hdr->slot_bytes);
+      int64_t seq = slot->sequence.load(std::memory_order_acquire);
+      if (seq != 2 * i + 2) return false;
+
+      frame.index = i;
+      frame.sequence = seq;
+      frame.slot = slot;
+      frame.ntimestep = slot->ntimestep;
+      frame.natoms = slot->natoms;
+      frame.wtime = slot->wtime;
+      frame.triclinic = slot->triclinic;
+      frame.time = slot->time;
+      memcpy(frame.box, slot->box, sizeof(frame.box));
+      frame.columns.resize(hdr->ncolumns);
+      auto data = (const double *) ((const char *) slot + hdr->data_offset);
+      for (int k = 0; k < hdr->ncolumns; k++) frame.columns[k] = data + k * hdr->capacity;
+
+      // header fields are only trustworthy if the slot was not reused meanwhile
+
+      return valid(frame) && (frame.natoms >= 0) && (frame.natoms <= hdr->capacity);
+    }
+
+    // newest complete frame
+
+    bool latest(Frame &frame) const { return get(nframes() - 1, frame); }
+
+    // true if the writer has not started to overwrite the frame since get()
+
+    bool valid(const Frame &frame) const
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return frame.slot->sequence.load(std::memory_order_relaxed) == frame.sequence;
+    }
+
+    // copy all columns of a frame, return false if it was overwritten while copying
+
+    bool copy(const Frame &frame, std::vector<std::vector<double>> &values) const
+    {
+      values.resize(frame.columns.size());
+      for (size_t k = 0; k < frame.columns.size(); k++)
+        values[k].assign(frame.columns[k], frame.columns[k] + frame.natoms);
+      return valid(frame);
+    }
+
+   private:
+    std::string name;
+    void *segment;
+    size_t nbytes;
+    std::vector<std::string> names;
+
+    const SegmentHeader *header() const { return (const SegmentHeader *) segment; }
+  };
+
+}    // namespace Shm
+}    // namespace LAMMPS_NS
+
+#endif
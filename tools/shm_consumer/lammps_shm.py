@@ -0,0 +1,139 @@
+# ----------------------------------------------------------------------
+#   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+#   https://www.lammps.org/ Sandia National Laboratories
+#   LAMMPS Development team: developers@lammps.org
+#
+#   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+#   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+#   certain rights in this software.  This software is distributed under
+#   the GNU General Public License.
+#
+#   See the README file in the top-level LAMMPS directory.
+# -------------------------------------------------------------------------
+
+"""Python consumer for the shared memory segment written by dump shm.
+
+Same protocol as lammps_shm.h, see shm_format.h in src/EXTRA-DUMP.
+Maps the segment through /dev/shm, so this module is for Linux only.
+
+Example:
+
+    from lammps_shm import ShmConsumer
+    shm = ShmConsumer("lammps_dump")
+    frame = shm.latest()
+    if frame:
+        x = frame.columns["x"].copy()     # numpy view into the segment
+        if shm.valid(frame): ...          # x was not overwritten while copying
+"""
+
+import mmap
+import os
+import struct
+
+import numpy as np
+
+MAGIC = b"LMPSHM01"
+VERSION = 1
+ACTIVE, CLOSED, RESIZED = 1, 2, 3
+
+# struct layouts matching shm_format.h
+
+SEGMENT = struct.Struct("=8siiiiqqqqqii16s")
+SLOT = struct.Struct("=qqqqiid9d6i")
+NAMELEN = 32
+NFRAMES_OFFSET = 56
+STATE_OFFSET = 64
+
+
+class Frame:
+  def __init__(self, index, sequence, slot, ntimestep, natoms, wtime, triclinic, time, box, columns):
+    self.index = index
+    self.sequence = sequence
+    self.slot = slot
+    self.ntimestep = ntimestep
+    self.natoms = natoms
+    self.wtime = wtime
+    self.triclinic = triclinic
+    self.time = time
+    self.box = box
+    self.columns = columns
+
+
+class ShmConsumer:
+  def __init__(self, name):
+    self.name = name.lstrip("/")
+    self.buf = None
+    if not self.attach():
+      raise FileNotFoundError("Shared memory segment /%s is not available" % self.name)
+
+  def attach(self):
+    """(Re)map the segment read-only, return False if it does not exist (yet).
+    A CLOSED segment (kept with dump_modify unlink no) can still be read."""
+    self.detach()
+    try:
+      fd = os.open(os.path.join("/dev/shm", self.name), os.O_RDONLY)
+    except OSError:
+      return False
+    try:
+      self.buf = mmap.mmap(fd, 0, mmap.MAP_SHARED, mmap.PROT_READ)
+    finally:
+      os.close(fd)
+
+    (magic, version, self.ncolumns, self.nslots, self.pid, self.capacity, self.slot_offset,
+     self.slot_bytes, self.data_offset, _, _, _, units) = SEGMENT.unpack_from(self.buf, 0)
+    if magic != MAGIC or version != VERSION or self.state() == 0:
+      self.detach()
+      return False
+    self.units = units.split(b"\0")[0].decode()
+    self.names = []
+    for i in range(self.ncolumns):
+      raw = self.buf[SEGMENT.size + i*NAMELEN:SEGMENT.size + (i+1)*NAMELEN]
+      self.names.append(raw.split(b"\0")[0].decode())
+    return True
+
+  def detach(self):
+    if self.buf is not None:
+      try:
+        self.buf.close()
+      except BufferError:
+        pass  # numpy views of a frame are still alive
+    self.buf = None
+
+  def state(self):
+    return struct.unpack_from("=i", self.buf, STATE_OFFSET)[0]
+
+  def nframes(self):
+    return struct.unpack_from("=q", self.buf, NFRAMES_OFFSET)[0]
+
+  def _sequence(self, islot):
+    return struct.unpack_from("=q", self.buf, self.slot_offset + islot*self.slot_bytes)[0]
+
+  def get(self, index):
+    """Zero-copy view of frame index, or None if it is not available."""
+    if index < 0 or index >= self.nframes():
+      return None
+    islot = index % self.nslots
+    sequence = self._sequence(islot)
+    if sequence != 2*index + 2:
+      return None
+
+    start = self.slot_offset + islot*self.slot_bytes
+    values = SLOT.unpack_from(self.buf, start)
+    _, ntimestep, natoms, wtime, triclinic, _, time = values[:7]
+    box = np.array(values[7:16]).reshape(3, 3)
+    if natoms < 0 or natoms > self.capacity:
+      return None
+    columns = {}
+    for k, name in enumerate(self.names):
+      offset = start + self.data_offset + k*self.capacity*8
+      columns[name] = np.frombuffer(self.buf, dtype=np.float64, count=natoms, offset=offset)
+    frame = Frame(index, sequence, islot, ntimestep, natoms, wtime, triclinic, time, box, columns)
+    return frame if self.valid(frame) else None
+
+  def latest(self):
+    """Newest complete frame, or None."""
+    return self.get(self.nframes() - 1)
+
+  def valid(self, frame):
+    """True if the writer has not started to overwrite the frame since get()."""
+    return self._sequence(frame.slot) == frame.sequence
@@ -0,0 +1,120 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// latency benchmark and example consumer for dump shm
+//
+// usage: shm_latency name [nframes]
+//   waits for the segment to appear, then polls for new frames,
+//   copies each new frame out of the segment and reports
+//   the delay between publishing and seeing a frame,
+//   the time to copy a frame, and the # of lost and torn frames
+
+#include "lammps_shm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace LAMMPS_NS;
+
+static int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static void report(const char *label, std::vector<double> &values)
+{
+  if (values.empty()) return;
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (double v : values) sum += v;
+  size_t n = values.size();
+  printf("%-14s min %10.2f  median %10.2f  p99 %10.2f  max %10.2f  mean %10.2f us\n", label,
+         values[0], values[n / 2], values[std::min(n - 1, n * 99 / 100)], values[n - 1],
+         sum / n);
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s name [nframes]\n", argv[0]);
+    return 1;
+  }
+  long maxframes = (argc > 2) ? atol(argv[2]) : 100;
+
+  Shm::Consumer consumer(argv[1]);
+  while (!consumer.attach()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  printf("Attached to %s with columns:", argv[1]);
+  for (const auto &name : consumer.column_names()) printf(" %s", name.c_str());
+  printf("\n");
+
+  std::vector<double> latency, copytime;
+  std::vector<std::vector<double>> values;
+  Shm::Frame frame;
+  int64_t last = -1;
+  long nseen = 0, nlost = 0, ntorn = 0;
+  double nbytes = 0.0;
+
+  while (nseen < maxframes) {
+    int64_t n = consumer.nframes();
+
+    // writer closed segment or replaced it with a larger one
+
+    if (consumer.state() != Shm::ACTIVE) {
+      if (consumer.state() == Shm::CLOSED) break;
+      while (!consumer.attach()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      last = -1;
+      continue;
+    }
+
+    if (n - 1 == last) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    if (!consumer.latest(frame)) {
+      ntorn++;
+      continue;
+    }
+    int64_t seen = now_ns();
+    if (last >= 0) nlost += frame.index - last - 1;
+    last = frame.index;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = consumer.copy(frame, values);
+    auto stop = std::chrono::steady_clock::now();
+    if (!ok) {
+      ntorn++;
+      continue;
+    }
+
+    nseen++;
+    latency.push_back(1.0e-3 * (seen - frame.wtime));
+    copytime.push_back(1.0e-3 *
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    nbytes += frame.natoms * frame.columns.size() * sizeof(double);
+  }
+
+  double total = 0.0;
+  for (double t : copytime) total += t;
+  printf("Frames: %ld received, %ld lost, %ld overwritten while reading\n", nseen, nlost, ntorn);
+  report("Latency:", latency);
+  report("Copy time:", copytime);
+  if (total > 0.0) printf("Copy bandwidth: %.1f MB/s\n", nbytes / total);
+  return 0;
+}
@@ -4,7 +4,10 @@
 #include "library.h"
 #include "lmptype.h"
 #include "platform.h"
+#include <cstdio>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -18,6 +21,7 @@ using ::LAMMPS_NS::bigint;
 using ::LAMMPS_NS::tagint;
 using ::LAMMPS_NS::platform::path_join;
 using ::testing::HasSubstr;
+using ::testing::Not;
 using ::testing::StartsWith;
 using ::testing::StrEq;
 
@@ -82,6 +86,68 @@ TEST_F(LibraryProperties, get_mpi_comm)
         EXPECT_EQ(f_comm, -1);
 };
 
+TEST_F(LibraryProperties, get_timer_info)
+{
+    EXPECT_EQ(lammps_get_timer_info(lmp, nullptr, 0), 0);
+
+    if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
+    std::string input = path_join(INPUT_DIR, "in.fourmol");
+    ::testing::internal::CaptureStdout();
+    lammps_file(lmp, input.c_str());
+    lammps_command(lmp, "pair_style hybrid zero 8.0 zero 4.0");
+    lammps_command(lmp, "pair_coeff * * zero 1");
+    lammps_command(lmp, "pair_coeff 1 1 zero 2");
+    lammps_command(lmp, "fix 1 all nve");
+    lammps_command(lmp, "timer full export test_timer_info.csv");
+    lammps_command(lmp, "run 10");
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    int len = lammps_get_timer_info(lmp, nullptr, 0);
+    ASSERT_GT(len, 0);
+    std::vector<char> buffer(len + 1);
+    EXPECT_EQ(lammps_get_timer_info(lmp, buffer.data(), len + 1), len);
+    std::string info(buffer.data());
+    EXPECT_EQ(info.size(), len);
+    EXPECT_THAT(info, HasSubstr("\"nsteps\": 10"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"zero 1\", \"calls\": 10"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"zero 2\", \"calls\": 10"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"fix 1\""));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"initial_integrate\", \"calls\": 10"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"final_integrate\", \"calls\": 10"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"forward\""));
+
+    // truncated copy still returns the full length
+    char small[16];
+    EXPECT_EQ(lammps_get_timer_info(lmp, small, 16), len);
+    EXPECT_EQ(strlen(small), 15);
+
+    FILE *fp = fopen("test_timer_info.csv", "r");
+    ASSERT_NE(fp, nullptr);
+    char line[256];
+    std::string csv;
+    while (fgets(line, sizeof(line), fp)) csv += line;
+    fclose(fp);
+    remove("test_timer_info.csv");
+    EXPECT_THAT(csv, StartsWith("section,calls,min,avg,max,percent\n"));
+    EXPECT_THAT(csv, HasSubstr("\"Modify:fix 1:initial_integrate\",10,"));
+    EXPECT_THAT(csv, HasSubstr("\"Pair:zero 2\",10,"));
+
+    // no breakdown below the sections without timer full
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "timer normal export none");
+    lammps_command(lmp, "run 5");
+    output = ::testing::internal::GetCapturedStdout();
+    len    = lammps_get_timer_info(lmp, nullptr, 0);
+    buffer.resize(len + 1);
+    lammps_get_timer_info(lmp, buffer.data(), len + 1);
+    info = buffer.data();
+    EXPECT_THAT(info, HasSubstr("\"nsteps\": 5"));
+    EXPECT_THAT(info, HasSubstr("\"name\": \"Pair\""));
+    EXPECT_THAT(info, Not(HasSubstr("zero 1")));
+    EXPECT_THAT(info, Not(HasSubstr("fix 1")));
+};
+
 TEST_F(LibraryProperties, natoms)
 {
     if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for the Jacobi preconditioner of fix electrode/conp algo cg
+
+#include "atom.h"
+#include "info.h"
+#include "lammps.h"
+#include "utils.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class ElectrodePrecondTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "ElectrodePrecondTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // two electrodes of two atom types with very different Thomas-Fermi
+    // lengths, so the diagonal of the elastance matrix is not uniform,
+    // and ions in between, solved from zero electrode charges
+
+    void setup_system(const std::string &kspace, const std::string &precond)
+    {
+        HIDE_OUTPUT([&] {
+            command("clear");
+            command("units real");
+            command("boundary p p f");
+            command("atom_style full");
+            command("lattice sc 3.0");
+            command("region box block 0 6 0 6 -8 8");
+            command("create_box 4 box");
+            command("region lo block INF INF INF INF -8 -6");
+            command("region hi block INF INF INF INF 6 8");
+            command("region mid block INF INF INF INF -3 3");
+            command("create_atoms 1 region lo");
+            command("create_atoms 1 region hi");
+            command("create_atoms 3 random 10 4827 mid overlap 2.0 maxtry 1000");
+            command("create_atoms 4 random 10 9183 mid overlap 2.0 maxtry 1000");
+            command("set type 1 type/ratio 2 0.5 2948");
+            command("mass * 12.0");
+            command("set type 3 charge 1.0");
+            command("set type 4 charge -1.0");
+            command("group ele type 1 2");
+            command("variable zpos atom \"z > 0\"");
+            command("group zpos variable zpos");
+            command("group top intersect ele zpos");
+            command("group bot subtract ele top");
+            command("pair_style lj/cut/coul/long 8.0");
+            command("pair_coeff * * 0.1 3.0");
+            command("kspace_style " + kspace + " 1.0e-8");
+            command("kspace_modify slab 3.0");
+            command("fix conp bot electrode/conp -1.0 1.979 couple top 1.0 symm on "
+                    "algo cg 1.0e-14 precond " + precond);
+            command("fix_modify conp tf 1 0.5 10.0");
+            command("fix_modify conp tf 2 3.0 10.0");
+        });
+    }
+
+    // number of CG steps reported when the fix is deleted
+
+    double run_cg_steps()
+    {
+        HIDE_OUTPUT([&] { command("run 0 post no"); });
+        auto output = CAPTURE_OUTPUT([&] { command("unfix conp"); });
+        auto pos    = output.find("Average conjugate gradient steps: ");
+        if (pos == std::string::npos) return -1.0;
+        return utils::numeric(FLERR, utils::trim(output.substr(pos + 34)), false, lmp);
+    }
+
+    // electrode charges indexed by atom ID
+
+    std::vector<double> get_charges()
+    {
+        auto atom = lmp->atom;
+        std::vector<double> charges(atom->natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; i++) charges[atom->tag[i] - 1] = atom->q[i];
+        return charges;
+    }
+};
+
+TEST_F(ElectrodePrecondTest, fewer_steps)
+{
+    if (!info->has_style("fix", "electrode/conp")) GTEST_SKIP();
+
+    for (const auto &kspace : {"ewald/electrode", "pppm/electrode"}) {
+        setup_system(kspace, "none");
+        const double nsteps_none = run_cg_steps();
+        const auto qref          = get_charges();
+
+        setup_system(kspace, "jacobi");
+        const double nsteps_jacobi = run_cg_steps();
+        const auto q               = get_charges();
+
+        ASSERT_GT(nsteps_none, 0.0) << kspace;
+        ASSERT_GT(nsteps_jacobi, 0.0) << kspace;
+        EXPECT_LT(nsteps_jacobi, nsteps_none) << kspace;
+
+        // both converge to the same charges
+
+        ASSERT_EQ(q.size(), qref.size());
+        for (std::size_t i = 0; i < q.size(); i++) EXPECT_NEAR(q[i], qref[i], 1.0e-6) << kspace;
+    }
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (LAMMPS_NS::platform::mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
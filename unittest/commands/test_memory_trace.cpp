@@ -0,0 +1,181 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "memory.h"
+#include "platform.h"
+#include "update.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <mpi.h>
+#include <string>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+namespace LAMMPS_NS {
+using ::testing::ContainsRegex;
+using ::testing::Not;
+
+// the timestep loop of the benchmark inputs must not allocate after the first run
+
+class MemoryTraceTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "MemoryTraceTest";
+        LAMMPSTest::SetUp();
+    }
+
+    void run_traced(bigint nsteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("memory trace yes");
+        command(fmt::format("run {}", nsteps));
+        END_HIDE_OUTPUT();
+        ASSERT_EQ(lmp->update->ntimestep % nsteps, 0);
+        if (lmp->memory->trace_count() != 0) std::cout << lmp->memory->trace_info();
+    }
+};
+
+TEST_F(MemoryTraceTest, Tracer)
+{
+    ASSERT_EQ(lmp->memory->trace_count(), -1);
+    ASSERT_THAT(lmp->memory->trace_info(), ContainsRegex("tracing is off"));
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory trace yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->memory->trace_count(), 0);
+
+    // only allocations between trace_start() and trace_stop() are counted
+
+    void *ptr = lmp->memory->smalloc(100, "test:before");
+    lmp->memory->sfree(ptr);
+    lmp->memory->trace_start();
+    ptr = lmp->memory->smalloc(100, "test:during");
+    lmp->memory->sfree(ptr);
+    auto words = utils::split_words("one two three four five six seven eight nine ten");
+    lmp->memory->trace_stop(10);
+    ptr = lmp->memory->smalloc(100, "test:after");
+    lmp->memory->sfree(ptr);
+    ASSERT_EQ(words.size(), 10);
+
+    auto trace = lmp->memory->trace_info();
+    ASSERT_THAT(trace, ContainsRegex("during 1 runs with 10 steps"));
+    ASSERT_THAT(trace, ContainsRegex("array test:during"));
+    ASSERT_THAT(trace, Not(ContainsRegex("array test:before")));
+    ASSERT_THAT(trace, Not(ContainsRegex("array test:after")));
+#if defined(LAMMPS_TRACE_NEW) && defined(__GLIBC__)
+    ASSERT_GT(lmp->memory->trace_count(), 1);
+    ASSERT_THAT(trace, ContainsRegex("new in "));
+#else
+    ASSERT_EQ(lmp->memory->trace_count(), 1);
+#endif
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory trace no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->memory->trace_count(), -1);
+    TEST_FAILURE(".*ERROR: Illegal memory trace command: missing argument.*",
+                 command("memory trace"););
+}
+
+TEST_F(MemoryTraceTest, LJ)
+{
+    const std::string input = STRINGIFY(TEST_INPUT_FOLDER) "/bench/in.lj";
+    if (!platform::file_is_readable(input)) GTEST_SKIP();
+
+    HIDE_OUTPUT([&] { lmp->input->file(input.c_str()); });
+    run_traced(100);
+    ASSERT_EQ(lmp->memory->trace_count(), 0);
+}
+
+TEST_F(MemoryTraceTest, Rhodo)
+{
+    if (!info->has_style("pair", "lj/charmm/coul/long")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    if (!info->has_style("fix", "shake")) GTEST_SKIP();
+
+    // use rhodopsin benchmark if its data file is present, else the same
+    // force field and fixes with the smaller peptide example
+
+    const std::string bench = STRINGIFY(TEST_INPUT_FOLDER) "/bench";
+    if (platform::file_is_readable(bench + "/data.rhodo")) {
+        const std::string cwd = platform::current_directory();
+        platform::chdir(bench);
+        HIDE_OUTPUT([&] { lmp->input->file("in.rhodo"); });
+        platform::chdir(cwd);
+    } else {
+        const std::string data = STRINGIFY(TEST_INPUT_FOLDER) "/examples/peptide/data.peptide";
+        if (!platform::file_is_readable(data)) GTEST_SKIP();
+        BEGIN_HIDE_OUTPUT();
+        command("units real");
+        command("neigh_modify delay 5 every 1");
+        command("atom_style full");
+        command("bond_style harmonic");
+        command("angle_style charmm");
+        command("dihedral_style charmm");
+        command("improper_style harmonic");
+        command("pair_style lj/charmm/coul/long 8.0 10.0");
+        command("pair_modify mix arithmetic");
+        command("kspace_style pppm 1e-4");
+        command("read_data " + data);
+        command("fix 1 all shake 0.0001 5 0 m 1.0 a 31");
+        command("fix 2 all npt temp 300.0 300.0 100.0 z 0.0 0.0 1000.0 mtk no pchain 0 "
+                "tchain 1");
+        command("special_bonds charmm");
+        command("thermo 50");
+        command("thermo_style multi");
+        command("timestep 2.0");
+        command("run 100");
+        END_HIDE_OUTPUT();
+    }
+    run_traced(100);
+    ASSERT_EQ(lmp->memory->trace_count(), 0);
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (LAMMPS_NS::platform::mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -4,10 +4,13 @@
 #include "atom.h"
 #include "comm.h"
 #include "domain.h"
+#include "force.h"
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
+#include "neigh_list.h"
 #include "neighbor.h"
+#include "pair.h"
 #include "timer.h"
 #include <string>
 
@@ -191,6 +194,99 @@ TEST_F(MPILoadBalanceTest, rcb)
     ASSERT_GT(dz, lmp->neighbor->skin);
 }
 
+TEST_F(MPILoadBalanceTest, diffuse)
+{
+    command("comm_style tiled");
+    command("create_atoms 1 single 0 0 0");
+    command("create_atoms 1 single 0 0 5");
+    command("create_atoms 1 single 0 5 0");
+    command("create_atoms 1 single 0 5 5");
+    command("create_atoms 1 single 5 0 0");
+    command("create_atoms 1 single 5 0 5");
+    command("create_atoms 1 single 5 5 0");
+    command("create_atoms 1 single 5 5 5");
+
+    // no RCB tiling yet, so diffuse performs RCB
+    command("balance 1 diffuse 10 1.0");
+    ASSERT_EQ(lmp->comm->layout, Comm::LAYOUT_TILED);
+    ASSERT_EQ(lmp->atom->nlocal, 2);
+
+    // add atoms to one corner, then move cuts towards balance
+    command("create_atoms 1 single 1 1 1");
+    command("create_atoms 1 single 1 1 2");
+    command("create_atoms 1 single 1 2 1");
+    command("create_atoms 1 single 2 1 1");
+
+    int nlocal = lmp->atom->nlocal;
+    int maxinit, maxfinal, natoms;
+    MPI_Allreduce(&nlocal, &maxinit, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    command("balance 1 diffuse 10 1.0");
+    ASSERT_EQ(lmp->comm->layout, Comm::LAYOUT_TILED);
+
+    nlocal = lmp->atom->nlocal;
+    MPI_Allreduce(&nlocal, &maxfinal, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&nlocal, &natoms, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(natoms, 12);
+    ASSERT_LT(maxfinal, maxinit);
+
+    // my atoms are inside my sub-domain
+    double **x = lmp->atom->x;
+    for (int i = 0; i < nlocal; i++) {
+        for (int j = 0; j < 3; j++) {
+            ASSERT_GE(x[i][j], lmp->domain->sublo[j]);
+            ASSERT_LE(x[i][j], lmp->domain->subhi[j]);
+        }
+    }
+}
+
+TEST_F(MPILoadBalanceTest, rcb_cost)
+{
+    // atoms in the dense corner have many more neighbors than the others
+
+    command("comm_style tiled");
+    command("region dense block 0 6 0 6 0 6");
+    command("create_atoms 1 random 400 4567 dense");
+    command("create_atoms 1 random 400 7654 NULL");
+    command("run 0 post no");
+
+    // ratio of max to average # of neighbor pairs per proc after next neighbor list build
+
+    auto pair_imbalance = [&]() {
+        command("run 0 post no");
+        auto list    = lmp->force->pair->list;
+        double npair = 0.0;
+        for (int ii = 0; ii < list->inum; ii++)
+            npair += list->numneigh[list->ilist[ii]];
+        double maxpair, sumpair;
+        MPI_Allreduce(&npair, &maxpair, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        MPI_Allreduce(&npair, &sumpair, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return maxpair * lmp->comm->nprocs / sumpair;
+    };
+
+    // balancing atom counts leaves the pair work imbalanced, balancing the cost does not
+
+    command("balance 1.0 rcb");
+    double imbatoms = pair_imbalance();
+    command("balance 1.0 rcb weight cost 1.0 0");
+    double imbcost = pair_imbalance();
+    EXPECT_GT(imbatoms, 1.5);
+    EXPECT_LT(imbcost, 1.1);
+
+    // procs without atoms of the dense corner own more atoms
+
+    int nlocal = lmp->atom->nlocal;
+    int nmin, nmax;
+    MPI_Allreduce(&nlocal, &nmin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(&nlocal, &nmax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    EXPECT_GT(nmax, 2 * nmin);
+
+    // cost factors are relative, the same factor for all type pairs changes nothing
+
+    command("balance 1.0 rcb weight cost 1.0 1 * * 4.0");
+    EXPECT_LT(pair_imbalance(), 1.1);
+}
+
 TEST_F(MPILoadBalanceTest, rcb_min_size)
 {
     GTEST_SKIP();
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for the single precision ghost grid communication of PPPM
+
+#include "atom.h"
+#include "info.h"
+#include "lammps.h"
+#include "library.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class PPPMHaloMPITest : public LAMMPSTest {
+protected:
+    int nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        testbinary = "PPPMHaloMPITest";
+        LAMMPSTest::SetUp();
+    }
+
+    // random mix of positive and negative charges on a lattice, with fixed
+    // grid and splitting parameter, so both settings use the same PPPM
+
+    void setup_system(const std::string &halo)
+    {
+        HIDE_OUTPUT([&] {
+            command("clear");
+            command("atom_style charge");
+            command("atom_modify map array");
+            command("lattice sc 0.8");
+            command("region box block 0 8 0 8 0 8");
+            command("create_box 2 box");
+            command("create_atoms 1 box");
+            command("displace_atoms all random 0.1 0.1 0.1 4728");
+            command("set type 1 type/ratio 2 0.5 5829");
+            command("set type 1 charge 1.0");
+            command("set type 2 charge -1.0");
+            command("mass * 1.0");
+            command("velocity all create 1.0 87287 loop geom");
+            command("pair_style lj/cut/coul/long 2.5");
+            command("pair_coeff * * 1.0 1.0");
+            command("kspace_style pppm 1.0e-5");
+            command("kspace_modify mesh 20 20 20 order 5 gewald 1.2 halo " + halo);
+            command("fix 1 all nve");
+            command("thermo_style custom step pe ke press elong");
+        });
+    }
+
+    // forces indexed by atom ID, identical on all ranks
+
+    std::vector<double> get_forces()
+    {
+        auto atom = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(3 * natoms, 0.0), all(3 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; i++)
+            for (int j = 0; j < 3; j++) mine[3 * (atom->tag[i] - 1) + j] = atom->f[i][j];
+        MPI_Allreduce(mine.data(), all.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+};
+
+TEST_F(PPPMHaloMPITest, single_vs_double)
+{
+    ASSERT_GE(nprocs, 4);
+    if (!info->has_style("pair", "lj/cut/coul/long")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    if (Info::has_fft_single_support()) GTEST_SKIP();
+
+    setup_system("double");
+    HIDE_OUTPUT([&] { command("run 10 post no"); });
+    const auto fref    = get_forces();
+    const double elong = lammps_get_thermo(lmp, "elong");
+    const double pe    = lammps_get_thermo(lmp, "pe");
+    const double prs   = lammps_get_thermo(lmp, "press");
+
+    setup_system("single");
+    auto output = CAPTURE_OUTPUT([&] { command("run 10 post no"); });
+
+    // only rank 0 writes to the screen
+
+    int single = (output.find("using single precision for ghost grid communication") !=
+                  std::string::npos);
+    MPI_Bcast(&single, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    ASSERT_TRUE(single);
+
+    // the ghost grid values are rounded to float, so forces differ by
+    // a few float epsilon relative to the largest kspace contributions
+
+    const auto f = get_forces();
+    ASSERT_EQ(f.size(), fref.size());
+    double fmax = 0.0, dmax = 0.0;
+    for (std::size_t i = 0; i < f.size(); i++) {
+        fmax = std::max(fmax, std::fabs(fref[i]));
+        dmax = std::max(dmax, std::fabs(f[i] - fref[i]));
+    }
+    EXPECT_GT(dmax, 0.0);
+    EXPECT_LT(dmax, 1.0e-5 * fmax);
+    EXPECT_NEAR(lammps_get_thermo(lmp, "elong"), elong, 1.0e-6 * std::fabs(elong));
+    EXPECT_NEAR(lammps_get_thermo(lmp, "pe"), pe, 1.0e-6 * std::fabs(pe));
+    EXPECT_NEAR(lammps_get_thermo(lmp, "press"), prs, 1.0e-5 * std::fabs(prs));
+}
+} // namespace LAMMPS_NS
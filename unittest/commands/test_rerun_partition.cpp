@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for the rerun command with snapshots shared between partitions
+
+#include "lammps.h"
+#include "universe.h"
+#include "update.h"
+#include "utils.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class RerunPartitionTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "RerunPartitionTest";
+        args       = {"-partition", "2x1",  "-in",     "none", "-log",  "rerun_partition.log",
+                      "-pscreen",   "none", "-plog",   "none", "-echo", "none",
+                      "-nocite"};
+        LAMMPSTest::SetUp();
+    }
+
+    void InitSystem() override
+    {
+        HIDE_OUTPUT([&] {
+            command("units lj");
+            command("lattice fcc 0.8442");
+            command("region box block 0 4 0 4 0 4");
+            command("create_box 1 box");
+            command("create_atoms 1 box");
+            command("mass 1 1.0");
+            command("velocity all create 3.0 87287");
+            command("pair_style lj/cut 2.5");
+            command("pair_coeff 1 1 1.0 1.0 2.5");
+            command("fix 1 all nve");
+            command("thermo 1");
+        });
+    }
+
+    void TearDown() override
+    {
+        LAMMPSTest::TearDown();
+        int me;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        if (me == 0) {
+            platform::unlink("rerun_partition.log");
+            platform::unlink("rerun_partition.dump");
+        }
+    }
+};
+
+TEST_F(RerunPartitionTest, thermo_order)
+{
+    ASSERT_EQ(lmp->universe->nworlds, 2);
+
+    // first partition writes the dump file, both read it
+
+    HIDE_OUTPUT([&] {
+        command("partition yes 1 dump 1 all custom 1 rerun_partition.dump id type x y z");
+        command("run 6 post no");
+        command("partition yes 1 undump 1");
+    });
+    MPI_Barrier(MPI_COMM_WORLD);
+    HIDE_OUTPUT([&] { command("rerun rerun_partition.dump partition yes dump x y z"); });
+
+    // snapshots alternate between partitions, starting with the first one
+
+    EXPECT_EQ(lmp->update->ntimestep, (lmp->universe->iworld == 0) ? 6 : 5);
+
+    // universe log file has thermo output of both partitions in timestep order
+
+    if (lmp->universe->me == 0) {
+        std::ifstream log("rerun_partition.log");
+        std::string line;
+        while (std::getline(log, line))
+            if (utils::strmatch(line, "^Rerun thermo output of 2 partitions")) break;
+        ASSERT_TRUE(std::getline(log, line));
+        ASSERT_TRUE(utils::strmatch(line, "^\\s*Step"));
+
+        std::vector<bigint> steps;
+        while (std::getline(log, line)) {
+            auto words = utils::split_words(line);
+            if (words.empty() || !utils::is_integer(words[0])) break;
+            steps.push_back(utils::bnumeric(FLERR, words[0], false, lmp));
+        }
+        EXPECT_EQ(steps, std::vector<bigint>({0, 1, 2, 3, 4, 5, 6}));
+    }
+}
+} // namespace LAMMPS_NS
@@ -13,11 +13,16 @@
 
 #include "lammps.h"
 
+#include "atom.h"
 #include "citeme.h"
 #include "comm.h"
 #include "force.h"
 #include "info.h"
 #include "input.h"
+#include "kspace.h"
+#include "library.h"
+#include "memory.h"
+#include "modify.h"
 #include "output.h"
 #include "update.h"
 #include "utils.h"
@@ -28,11 +33,14 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <mpi.h>
+#include <string>
+#include <vector>
 
 // whether to print verbose output (i.e. not capturing LAMMPS screen output).
 bool verbose = false;
@@ -40,6 +48,7 @@ bool verbose = false;
 namespace LAMMPS_NS {
 using ::testing::ContainsRegex;
 using ::testing::ExitedWithCode;
+using ::testing::Not;
 using ::testing::StrEq;
 
 class SimpleCommandsTest : public LAMMPSTest {};
@@ -125,6 +134,43 @@ TEST_F(SimpleCommandsTest, Log)
     TEST_FAILURE(".*ERROR: Illegal log command.*", command("log"););
 }
 
+TEST_F(SimpleCommandsTest, Memory)
+{
+    ASSERT_EQ(lmp->memory->pool_minbytes(), 0);
+    ASSERT_THAT(lmp->memory->pool_info(), ContainsRegex("hugepage = none, arena = no"));
+
+#if defined(__linux__) && !defined(LAMMPS_MEMALIGN_TBB)
+    BEGIN_HIDE_OUTPUT();
+    command("memory hugepage thp arena yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->memory->pool_minbytes(), 2 * 1024 * 1024);
+
+    // large blocks are kept in the arena after they are freed and reused
+    void *ptr = lmp->memory->smalloc(3 * 1024 * 1024, "test:ptr");
+    memset(ptr, 1, 3 * 1024 * 1024);
+    ptr = lmp->memory->srealloc(ptr, 4 * 1024 * 1024, "test:ptr");
+    ASSERT_EQ(((char *)ptr)[3 * 1024 * 1024 - 1], 1);
+    lmp->memory->sfree(ptr);
+    ASSERT_THAT(lmp->memory->pool_info(), ContainsRegex("blocks in arena: 1 "));
+    ptr = lmp->memory->smalloc(3 * 1024 * 1024, "test:ptr");
+    ASSERT_THAT(lmp->memory->pool_info(), ContainsRegex("blocks in arena: 0 "));
+    lmp->memory->sfree(ptr);
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory hugepage none arena no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->memory->pool_minbytes(), 0);
+    ASSERT_THAT(lmp->memory->pool_info(), ContainsRegex("blocks in arena: 0 "));
+#endif
+
+    TEST_FAILURE(".*ERROR: Illegal memory command: missing argument.*", command("memory"););
+    TEST_FAILURE(".*ERROR: Unknown memory keyword: xxx.*", command("memory xxx yes"););
+    TEST_FAILURE(".*ERROR: Unknown memory hugepage setting: xxx.*",
+                 command("memory hugepage xxx"););
+    TEST_FAILURE(".*ERROR: Expected boolean parameter instead of 'xxx'.*",
+                 command("memory arena xxx"););
+}
+
 TEST_F(SimpleCommandsTest, Newton)
 {
     // default setting is "on" for both
@@ -380,6 +426,240 @@ TEST_F(SimpleCommandsTest, TimeStep)
     TEST_FAILURE(".*ERROR: Expected floating point.*", command("timestep xxx"););
 }
 
+TEST_F(SimpleCommandsTest, TimerTrace)
+{
+    if (!info->has_style("pair", "lj/cut")) GTEST_SKIP();
+
+    const std::string file = "test_timer_trace.json";
+    BEGIN_HIDE_OUTPUT();
+    command("lattice fcc 0.8442");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("fix 1 all nve");
+    command("timer trace " + file + " sample 5");
+    command("run 20");
+    END_HIDE_OUTPUT();
+
+    // one event per section, fix callback and comm operation in each sampled step
+
+    std::string text;
+    for (const auto &line : read_lines(file)) text += line;
+    delete_file(file);
+    ASSERT_THAT(text, ContainsRegex("^\\{\"displayTimeUnit\": \"ms\", \"traceEvents\": \\["));
+    ASSERT_THAT(text, ContainsRegex("\"args\": \\{\"name\": \"MPI rank 0\"\\}"));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"Step 5\", \"cat\": \"Step\", \"ph\": \"X\""));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"Step 20\""));
+    ASSERT_THAT(text, Not(ContainsRegex("\"name\": \"Step 3\"")));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"Pair\", \"cat\": \"Pair\""));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"fix 1 initial_integrate\", \"cat\": \"Modify\""));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"forward\", \"cat\": \"Comm\""));
+    ASSERT_THAT(text, ContainsRegex("\"name\": \"MPI wait\", \"cat\": \"Sync\""));
+    ASSERT_THAT(text, ContainsRegex("\"args\": \\{\"step\": 15\\}"));
+
+    std::size_t nsteps = 0;
+    for (auto pos = text.find("\"cat\": \"Step\""); pos != std::string::npos;
+         pos = text.find("\"cat\": \"Step\"", pos + 1))
+        ++nsteps;
+    ASSERT_EQ(nsteps, 4);
+
+    BEGIN_HIDE_OUTPUT();
+    command("timer trace none");
+    command("run 5");
+    END_HIDE_OUTPUT();
+    ASSERT_FALSE(file_exists(file));
+
+    TEST_FAILURE(".*ERROR: Illegal timer command.*", command("timer trace"););
+    TEST_FAILURE(".*ERROR: Illegal timer command.*", command("timer sample 0"););
+}
+
+TEST_F(SimpleCommandsTest, KspaceEvery)
+{
+    if (!info->has_style("pair", "lj/cut/coul/long")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style charge");
+    command("lattice fcc 0.8442");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 2 box");
+    command("create_atoms 1 box basis 1 1 basis 2 2 basis 3 1 basis 4 2");
+    command("mass * 1.0");
+    command("set type 1 charge 1.0");
+    command("set type 2 charge -1.0");
+    command("velocity all create 1.0 87287 loop geom");
+    command("pair_style lj/cut/coul/long 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("kspace_style pppm 1.0e-4");
+    command("kspace_modify every 3 mts extrapolate");
+    command("fix 1 all nve");
+    command("thermo 10");
+    END_HIDE_OUTPUT();
+
+    // kspace is invoked on steps 0, 3, ..., 30 and the schedule continues with pre no
+
+    auto output = CAPTURE_OUTPUT([&] { command("run 30 post no"); });
+    ASSERT_THAT(output, ContainsRegex("KSpace skipped on 20 of 30 steps with kspace_modify every 3"));
+    ASSERT_THAT(output, ContainsRegex("total energy drift: .* per atom per step"));
+
+    output = CAPTURE_OUTPUT([&] { command("run 30 pre no post no"); });
+    ASSERT_THAT(output, ContainsRegex("KSpace skipped on 20 of 30 steps with kspace_modify every 3"));
+    ASSERT_THAT(output, ContainsRegex("total energy drift: .* per atom per step"));
+    ASSERT_EQ(lmp->update->ntimestep, 60);
+
+    output = CAPTURE_OUTPUT([&] { command("run 10 pre no post no every 5 NULL"); });
+    ASSERT_THAT(output, ContainsRegex("KSpace skipped on 3 of 5 steps with kspace_modify every 3"));
+    ASSERT_EQ(lmp->update->ntimestep, 70);
+
+    // store of extrapolated forces is removed with extrapolation
+
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify every 2 mts impulse");
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->modify->get_fix_by_id("VERLET_KSPACE"), nullptr);
+}
+
+TEST_F(SimpleCommandsTest, KspaceEveryBaseline)
+{
+    if (!info->has_style("pair", "lj/cut/coul/long")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+
+    // total energy and forces indexed by atom ID after a short run
+
+    auto run_system = [&](const std::string &every, std::vector<double> &f) {
+        BEGIN_HIDE_OUTPUT();
+        command("clear");
+        command("atom_style charge");
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 2 box");
+        command("create_atoms 1 box basis 1 1 basis 2 2 basis 3 1 basis 4 2");
+        command("displace_atoms all random 0.05 0.05 0.05 4728");
+        command("mass * 1.0");
+        command("set type 1 charge 1.0");
+        command("set type 2 charge -1.0");
+        command("velocity all create 1.0 87287 loop geom");
+        command("pair_style lj/cut/coul/long 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("kspace_style pppm 1.0e-5");
+        if (!every.empty()) command("kspace_modify " + every);
+        command("timestep 0.002");
+        command("fix 1 all nve");
+        command("thermo_style custom step pe etotal");
+        command("run 60 post no");
+        END_HIDE_OUTPUT();
+
+        auto atom = lmp->atom;
+        f.assign(3 * atom->natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; i++)
+            for (int j = 0; j < 3; j++) f[3 * (atom->tag[i] - 1) + j] = atom->f[i][j];
+        return lammps_get_thermo(lmp, "etotal");
+    };
+
+    std::vector<double> fref, f;
+    const double eref = run_system("", fref);
+
+    // every 1 takes the same code path as the default
+
+    EXPECT_EQ(run_system("every 1", f), eref);
+    EXPECT_EQ(f, fref);
+    EXPECT_EQ(run_system("every 1 mts extrapolate", f), eref);
+    EXPECT_EQ(f, fref);
+
+    // larger intervals change the trajectory only slightly, forces at the
+    // end of impulse runs are a multiple of the kspace force or lack it
+
+    for (const auto &every : {"every 2", "every 3", "every 2 mts extrapolate"}) {
+        EXPECT_NEAR(run_system(every, f), eref, 1.0e-5 * std::fabs(eref)) << every;
+        if (!utils::strmatch(every, "extrapolate")) continue;
+        ASSERT_EQ(f.size(), fref.size());
+        for (std::size_t i = 0; i < f.size(); i++) EXPECT_NEAR(f[i], fref[i], 5.0e-3) << i;
+    }
+
+    // setup_minimal() of rerun initializes the impulse schedule like setup(),
+    // so the same coordinates give the same forces as a run 0
+
+    std::vector<double> fsetup;
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify every 3 mts impulse");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    auto atom = lmp->atom;
+    fsetup.assign(3 * atom->natoms, 0.0);
+    for (int i = 0; i < atom->nlocal; i++)
+        for (int j = 0; j < 3; j++) fsetup[3 * (atom->tag[i] - 1) + j] = atom->f[i][j];
+
+    BEGIN_HIDE_OUTPUT();
+    command("write_dump all custom kspace_every.dump id x y z modify format float %23.17g");
+    command("rerun kspace_every.dump dump x y z");
+    END_HIDE_OUTPUT();
+    delete_file("kspace_every.dump");
+    for (int i = 0; i < atom->nlocal; i++)
+        for (int j = 0; j < 3; j++)
+            EXPECT_NEAR(atom->f[i][j], fsetup[3 * (atom->tag[i] - 1) + j], 1.0e-10);
+}
+
+TEST_F(SimpleCommandsTest, KspaceAutotune)
+{
+    if (!info->has_style("pair", "lj/cut/coul/long")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style charge");
+    command("lattice fcc 0.8442");
+    command("region box block 0 5 0 5 0 5");
+    command("create_box 2 box");
+    command("create_atoms 1 box basis 1 1 basis 2 2 basis 3 1 basis 4 2");
+    command("mass * 1.0");
+    command("set type 1 charge 1.0");
+    command("set type 2 charge -1.0");
+    command("pair_style lj/cut/coul/long 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("kspace_style pppm 1.0e-4");
+    command("kspace_modify autotune 2");
+    END_HIDE_OUTPUT();
+
+    // default order 5 with ik is tried first and sets the largest grid to consider
+
+    auto output = CAPTURE_OUTPUT([&] { command("run 0 post no"); });
+    ASSERT_THAT(output, ContainsRegex("PPPM autotune candidates:"));
+    ASSERT_THAT(output, ContainsRegex("order diff +grid +accuracy +time/call\n +5 +ik "));
+    ASSERT_THAT(output, ContainsRegex(" \\*\n"));
+    ASSERT_THAT(output, ContainsRegex("skipped [0-9]+ candidates needing a larger grid than"));
+
+    // tuning is done only once per setting
+
+    output = CAPTURE_OUTPUT([&] { command("run 0 post no"); });
+    ASSERT_THAT(output, Not(ContainsRegex("PPPM autotune candidates:")));
+}
+
+TEST_F(SimpleCommandsTest, KspaceHalo)
+{
+    if (!info->has_style("kspace", "pppm")) GTEST_SKIP();
+    if (!info->has_style("kspace", "pppm/cg")) GTEST_SKIP();
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style charge");
+    command("region box block 0 2 0 2 0 2");
+    command("create_box 1 box");
+    command("kspace_style pppm 1.0e-4");
+    command("kspace_modify halo single");
+    command("kspace_modify halo double");
+    command("kspace_style pppm/cg 1.0e-4");
+    command("kspace_modify halo double");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->force->kspace->halo_flag, 0);
+
+    TEST_FAILURE(".*ERROR: Kspace_modify halo single is not supported by kspace style pppm/cg.*",
+                 command("kspace_modify halo single"););
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify command.*", command("kspace_modify halo mixed"););
+}
+
 TEST_F(SimpleCommandsTest, Units)
 {
     const char *names[] = {"lj", "real", "metal", "si", "cgs", "electron", "micro", "nano"};
@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for run style verlet/task against run style verlet
+
+#include "atom.h"
+#include "info.h"
+#include "lammps.h"
+#include "library.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using ::testing::HasSubstr;
+
+namespace LAMMPS_NS {
+
+#define STRINGIFY(val) XSTR(val)
+#define XSTR(val) #val
+
+class VerletTaskTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "VerletTaskTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // fourmol system with /omp pair and bonded styles and plain pppm
+
+    void setup_system(const std::string &run_style)
+    {
+        HIDE_OUTPUT([&] {
+            command("clear");
+            command("package omp 2");
+            command("variable input_dir index \"" STRINGIFY(TEST_INPUT_FOLDER) "\"");
+            command("include \"${input_dir}/in.fourmol\"");
+            command("pair_style lj/cut/coul/long/omp 8.0");
+            command("pair_coeff * * 0.01 3.0");
+            command("bond_style harmonic/omp");
+            command("bond_coeff * 100.0 1.5");
+            command("angle_style harmonic/omp");
+            command("angle_coeff * 50.0 110.0");
+            command("dihedral_style none");
+            command("improper_style none");
+            command("kspace_style pppm 1.0e-5");
+            command("fix 1 all nve");
+            command("thermo_style custom step pe ke press");
+            command("run_style " + run_style);
+        });
+    }
+
+    // forces indexed by atom ID
+
+    std::vector<double> get_forces()
+    {
+        auto atom = lmp->atom;
+        std::vector<double> forces(3 * atom->natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; i++)
+            for (int j = 0; j < 3; j++) forces[3 * (atom->tag[i] - 1) + j] = atom->f[i][j];
+        return forces;
+    }
+};
+
+TEST_F(VerletTaskTest, forces)
+{
+    if (!info->has_style("atom", "full")) GTEST_SKIP();
+    if (!Info::has_accelerator_feature("OPENMP", "api", "openmp")) GTEST_SKIP();
+
+    setup_system("verlet");
+    HIDE_OUTPUT([&] { command("run 10 post no"); });
+    const auto fref  = get_forces();
+    const double pe  = lammps_get_thermo(lmp, "pe");
+    const double ke  = lammps_get_thermo(lmp, "ke");
+    const double prs = lammps_get_thermo(lmp, "press");
+
+    // probe 0 computes kspace concurrently on every step
+
+    setup_system("verlet/task probe 0");
+    auto output = CAPTURE_OUTPUT([&] { command("run 10 post no"); });
+    ASSERT_THAT(output, HasSubstr("Kspace computed concurrently with pair and bonded terms "
+                                  "on 10 of 10 steps"));
+
+    const auto f = get_forces();
+    ASSERT_EQ(f.size(), fref.size());
+    for (std::size_t i = 0; i < f.size(); i++) EXPECT_NEAR(f[i], fref[i], 1.0e-10) << i;
+    EXPECT_NEAR(lammps_get_thermo(lmp, "pe"), pe, 1.0e-10);
+    EXPECT_NEAR(lammps_get_thermo(lmp, "ke"), ke, 1.0e-10);
+    EXPECT_NEAR(lammps_get_thermo(lmp, "press"), prs, 1.0e-8);
+}
+
+TEST_F(VerletTaskTest, sequential)
+{
+    if (!info->has_style("atom", "full")) GTEST_SKIP();
+
+    // kspace styles with accelerator suffix are not computed concurrently
+
+    setup_system("verlet/task");
+    HIDE_OUTPUT([&] { command("kspace_style pppm/omp 1.0e-5"); });
+    auto output = CAPTURE_OUTPUT([&] { command("run 0 post no"); });
+    ASSERT_THAT(output, HasSubstr("computes forces sequentially with kspace style pppm/omp"));
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (LAMMPS_NS::platform::mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -521,6 +521,66 @@ TEST(AngleStyle, omp)
     if (!verbose) ::testing::internal::GetCapturedStdout();
 };
 
+TEST(AngleStyle, omp_color)
+{
+    if (!LAMMPS::is_installed_pkg("OPENMP")) GTEST_SKIP();
+    if (test_config.skip_tests.count(test_info_->name())) GTEST_SKIP();
+    if (test_config.skip_tests.count("omp")) GTEST_SKIP();
+
+    const char *args[] = {"AngleStyle", "-log", "none",  "-echo", "screen", "-nocite",
+                          "-pk",        "omp",  "4",     "color", "yes",    "-sf",
+                          "omp"};
+
+    char **argv = (char **)args;
+    int argc    = sizeof(args) / sizeof(char *);
+
+    ::testing::internal::CaptureStdout();
+    LAMMPS *lmp = init_lammps(argc, argv, test_config, true);
+
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    // skip unless all /omp styles of the test compute forces by color
+    if (!lmp || utils::strmatch(output, "spatial coloring not supported")) {
+        if (lmp) {
+            if (!verbose) ::testing::internal::CaptureStdout();
+            cleanup_lammps(lmp, test_config);
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+        }
+        GTEST_SKIP();
+    }
+
+    const int nlocal = lmp->atom->nlocal;
+    ASSERT_EQ(lmp->atom->natoms, nlocal);
+
+    double epsilon = 5.0 * test_config.epsilon;
+
+    ErrorStats stats;
+    auto angle = lmp->force->angle;
+
+    EXPECT_FORCES("init_forces (color)", lmp->atom, test_config.init_forces, epsilon);
+    EXPECT_STRESS("init_stress (color)", angle->virial, test_config.init_stress, 10 * epsilon);
+
+    stats.reset();
+    EXPECT_FP_LE_WITH_EPS(angle->energy, test_config.init_energy, epsilon);
+    if (print_stats) std::cerr << "init_energy stats, color: " << stats << std::endl;
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    run_lammps(lmp);
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    EXPECT_FORCES("run_forces (color)", lmp->atom, test_config.run_forces, 10 * epsilon);
+    EXPECT_STRESS("run_stress (color)", angle->virial, test_config.run_stress, 10 * epsilon);
+
+    stats.reset();
+    EXPECT_FP_LE_WITH_EPS(angle->energy, test_config.run_energy, epsilon);
+    if (print_stats) std::cerr << "run_energy  stats, color: " << stats << std::endl;
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    cleanup_lammps(lmp, test_config);
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+};
+
 TEST(AngleStyle, single)
 {
     if (test_config.skip_tests.count(test_info_->name())) GTEST_SKIP();
@@ -521,6 +521,55 @@ TEST_F(DumpAtomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpAtomTest, async_run2)
+{
+    auto dump_file  = dump_filename("async_run2");
+    auto async_file = dump_filename("async_run2_async");
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all atom 1 {}", dump_file));
+    command(fmt::format("dump id1 all atom 1 {}", async_file));
+    command("dump_modify id1 async yes");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(async_file);
+    ASSERT_EQ(count_lines(async_file), 123);
+    ASSERT_FILE_EQUAL(dump_file, async_file);
+    delete_file(dump_file);
+    delete_file(async_file);
+}
+
+TEST_F(DumpAtomTest, async_every2_run3)
+{
+    // last snapshot is taken before the last step and must be complete after the run
+
+    auto dump_file = dump_filename("async_every2_run3");
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id1 all atom 2 {}", dump_file));
+    command("dump_modify id1 async yes");
+    command("run 3 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 82);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, async_no_buffer_multi_file_run1)
+{
+    auto dump_file = dump_filename("async_run1_*");
+    generate_dump(dump_file, "async yes buffer no", 1);
+
+    auto run1_0 = dump_filename("async_run1_0");
+    auto run1_1 = dump_filename("async_run1_1");
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(count_lines(run1_0), 41);
+    ASSERT_EQ(count_lines(run1_1), 41);
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+
 TEST_F(DumpAtomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
@@ -14,13 +14,29 @@
 #include "../testing/core.h"
 #include "../testing/systems/melt.h"
 #include "../testing/utils.h"
+#include "COMPRESS/zbin_format.h"
+#include "EXTRA-DUMP/shm_format.h"
+#include "atom.h"
 #include "fmt/format.h"
 #include "output.h"
+#include "platform.h"
 #include "thermo.h"
+#include "update.h"
 #include "utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using ::testing::Eq;
 
 char *BINARY2TXT_EXECUTABLE = nullptr;
@@ -126,6 +142,37 @@ TEST_F(DumpCustomTest, run1)
     delete_file(dump_file);
 }
 
+TEST_F(DumpCustomTest, threaded_buffer_run1)
+{
+    if (!info->has_package("OPENMP")) GTEST_SKIP();
+
+    auto dump_file   = dump_filename("threaded_run1");
+    auto buffer_file = dump_filename("threaded_buffer_run1");
+    auto fields      = "id type proc x y z ix iy iz xs ys zs vx vy vz fx fy fz";
+
+    // number of threads can only be set before the box is created
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("package omp 4");
+    END_HIDE_OUTPUT();
+    InitSystem();
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom 1 {} {}", dump_file, fields));
+    command(fmt::format("dump id1 all custom 1 {} {}", buffer_file, fields));
+    command("dump_modify id0 buffer no");
+    command("dump_modify id1 buffer yes");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(buffer_file);
+    ASSERT_EQ(count_lines(buffer_file), 82);
+    ASSERT_FILE_EQUAL(dump_file, buffer_file);
+    delete_file(dump_file);
+    delete_file(buffer_file);
+}
+
 TEST_F(DumpCustomTest, thresh_run0)
 {
     auto dump_file = dump_filename("thresh_run0");
@@ -384,6 +431,237 @@ TEST_F(DumpCustomTest, rerun_bin)
     ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
     delete_file(dump_file);
 }
+
+TEST_F(DumpCustomTest, rerun_zbin)
+{
+    if (!info->has_style("dump", "custom/zbin")) GTEST_SKIP();
+
+    auto dump_file = "dump_custom_zbin_rerun.melt.zbin";
+    auto fields    = "id type x y z";
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all custom/zbin 1 {} {}", dump_file, fields));
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+    double pe_1, pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+    ASSERT_FILE_EXISTS(dump_file);
+    continue_dump(1);
+    close_dump();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 1 last 1 every 1 post no dump x y z format zbin",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_1, pe_rerun, 1.0e-14);
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 every 1 post no dump x y z format zbin",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCustomTest, rerun_zbin_quantize)
+{
+    if (!info->has_style("dump", "custom/zbin")) GTEST_SKIP();
+
+    auto lossless_file  = "dump_custom_zbin_lossless.melt.zbin";
+    auto quantized_file = "dump_custom_zbin_quantize.melt.zbin";
+    auto fields         = "id type x y z";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom/zbin 1 {} {}", lossless_file, fields));
+    command(fmt::format("dump id1 all custom/zbin 1 {} {}", quantized_file, fields));
+    command("dump_modify id1 quantize x 1.0e-4 quantize y 1.0e-4 quantize 5 1.0e-4");
+    command("run 0 post no");
+    command("undump id0");
+    command("undump id1");
+    END_HIDE_OUTPUT();
+    double pe, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe);
+    ASSERT_FILE_EXISTS(lossless_file);
+    ASSERT_FILE_EXISTS(quantized_file);
+    FILE *fp = fopen(lossless_file, "rb");
+    platform::fseek(fp, platform::END_OF_FILE);
+    auto lossless_size = platform::ftell(fp);
+    fclose(fp);
+    fp = fopen(quantized_file, "rb");
+    platform::fseek(fp, platform::END_OF_FILE);
+    auto quantized_size = platform::ftell(fp);
+    fclose(fp);
+    ASSERT_LT(quantized_size, lossless_size);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 0 last 0 post no dump x y z format zbin",
+                            quantized_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe, pe_rerun, 1.0e-3 * fabs(pe));
+    delete_file(lossless_file);
+    delete_file(quantized_file);
+}
+
+TEST_F(DumpCustomTest, rerun_zbin_mpiio)
+{
+    if (!info->has_style("dump", "custom/zbin/mpiio")) GTEST_SKIP();
+
+    auto serial_file   = "dump_custom_zbin_serial.melt.zbin";
+    auto parallel_file = "dump_custom_zbin_parallel.melt.zbin";
+    auto fields        = "id type x y z vx vy vz";
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id0 all custom/zbin 1 {} {}", serial_file, fields));
+    command(fmt::format("dump id1 all custom/zbin/mpiio 1 {} {}", parallel_file, fields));
+    command("dump_modify id0 sort id quantize x 1.0e-4");
+    command("dump_modify id1 sort id quantize x 1.0e-4");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+    continue_dump(1);
+    double pe_2, pe_rerun;
+    BEGIN_HIDE_OUTPUT();
+    command("undump id0");
+    command("undump id1");
+    END_HIDE_OUTPUT();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    ASSERT_FILE_EXISTS(serial_file);
+    ASSERT_FILE_EXISTS(parallel_file);
+    ASSERT_FILE_EQUAL(serial_file, parallel_file);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 every 1 post no dump x y z format zbin",
+                            parallel_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-3 * fabs(pe_2));
+    delete_file(serial_file);
+    delete_file(parallel_file);
+}
+
+TEST_F(DumpCustomTest, zbin_index)
+{
+    if (!info->has_style("dump", "custom/zbin")) GTEST_SKIP();
+
+    auto dump_file = "dump_custom_zbin_index.melt.zbin";
+    auto copy_file = "dump_custom_zbin_copy.melt.zbin";
+
+    // frame index is complete after every frame, while the dump is still open
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all custom/zbin 1 {} id type x y z", dump_file));
+    command("run 4 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS(dump_file);
+
+    FILE *fp = fopen(dump_file, "rb");
+    platform::fseek(fp, platform::END_OF_FILE);
+    std::string bytes(platform::ftell(fp), '\0');
+    platform::fseek(fp, 0);
+    ASSERT_EQ(fread(&bytes[0], 1, bytes.size(), fp), bytes.size());
+    fclose(fp);
+    BEGIN_HIDE_OUTPUT();
+    command("undump id");
+    END_HIDE_OUTPUT();
+
+    Zbin::IndexFooter footer;
+    memcpy(&footer, &bytes[bytes.size() - sizeof(footer)], sizeof(footer));
+    ASSERT_EQ(memcmp(footer.magic, Zbin::INDEX_MAGIC, sizeof(footer.magic)), 0);
+    ASSERT_EQ(footer.nframes, 5);
+    std::vector<Zbin::IndexEntry> index(footer.nframes);
+    memcpy(index.data(), &bytes[footer.offset], footer.nframes * sizeof(Zbin::IndexEntry));
+    for (int i = 0; i < 5; i++)
+        ASSERT_EQ(index[i].ntimestep, i);
+
+    auto write_copy = [&](const std::string &data) {
+        FILE *fp = fopen(copy_file, "wb");
+        fwrite(data.data(), 1, data.size(), fp);
+        fclose(fp);
+    };
+
+    // frames before the requested one are not read: a damaged frame 1 is not noticed
+
+    std::string damaged = bytes;
+    damaged[index[1].offset] = 'X';
+    write_copy(damaged);
+    HIDE_OUTPUT([&] { command(fmt::format("read_dump {} 3 x y z format zbin", copy_file)); });
+    ASSERT_EQ(lmp->update->ntimestep, 3);
+    TEST_FAILURE(".*ERROR on proc 0: Dump file is invalid or corrupted.*",
+                 command(fmt::format("read_dump {} 1 x y z format zbin", copy_file)););
+
+    // file of a run that crashed while writing frame 4 is read up to frame 3
+
+    write_copy(bytes.substr(0, index[4].offset + 100));
+    HIDE_OUTPUT([&] { command(fmt::format("read_dump {} 3 x y z format zbin", copy_file)); });
+    ASSERT_EQ(lmp->update->ntimestep, 3);
+    TEST_FAILURE(".*ERROR: Dump file does not contain requested snapshot.*",
+                 command(fmt::format("read_dump {} 4 x y z format zbin", copy_file)););
+
+    delete_file(dump_file);
+    delete_file(copy_file);
+}
+
+#if !defined(_WIN32)
+TEST_F(DumpCustomTest, shm)
+{
+    if (!info->has_style("dump", "shm")) GTEST_SKIP();
+
+    auto name = fmt::format("/lmp_test_dump_shm_{}", getpid());
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id all shm 1 {} id type x y z", name));
+    command("dump_modify id slots 2 sort id");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    struct stat st;
+    ASSERT_EQ(fstat(fd, &st), 0);
+    void *segment = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(segment, MAP_FAILED);
+
+    auto header = (Shm::SegmentHeader *)segment;
+    ASSERT_EQ(memcmp(header->magic, Shm::MAGIC, sizeof(header->magic)), 0);
+    ASSERT_EQ(header->ncolumns, 5);
+    ASSERT_EQ(header->nslots, 2);
+    ASSERT_EQ(header->nframes.load(), 3);
+    ASSERT_EQ(header->state.load(), Shm::ACTIVE);
+    ASSERT_GE(header->capacity, lmp->atom->natoms);
+    auto info = (Shm::ColumnInfo *)((char *)segment + sizeof(Shm::SegmentHeader));
+    ASSERT_THAT(std::string(info[2].name), Eq("x"));
+
+    // frame 2 is the last one and in slot 0
+
+    auto slot = Shm::slot(segment, 0);
+    ASSERT_EQ(slot->sequence.load(), 6);
+    ASSERT_EQ(slot->ntimestep, 2);
+    ASSERT_EQ(slot->natoms, lmp->atom->natoms);
+    ASSERT_EQ(Shm::slot(segment, 1)->ntimestep, 1);
+
+    auto id = Shm::column(segment, 0, 0);
+    auto x  = Shm::column(segment, 0, 2);
+    for (int i = 0; i < slot->natoms; i++)
+        ASSERT_EQ(id[i], i + 1);
+    for (int i = 0; i < lmp->atom->nlocal; i++)
+        ASSERT_DOUBLE_EQ(x[lmp->atom->tag[i] - 1], lmp->atom->x[i][0]);
+
+    munmap(segment, st.st_size);
+
+    // segment is removed with the dump
+
+    close_dump();
+    fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd >= 0) close(fd);
+    ASSERT_LT(fd, 0);
+}
+#endif
+
 } // namespace LAMMPS_NS
 int main(int argc, char **argv)
 {
@@ -0,0 +1,228 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for dump h5md written from all procs with parallel HDF5
+// against the same dump gathered to and written by proc 0
+
+#include "atom.h"
+#include "exceptions.h"
+#include "info.h"
+#include "lammps.h"
+#include "update.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include "hdf5.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using ::testing::HasSubstr;
+
+namespace LAMMPS_NS {
+
+// time-dependent data of one element: values of all frames and their shape
+
+struct H5MDData {
+    std::vector<hsize_t> dims;
+    std::vector<double> value;
+};
+
+class DumpH5MDMPITest : public LAMMPSTest {
+protected:
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        testbinary = "DumpH5MDMPITest";
+        LAMMPSTest::SetUp();
+    }
+
+    void setup_system()
+    {
+        HIDE_OUTPUT([&] {
+            command("atom_modify map array");
+            command("lattice fcc 0.8442");
+            command("region box block 0 6 0 6 0 6");
+            command("create_box 1 box");
+            command("create_atoms 1 box");
+            command("mass 1 1.0");
+            command("velocity all create 3.0 87287 loop geom");
+            command("pair_style lj/cut 2.5");
+            command("pair_coeff 1 1 1.0 1.0 2.5");
+            command("fix 1 all npt temp 1.0 1.0 0.5 iso 1.0 1.0 5.0");
+        });
+    }
+
+    // read all frames of dataset "name", converted to double, empty if missing
+
+    static H5MDData read_data(const std::string &file, const std::string &name)
+    {
+        H5MDData data;
+        hid_t fid = H5Fopen(file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (fid < 0) return data;
+        if (H5Lexists(fid, name.c_str(), H5P_DEFAULT) > 0) {
+            hid_t did = H5Dopen(fid, name.c_str(), H5P_DEFAULT);
+            hid_t sid = H5Dget_space(did);
+            data.dims.resize(H5Sget_simple_extent_ndims(sid));
+            H5Sget_simple_extent_dims(sid, data.dims.data(), nullptr);
+            hsize_t n = 1;
+            for (auto d : data.dims) n *= d;
+            data.value.resize(n);
+            H5Dread(did, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.value.data());
+            H5Sclose(sid);
+            H5Dclose(did);
+        }
+        H5Fclose(fid);
+        return data;
+    }
+
+    // compare positions and box of all frames, rows of the parallel file are
+    // mapped to atom IDs with its "id" element, if present
+    // returns number of compared values, -1 if the files differ
+
+    static bigint compare_files(const std::string &serial, const std::string &parallel)
+    {
+        const std::string all = "/particles/all/";
+        const auto sbox       = read_data(serial, all + "box/edges/value");
+        const auto pbox       = read_data(parallel, all + "box/edges/value");
+        if (sbox.value.empty() || (sbox.dims != pbox.dims) || (sbox.value != pbox.value))
+            return -1;
+
+        const auto spos = read_data(serial, all + "position/value");
+        const auto ppos = read_data(parallel, all + "position/value");
+        const auto pid  = read_data(parallel, all + "id/value");
+        if ((spos.dims.size() != 3) || (spos.dims != ppos.dims)) return -1;
+
+        const hsize_t nframes = spos.dims[0], natoms = spos.dims[1], dim = spos.dims[2];
+        bigint ncompared = 0;
+        for (hsize_t frame = 0; frame < nframes; frame++) {
+
+            // rows of the serial file are sorted by atom ID
+
+            std::map<tagint, hsize_t> prow;
+            for (hsize_t row = 0; row < natoms; row++) {
+                const hsize_t idx = frame * natoms + row;
+                prow[pid.value.empty() ? row : (tagint)pid.value[idx]] = row;
+            }
+            hsize_t srow = 0;
+            for (const auto &entry : prow) {
+                for (hsize_t k = 0; k < dim; k++) {
+                    const double s = spos.value[(frame * natoms + srow) * dim + k];
+                    const double p = ppos.value[(frame * natoms + entry.second) * dim + k];
+                    if (s != p) return -1;
+                    ++ncompared;
+                }
+                ++srow;
+            }
+        }
+        return ncompared;
+    }
+
+    // write the dump gathered to proc 0 and a second one with the given
+    // keywords during a short run and compare them on proc 0
+
+    void run_and_compare(const std::string &name, const std::string &keywords)
+    {
+        const std::string serial = name + "_serial.h5", parallel = name + "_parallel.h5";
+        HIDE_OUTPUT([&] {
+            command("dump 1 all h5md 10 " + serial + " position box yes");
+            command("dump 2 all h5md 10 " + parallel + " position box yes " + keywords);
+            command("run 40 post no");
+            command("undump 1");
+            command("undump 2");
+        });
+        ASSERT_EQ(lmp->update->ntimestep, 40);
+
+        bigint ncompared = 0;
+        if (me == 0) ncompared = compare_files(serial, parallel);
+        MPI_Bcast(&ncompared, 1, MPI_LMP_BIGINT, 0, MPI_COMM_WORLD);
+        EXPECT_EQ(ncompared, 5 * 3 * lmp->atom->natoms);
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (me == 0) {
+            platform::unlink(serial);
+            platform::unlink(parallel);
+        }
+    }
+};
+
+// two dumps gathered to proc 0, to check the comparison itself
+
+TEST_F(DumpH5MDMPITest, serial_reference)
+{
+    ASSERT_EQ(nprocs, 4);
+    if (!info->has_style("dump", "h5md")) GTEST_SKIP();
+
+    setup_system();
+    run_and_compare("dump_h5md_reference", "");
+}
+
+#if defined(H5_HAVE_PARALLEL)
+
+// atom IDs 1 to Natoms, each atom is written to row ID-1
+
+TEST_F(DumpH5MDMPITest, parallel_ordered)
+{
+    ASSERT_EQ(nprocs, 4);
+    if (!info->has_style("dump", "h5md")) GTEST_SKIP();
+
+    setup_system();
+    run_and_compare("dump_h5md_ordered", "parallel yes chunk 100");
+}
+
+// atom IDs with gaps, each proc writes a block of rows with their IDs
+
+TEST_F(DumpH5MDMPITest, parallel_unordered)
+{
+    ASSERT_EQ(nprocs, 4);
+    if (!info->has_style("dump", "h5md")) GTEST_SKIP();
+
+    setup_system();
+    HIDE_OUTPUT([&] {
+        command("region hole sphere 3 3 3 1.5 units lattice");
+        command("delete_atoms region hole");
+    });
+    run_and_compare("dump_h5md_unordered", "parallel yes chunk 100");
+}
+
+#else
+
+// without parallel HDF5, parallel yes must stop with an error on all procs
+
+TEST_F(DumpH5MDMPITest, parallel_unsupported)
+{
+    ASSERT_EQ(nprocs, 4);
+    if (!info->has_style("dump", "h5md")) GTEST_SKIP();
+
+    setup_system();
+    std::string mesg;
+    HIDE_OUTPUT([&] {
+        try {
+            command("dump 2 all h5md 10 dump_h5md_unsupported.h5 position parallel yes");
+        } catch (LAMMPSException &e) {
+            mesg = e.what();
+        }
+    });
+    ASSERT_THAT(mesg, HasSubstr("requires an HDF5 library with parallel I/O support"));
+}
+
+#endif
+} // namespace LAMMPS_NS
@@ -0,0 +1,140 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for writing zbin dump files with MPI-IO from several procs
+
+#include "COMPRESS/zbin_format.h"
+#include "atom.h"
+#include "info.h"
+#include "lammps.h"
+#include "update.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpZbinMPIIOTest : public LAMMPSTest {
+protected:
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        testbinary = "DumpZbinMPIIOTest";
+        LAMMPSTest::SetUp();
+    }
+
+    // positions and velocities indexed by atom ID, identical on all ranks
+
+    std::vector<double> gather_atoms()
+    {
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(natoms * 6, 0.0), all(natoms * 6, 0.0);
+        for (int i = 0; i < atom->nlocal; i++) {
+            double *ptr = &mine[(atom->tag[i] - 1) * 6];
+            for (int j = 0; j < 3; j++) ptr[j] = atom->x[i][j];
+            for (int j = 0; j < 3; j++) ptr[3 + j] = atom->v[i][j];
+        }
+        MPI_Allreduce(mine.data(), all.data(), natoms * 6, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+};
+
+TEST_F(DumpZbinMPIIOTest, multi_frame)
+{
+    ASSERT_EQ(nprocs, 4);
+    if (!info->has_style("dump", "custom/zbin/mpiio")) GTEST_SKIP();
+
+    // each frame is written both by the serial writer and by all procs with MPI-IO
+
+    HIDE_OUTPUT([&] {
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("fix 1 all nve");
+        command("dump 1 all custom/zbin 10 dump_zbin_serial.zbin id type x y z vx vy vz");
+        command("dump 2 all custom/zbin/mpiio 10 dump_zbin_mpiio.zbin id type x y z vx vy vz");
+        command("run 40 post no");
+        command("undump 1");
+        command("undump 2");
+    });
+    ASSERT_EQ(lmp->update->ntimestep, 40);
+
+    // the file ends with a valid index of all 5 frames
+
+    int valid = 0;
+    if (me == 0) {
+        FILE *fp = fopen("dump_zbin_mpiio.zbin", "rb");
+        if (fp) {
+            Zbin::IndexFooter footer;
+            platform::fseek(fp, platform::END_OF_FILE);
+            const bigint end_of_file = platform::ftell(fp);
+            platform::fseek(fp, end_of_file - sizeof(footer));
+            std::vector<Zbin::IndexEntry> index(5);
+            if ((fread(&footer, sizeof(footer), 1, fp) == 1) &&
+                (memcmp(footer.magic, Zbin::INDEX_MAGIC, sizeof(footer.magic)) == 0) &&
+                (footer.nframes == 5)) {
+                platform::fseek(fp, footer.offset);
+                if (fread(index.data(), sizeof(Zbin::IndexEntry), 5, fp) == 5) {
+                    valid = 1;
+                    for (int i = 0; i < 5; i++)
+                        if (index[i].ntimestep != 10 * i) valid = 0;
+                }
+            }
+            fclose(fp);
+        }
+    }
+    MPI_Bcast(&valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    ASSERT_TRUE(valid);
+
+    // every frame reads back the same as the frame of the serial writer
+
+    for (int step = 0; step <= 40; step += 10) {
+        HIDE_OUTPUT([&] {
+            command(fmt::format("read_dump dump_zbin_serial.zbin {} x y z vx vy vz format zbin",
+                                step));
+        });
+        const auto ref = gather_atoms();
+        HIDE_OUTPUT([&] {
+            command(fmt::format("read_dump dump_zbin_mpiio.zbin {} x y z vx vy vz format zbin",
+                                step));
+        });
+        const auto atoms = gather_atoms();
+        ASSERT_EQ(atoms.size(), ref.size());
+        for (std::size_t i = 0; i < ref.size(); i++) EXPECT_EQ(atoms[i], ref[i]) << step << " " << i;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (me == 0) {
+        platform::unlink("dump_zbin_serial.zbin");
+        platform::unlink("dump_zbin_mpiio.zbin");
+    }
+}
+} // namespace LAMMPS_NS
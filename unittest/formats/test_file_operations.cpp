@@ -404,6 +404,154 @@ TEST_F(FileOperationsTest, write_restart)
     if (Info::has_package("MPIIO")) delete_file("test.restart.mpiio");
 }
 
+TEST_F(FileOperationsTest, restart_delta)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("velocity all create 3.0 87287 loop geom");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0 2.5");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+
+    // full files on steps 10, 40, and 70, the others are deltas
+    // keep 2 deletes a delta when the next delta of the same full file is written
+    // and deletes the files of step 10 and 30 when the full file of step 70 is written
+
+    BEGIN_HIDE_OUTPUT();
+    command("restart 10 delta.* delta 2 keep 2");
+    command("run 80 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_NOT_EXISTS("delta.10");
+    ASSERT_FILE_NOT_EXISTS("delta.20");
+    ASSERT_FILE_NOT_EXISTS("delta.30");
+    ASSERT_FILE_EXISTS("delta.40");
+    ASSERT_FILE_NOT_EXISTS("delta.50");
+    ASSERT_FILE_EXISTS("delta.60");
+    ASSERT_FILE_EXISTS("delta.70");
+    ASSERT_FILE_EXISTS("delta.80");
+
+    const bigint natoms = lmp->atom->natoms;
+    int idx             = lmp->atom->map(10);
+    ASSERT_GE(idx, 0);
+    const double x10[3] = {lmp->atom->x[idx][0], lmp->atom->x[idx][1], lmp->atom->x[idx][2]};
+    const double v10[3] = {lmp->atom->v[idx][0], lmp->atom->v[idx][1], lmp->atom->v[idx][2]};
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart delta.80");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 80);
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+    idx = lmp->atom->map(10);
+    ASSERT_GE(idx, 0);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_DOUBLE_EQ(lmp->atom->x[idx][k], x10[k]);
+        EXPECT_DOUBLE_EQ(lmp->atom->v[idx][k], v10[k]);
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart delta.60");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 60);
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart delta.*");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 80);
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+
+    TEST_FAILURE(".*ERROR: Write_restart keywords delta and keep are only supported by restart.*",
+                 command("write_restart test.restart delta 2"););
+    TEST_FAILURE(".*ERROR: Restart delta and keep are not allowed with two restart files.*",
+                 command("restart 10 delta.a delta.b delta 2"););
+    TEST_FAILURE(".*ERROR: Restart delta and keep are not allowed with % in filename.*",
+                 command("restart 10 delta-%.* delta 2"););
+    TEST_FAILURE(".*ERROR: Invalid restart keep value -1.*",
+                 command("restart 10 delta.* keep -1"););
+
+    delete_file("delta.40");
+    delete_file("delta.60");
+    delete_file("delta.70");
+    delete_file("delta.80");
+}
+
+TEST_F(FileOperationsTest, fix_buddy)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    command("atom_modify map array");
+    command("lattice fcc 0.8442");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("velocity all create 3.0 87287 loop geom");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff 1 1 1.0 1.0 2.5");
+    command("fix 1 all nve");
+    END_HIDE_OUTPUT();
+
+    // checkpoints on steps 10, 20, and 30, files are only written for step 20
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 2 all buddy 10 buddy.*.%.restart write 2");
+    command("run 20 post no");
+    END_HIDE_OUTPUT();
+
+    const bigint natoms = lmp->atom->natoms;
+    int idx             = lmp->atom->map(10);
+    ASSERT_GE(idx, 0);
+    const double x10[3] = {lmp->atom->x[idx][0], lmp->atom->x[idx][1], lmp->atom->x[idx][2]};
+    const double v10[3] = {lmp->atom->v[idx][0], lmp->atom->v[idx][1], lmp->atom->v[idx][2]};
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 10 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_NOT_EXISTS("buddy.10.base.restart");
+    ASSERT_FILE_NOT_EXISTS("buddy.10.0.restart");
+    ASSERT_FILE_EXISTS("buddy.20.base.restart");
+    ASSERT_FILE_EXISTS("buddy.20.0.restart");
+    ASSERT_FILE_NOT_EXISTS("buddy.20.0.restart.tmp");
+    ASSERT_FILE_NOT_EXISTS("buddy.30.base.restart");
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart buddy.20.%.restart");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->update->ntimestep, 20);
+    ASSERT_EQ(lmp->atom->natoms, natoms);
+    idx = lmp->atom->map(10);
+    ASSERT_GE(idx, 0);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_DOUBLE_EQ(lmp->atom->x[idx][k], x10[k]);
+        EXPECT_DOUBLE_EQ(lmp->atom->v[idx][k], v10[k]);
+    }
+
+    TEST_FAILURE(".*ERROR: Fix buddy file name buddy.restart must contain '%'.*",
+                 command("fix 2 all buddy 10 buddy.restart"););
+    TEST_FAILURE(".*ERROR: Illegal fix buddy write value 0.*",
+                 command("fix 2 all buddy 10 buddy.%.restart write 0"););
+    TEST_FAILURE(".*ERROR: Unknown fix buddy keyword: xxxx.*",
+                 command("fix 2 all buddy 10 buddy.%.restart xxxx 1"););
+    TEST_FAILURE(".*ERROR: Unknown fix buddy copy value: some.*",
+                 command("fix 2 all buddy 10 buddy.%.restart copy some"););
+
+    delete_file("buddy.20.base.restart");
+    delete_file("buddy.20.0.restart");
+}
+
 TEST_F(FileOperationsTest, write_data)
 {
     BEGIN_HIDE_OUTPUT();
@@ -492,6 +640,31 @@ TEST_F(FileOperationsTest, write_data)
     END_HIDE_OUTPUT();
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->domain->triclinic, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data triclinic.data parallel yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->domain->triclinic, 1);
+    TEST_FAILURE(".*ERROR: Illegal read_data parallel command: missing argument.*",
+                 command("read_data triclinic.data parallel"););
+    BEGIN_HIDE_OUTPUT();
+    command("write_data binary.data binary");
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data binary.data binary");
+    command("pair_coeff * *");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->atom->ntypes, 2);
+    ASSERT_EQ(lmp->domain->triclinic, 1);
+    ASSERT_DOUBLE_EQ(lmp->atom->x[0][0], 0.5);
+    ASSERT_DOUBLE_EQ(lmp->atom->mass[1], 1.0);
+    TEST_FAILURE(".*ERROR: File test.data is not a LAMMPS binary data file.*",
+                 command("clear"); command("read_data test.data binary"););
+    TEST_FAILURE(".*ERROR: Cannot use read_data binary with offset or shift keyword.*",
+                 command("clear"); command("read_data binary.data binary shift 1.0 0.0 0.0"););
 
     // clean up
     delete_file("charge.data");
@@ -501,6 +674,7 @@ TEST_F(FileOperationsTest, write_data)
     delete_file("test.data");
     delete_file("step333.data");
     delete_file("triclinic.data");
+    delete_file("binary.data");
 }
 
 #define GETIDX(i) lmp->atom->map(i)
@@ -0,0 +1,150 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for recovering fix buddy checkpoints after the loss of a node
+
+#include "atom.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include "update.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+// each rank writes into its own directory, like into storage local to its node
+// all ranks run on one host, so "copy all" is needed to write the partner files
+
+class FixBuddyMPITest : public LAMMPSTest {
+protected:
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        testbinary = "FixBuddyMPITest";
+        args       = {"-log", "none", "-echo", "screen", "-nocite",
+                      "-var", "dir",  fmt::format("buddy_mpi_{}", me)};
+        LAMMPSTest::SetUp();
+    }
+
+    void TearDown() override
+    {
+        LAMMPSTest::TearDown();
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (me == 0) {
+            for (int i = 0; i < nprocs; i++) platform::rmdir(fmt::format("buddy_mpi_{}", i));
+            platform::rmdir("buddy_mpi_all");
+        }
+    }
+
+    // unwrapped positions and velocities indexed by atom ID, identical on all ranks of comm
+
+    static std::vector<double> gather_atoms(LAMMPS *lmp, MPI_Comm comm)
+    {
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(natoms * 6, 0.0), all(natoms * 6, 0.0);
+        for (int i = 0; i < atom->nlocal; i++) {
+            double *ptr = &mine[(atom->tag[i] - 1) * 6];
+            lmp->domain->unmap(atom->x[i], atom->image[i], ptr);
+            for (int j = 0; j < 3; j++) ptr[3 + j] = atom->v[i][j];
+        }
+        MPI_Allreduce(mine.data(), all.data(), natoms * 6, MPI_DOUBLE, MPI_SUM, comm);
+        return all;
+    }
+};
+
+TEST_F(FixBuddyMPITest, lost_node)
+{
+    ASSERT_EQ(nprocs, 4);
+
+    platform::mkdir(fmt::format("buddy_mpi_{}", me));
+    HIDE_OUTPUT([&] {
+        command("atom_modify map array");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 6 0 6");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0 2.5");
+        command("fix 1 all nve");
+        command("fix 2 all buddy 10 ${dir}/buddy.%.restart offset 2 copy all");
+        command("run 20 post no");
+    });
+    ASSERT_EQ(lmp->update->ntimestep, 20);
+    const auto ref = gather_atoms(lmp, MPI_COMM_WORLD);
+
+    // each rank wrote its own file and the one of the rank whose copy it keeps,
+    // the partner of rank 0 also wrote the base file
+
+    const std::string dir = fmt::format("buddy_mpi_{}/buddy.", me);
+    EXPECT_TRUE(platform::file_is_readable(fmt::format("{}{}.restart", dir, me)));
+    EXPECT_TRUE(platform::file_is_readable(fmt::format("{}{}.restart", dir, (me + 2) % 4)));
+    EXPECT_FALSE(platform::file_is_readable(fmt::format("{}{}.restart", dir, (me + 1) % 4)));
+    EXPECT_EQ(platform::file_is_readable(dir + "base.restart"), (me % 2) == 0);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // the node of ranks 0 and 1 is lost, collect the files on the node of ranks 2 and 3
+
+    int complete = 0;
+    if (me == 0) {
+        platform::rmdir("buddy_mpi_0");
+        platform::rmdir("buddy_mpi_1");
+        platform::mkdir("buddy_mpi_all");
+        for (const auto &node : {"buddy_mpi_2", "buddy_mpi_3"})
+            for (const auto &file : platform::list_directory(node))
+                rename(platform::path_join(node, file).c_str(),
+                       platform::path_join("buddy_mpi_all", file).c_str());
+        auto files = platform::list_directory("buddy_mpi_all");
+        std::sort(files.begin(), files.end());
+        complete = (files == std::vector<std::string>({"buddy.0.restart", "buddy.1.restart",
+                                                        "buddy.2.restart", "buddy.3.restart",
+                                                        "buddy.base.restart"}));
+    }
+    MPI_Bcast(&complete, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    ASSERT_TRUE(complete);
+
+    // continue on 3 ranks from the collected files
+
+    MPI_Comm comm;
+    MPI_Comm_split(MPI_COMM_WORLD, (me < 3) ? 0 : MPI_UNDEFINED, me, &comm);
+    if (comm != MPI_COMM_NULL) {
+        const char *lmpargs[] = {"FixBuddyMPITest", "-log", "none", "-echo", "screen", "-nocite"};
+        LAMMPS *lmp3;
+        HIDE_OUTPUT([&] {
+            lmp3 = new LAMMPS(6, (char **)lmpargs, comm);
+            lmp3->input->one("read_restart buddy_mpi_all/buddy.%.restart");
+        });
+        EXPECT_EQ(lmp3->update->ntimestep, 20);
+        ASSERT_EQ(lmp3->atom->natoms, lmp->atom->natoms);
+        const auto atoms = gather_atoms(lmp3, comm);
+        for (std::size_t i = 0; i < ref.size(); i++) EXPECT_NEAR(atoms[i], ref[i], 1.0e-10) << i;
+        HIDE_OUTPUT([&] { delete lmp3; });
+        MPI_Comm_free(&comm);
+    }
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for reading data files on multiple MPI ranks
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using ::testing::HasSubstr;
+
+namespace LAMMPS_NS {
+
+class ReadDataMPITest : public LAMMPSTest {
+protected:
+    void InitSystem() override
+    {
+        HIDE_OUTPUT([&] {
+            command("atom_style full");
+            command("atom_modify map array");
+            command("region box block 0 10 0 10 0 10");
+            command("create_box 2 box bond/types 1 angle/types 1 extra/bond/per/atom 2 "
+                    "extra/angle/per/atom 2 extra/special/per/atom 4");
+            command("create_atoms 1 random 800 4567 NULL");
+            command("create_atoms 2 random 400 7654 NULL");
+            command("mass * 1.0");
+            command("set type 1 charge 0.5");
+            command("set type 2 charge -1.0");
+            command("set type 1 mol 1");
+            command("set type 2 mol 2");
+            command("set atom 1*100 image 1 -1 2");
+            command("velocity all create 1.0 8765 loop geom");
+            command("pair_style zero 1.0");
+            command("pair_coeff * *");
+            command("bond_style zero");
+            command("bond_coeff 1");
+            command("angle_style zero");
+            command("angle_coeff 1");
+            command("create_bonds single/bond 1 1 2");
+            command("create_bonds single/bond 1 3 4");
+            command("create_bonds single/bond 1 1001 1002");
+            command("create_bonds single/angle 1 5 6 7");
+            command("write_data read_data_mpi.data");
+        });
+    }
+
+    void TearDown() override
+    {
+        if (lmp->comm->me == 0) {
+            platform::unlink("read_data_mpi.data");
+            platform::unlink("read_data_mpi.bin");
+        }
+        LAMMPSTest::TearDown();
+    }
+
+    // per-atom values indexed by atom ID, identical on all ranks
+
+    std::vector<double> gather_atoms()
+    {
+        const int nper   = 17;
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(natoms * nper, 0.0), all(natoms * nper, 0.0);
+        for (int i = 0; i < atom->nlocal; i++) {
+            double *ptr = &mine[(atom->tag[i] - 1) * nper];
+            double unwrap[3];
+            lmp->domain->unmap(atom->x[i], atom->image[i], unwrap);
+            for (int j = 0; j < 3; j++) ptr[j] = unwrap[j];
+            for (int j = 0; j < 3; j++) ptr[3 + j] = atom->v[i][j];
+            ptr[6]  = atom->type[i];
+            ptr[7]  = atom->q[i];
+            ptr[8]  = atom->molecule[i];
+            ptr[9]  = atom->num_bond[i];
+            ptr[10] = (atom->num_bond[i] > 0) ? atom->bond_atom[i][0] : 0;
+            ptr[11] = (atom->num_bond[i] > 0) ? atom->bond_type[i][0] : 0;
+            ptr[12] = atom->nspecial[i][0];
+            ptr[13] = (atom->image[i] & IMGMASK) - IMGMAX;
+            ptr[14] = atom->num_angle[i];
+            ptr[15] = (atom->num_angle[i] > 0) ? atom->angle_atom3[i][0] : 0;
+            ptr[16] = 1.0;
+        }
+        MPI_Allreduce(mine.data(), all.data(), natoms * nper, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+};
+
+TEST_F(ReadDataMPITest, atoms_parallel)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+
+    // serial reader on 4 ranks
+
+    HIDE_OUTPUT([&] {
+        command("delete_atoms group all bond yes");
+        command("read_data read_data_mpi.data add merge");
+    });
+    ASSERT_EQ(lmp->atom->natoms, 1200);
+    ASSERT_EQ(lmp->atom->nbonds, 3);
+    ASSERT_EQ(lmp->atom->nangles, 1);
+    auto ref = gather_atoms();
+
+    // parallel reader, every rank reads a part of the Atoms section
+
+    auto output = CAPTURE_OUTPUT([&] {
+        command("clear");
+        command("atom_style full");
+        command("atom_modify map array");
+        command("pair_style zero 1.0");
+        command("bond_style zero");
+        command("angle_style zero");
+        command("read_data read_data_mpi.data parallel yes extra/bond/per/atom 2");
+    });
+    if (lmp->comm->me == 0) ASSERT_THAT(output, HasSubstr("reading atoms in parallel"));
+    ASSERT_EQ(lmp->atom->natoms, 1200);
+    ASSERT_EQ(lmp->atom->nbonds, 3);
+    EXPECT_EQ(gather_atoms(), ref);
+
+    // atoms are distributed to their sub-domains
+
+    int nlocal = lmp->atom->nlocal;
+    int nmin, nmax;
+    MPI_Allreduce(&nlocal, &nmin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(&nlocal, &nmax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    ASSERT_GT(nmin, 0);
+    ASSERT_LT(nmax, 1200);
+    for (int i = 0; i < nlocal; i++) {
+        double *x = lmp->atom->x[i];
+        ASSERT_GE(x[0], lmp->domain->sublo[0]);
+        ASSERT_LT(x[0], lmp->domain->subhi[0]);
+        ASSERT_GE(x[1], lmp->domain->sublo[1]);
+        ASSERT_LT(x[1], lmp->domain->subhi[1]);
+        ASSERT_GE(x[2], lmp->domain->sublo[2]);
+        ASSERT_LT(x[2], lmp->domain->subhi[2]);
+    }
+}
+
+TEST_F(ReadDataMPITest, atoms_parallel_outside)
+{
+    // one atom outside of a non-periodic box, both readers must reject it
+
+    if (lmp->comm->me == 0) {
+        FILE *fp = fopen("read_data_mpi.data", "w");
+        fputs("# atom outside\n\n1000 atoms\n1 atom types\n\n0 10 xlo xhi\n"
+              "0 10 ylo yhi\n0 10 zlo zhi\n\nAtoms # atomic\n\n",
+              fp);
+        for (int i = 0; i < 1000; i++)
+            fprintf(fp, "%d 1 %g %g %g\n", i + 1, (i == 600) ? 10.5 : 0.5 + i % 10,
+                    0.5 + (i / 10) % 10, 0.5 + i / 100);
+        fclose(fp);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    for (const auto &keyword : {"", " parallel yes"}) {
+        HIDE_OUTPUT([&] {
+            command("clear");
+            command("boundary f p p");
+        });
+        std::string mesg;
+        BEGIN_HIDE_OUTPUT();
+        try {
+            command(std::string("read_data read_data_mpi.data") + keyword);
+        } catch (LAMMPSException &e) {
+            mesg = e.what();
+        }
+        END_HIDE_OUTPUT();
+        ASSERT_THAT(mesg, HasSubstr("Did not assign all atoms correctly")) << keyword;
+    }
+}
+
+TEST_F(ReadDataMPITest, binary)
+{
+    HIDE_OUTPUT([&] {
+        command("write_data read_data_mpi.bin binary");
+        command("delete_atoms group all bond yes");
+        command("read_data read_data_mpi.data add merge");
+    });
+    auto ref = gather_atoms();
+
+    // every rank reads a slice of the columns, including velocities and topology
+
+    HIDE_OUTPUT([&] {
+        command("clear");
+        command("atom_style full");
+        command("atom_modify map array");
+        command("pair_style zero 1.0");
+        command("bond_style zero");
+        command("angle_style zero");
+        command("read_data read_data_mpi.bin binary extra/special/per/atom 4");
+    });
+    ASSERT_EQ(lmp->atom->natoms, 1200);
+    ASSERT_EQ(lmp->atom->nbonds, 3);
+    ASSERT_EQ(lmp->atom->nangles, 1);
+    EXPECT_EQ(gather_atoms(), ref);
+
+    int nlocal = lmp->atom->nlocal;
+    int nmin;
+    MPI_Allreduce(&nlocal, &nmin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    ASSERT_GT(nmin, 0);
+
+    // with newton off, the entries are sent to the owners of all their atoms
+
+    HIDE_OUTPUT([&] {
+        command("clear");
+        command("newton on off");
+        command("atom_style full");
+        command("atom_modify map array");
+        command("pair_style zero 1.0");
+        command("bond_style zero");
+        command("angle_style zero");
+        command("read_data read_data_mpi.bin binary extra/special/per/atom 4");
+    });
+    ASSERT_EQ(lmp->atom->nbonds, 3);
+    ASSERT_EQ(lmp->atom->nangles, 1);
+    int ntopo[2] = {0, 0}, ntopoall[2];
+    for (int i = 0; i < lmp->atom->nlocal; i++) {
+        ntopo[0] += lmp->atom->num_bond[i];
+        ntopo[1] += lmp->atom->num_angle[i];
+    }
+    MPI_Allreduce(ntopo, ntopoall, 2, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(ntopoall[0], 6);
+    EXPECT_EQ(ntopoall[1], 3);
+
+    // header errors are reported on all ranks
+
+    const std::vector<std::pair<std::string, std::string>> errors = {
+        {"binary", "File read_data_mpi.data is not a LAMMPS binary data file"},
+        {"binary shift 1.0 0.0 0.0", "Cannot use read_data binary with offset or shift keyword"},
+        {"binary offset 1 0 0 0 0", "Cannot use read_data binary with offset or shift keyword"}};
+    for (const auto &error : errors) {
+        HIDE_OUTPUT([&] { command("clear"); });
+        std::string mesg;
+        BEGIN_HIDE_OUTPUT();
+        try {
+            command("read_data read_data_mpi.data " + error.first);
+        } catch (LAMMPSException &e) {
+            mesg = e.what();
+        }
+        END_HIDE_OUTPUT();
+        ASSERT_THAT(mesg, HasSubstr(error.second)) << error.first;
+    }
+}
+} // namespace LAMMPS_NS